@@ -0,0 +1,219 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BLOCKING_SIZES_TUNER_H
+#define EIGEN_BLOCKING_SIZES_TUNER_H
+
+// IWYU pragma: private
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+// Names of the scalar types in the tuning files, indexed by blocking_sizes_tuning_scalar.
+inline const char* blocking_sizes_tuning_scalar_name(int scalar) {
+  static const char* const names[blocking_sizes_tuning::NumScalars] = {"float", "double", "complex<float>",
+                                                                       "complex<double>"};
+  return names[scalar];
+}
+
+}  // end namespace internal
+
+/** \ingroup BlockingSizesTuner_Module
+ *
+ * \class BlockingSizesTuner
+ *
+ * \brief Measures the blocking sizes of the general matrix-matrix products on the host
+ *
+ * For a given scalar type and product shape, tune() times the single threaded product with the blocking sizes
+ * computed from the cpu cache sizes, and then searches the blocking sizes along each of the three dimensions in turn,
+ * among the powers of two between 16 and the dimension of the product. The fastest sizes are installed with
+ * setTunedBlockingSizes() for the whole shape class of the product.
+ *
+ * The tuning is typically done once per host by an offline tool, whose results are loaded by the applications:
+ * \code
+ * // Offline.
+ * BlockingSizesTuner tuner;
+ * for (Index size = 64; size <= 2048; size *= 2) tuner.tune<float>(size, size, size);
+ * saveTunedBlockingSizes("blocking_sizes.txt");
+ *
+ * // At application startup.
+ * loadTunedBlockingSizes("blocking_sizes.txt");
+ * \endcode
+ *
+ * \sa saveTunedBlockingSizes(), loadTunedBlockingSizes()
+ */
+class BlockingSizesTuner {
+ public:
+  BlockingSizesTuner() : m_minTime(1e-2), m_repetitions(3) {}
+
+  /** Sets the minimal duration in seconds of a measurement, during which the product is repeated. */
+  BlockingSizesTuner& setMinTime(double seconds) {
+    m_minTime = seconds;
+    return *this;
+  }
+
+  /** Sets the number of measurements of each blocking sizes, the fastest one being kept. */
+  BlockingSizesTuner& setRepetitions(int repetitions) {
+    eigen_assert(repetitions > 0);
+    m_repetitions = repetitions;
+    return *this;
+  }
+
+  /** Measures and installs the fastest blocking sizes of the products of \a Scalar having the shape class of a \a m x
+   * \a k times \a k x \a n product.
+   *
+   * \returns the speedup of the installed sizes over the ones computed from the cpu cache sizes. */
+  template <typename Scalar>
+  double tune(Index k, Index m, Index n) {
+    typedef Matrix<Scalar, Dynamic, Dynamic> MatrixType;
+    eigen_assert(k > 0 && m > 0 && n > 0);
+    MatrixType lhs = MatrixType::Random(m, k);
+    MatrixType rhs = MatrixType::Random(k, n);
+    MatrixType res(m, n);
+
+    // The tuned sizes only apply to single threaded products.
+    const int threads = nbThreads();
+    setNbThreads(1);
+
+    Index best[3] = {k, m, n};
+    internal::evaluateProductBlockingSizesHeuristic<Scalar, Scalar, 1>(best[0], best[1], best[2], Index(1));
+    const double heuristic_time = measure<Scalar>(lhs, rhs, res, 0);
+    double best_time = heuristic_time;
+
+    const Index dims[3] = {k, m, n};
+    for (int pass = 0; pass < 2; ++pass) {
+      for (int d = 0; d < 3; ++d) {
+        for (Index size = 16;; size *= 2) {
+          Index candidate[3] = {best[0], best[1], best[2]};
+          candidate[d] = numext::mini(size, dims[d]);
+          if (candidate[d] != best[d]) {
+            const double time = measure<Scalar>(lhs, rhs, res, candidate);
+            if (time < best_time) {
+              best_time = time;
+              std::copy(candidate, candidate + 3, best);
+            }
+          }
+          if (size >= dims[d]) break;
+        }
+      }
+    }
+
+    setTunedBlockingSizes<Scalar>(k, m, n, best[0], best[1], best[2]);
+    setNbThreads(threads);
+    return heuristic_time / best_time;
+  }
+
+ private:
+  // Returns the fastest time of a product with the given blocking sizes, or the heuristic ones if sizes is null.
+  template <typename Scalar, typename MatrixType>
+  double measure(const MatrixType& lhs, const MatrixType& rhs, MatrixType& res, const Index* sizes) const {
+    typedef std::chrono::steady_clock Clock;
+    if (sizes)
+      setTunedBlockingSizes<Scalar>(lhs.cols(), lhs.rows(), rhs.cols(), sizes[0], sizes[1], sizes[2]);
+    else
+      setTunedBlockingSizes<Scalar>(lhs.cols(), lhs.rows(), rhs.cols(), 0, 0, 0);
+
+    double best = NumTraits<double>::infinity();
+    for (int r = 0; r < m_repetitions; ++r) {
+      const Clock::time_point start = Clock::now();
+      double elapsed = 0;
+      Index iterations = 0;
+      do {
+        res.noalias() = lhs * rhs;
+        ++iterations;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+      } while (elapsed < m_minTime);
+      best = numext::mini(best, elapsed / double(iterations));
+    }
+    return best;
+  }
+
+  double m_minTime;
+  int m_repetitions;
+};
+
+/** \ingroup BlockingSizesTuner_Module
+ *
+ * Saves all the blocking sizes set by setTunedBlockingSizes() to the text file \a filename, along with the cpu cache
+ * sizes of the host.
+ *
+ * \returns whether the file has been written successfully.
+ *
+ * \sa loadTunedBlockingSizes(), BlockingSizesTuner */
+inline bool saveTunedBlockingSizes(const char* filename) {
+  typedef internal::blocking_sizes_tuning Tuning;
+  std::ofstream file(filename);
+  if (!file) return false;
+  file << "eigen_blocking_sizes 1\n";
+  file << "cache " << l1CacheSize() << " " << l2CacheSize() << " " << l3CacheSize() << "\n";
+  const Tuning& tuning = internal::blocking_sizes_tuning_table();
+  for (int s = 0; s < Tuning::NumScalars; ++s)
+    for (int k = 0; k < Tuning::NumShapeClasses; ++k)
+      for (int m = 0; m < Tuning::NumShapeClasses; ++m)
+        for (int n = 0; n < Tuning::NumShapeClasses; ++n) {
+          const int* sizes = tuning.sizes[s][k][m][n];
+          if (sizes[0] == 0) continue;
+          file << internal::blocking_sizes_tuning_scalar_name(s) << " " << (1 << (k + Tuning::MinLog2Size)) << " "
+               << (1 << (m + Tuning::MinLog2Size)) << " " << (1 << (n + Tuning::MinLog2Size)) << " " << sizes[0]
+               << " " << sizes[1] << " " << sizes[2] << "\n";
+        }
+  file.flush();
+  return bool(file);
+}
+
+/** \ingroup BlockingSizesTuner_Module
+ *
+ * Loads the blocking sizes saved by saveTunedBlockingSizes() in the file \a filename, and sets them as if by
+ * setTunedBlockingSizes(). Nothing is loaded if the file cannot be parsed, or if it has been tuned for other cpu
+ * cache sizes, since it was then most likely measured on another host.
+ *
+ * \returns whether the blocking sizes have been loaded.
+ *
+ * \sa saveTunedBlockingSizes(), BlockingSizesTuner */
+inline bool loadTunedBlockingSizes(const char* filename) {
+  typedef internal::blocking_sizes_tuning Tuning;
+  std::ifstream file(filename);
+  std::string word;
+  int version = 0;
+  if (!(file >> word >> version) || word != "eigen_blocking_sizes" || version != 1) return false;
+  std::ptrdiff_t l1 = 0, l2 = 0, l3 = 0;
+  if (!(file >> word >> l1 >> l2 >> l3) || word != "cache") return false;
+  if (l1 != l1CacheSize() || l2 != l2CacheSize() || l3 != l3CacheSize()) return false;
+
+  struct Entry {
+    int scalar;
+    std::ptrdiff_t k, m, n;
+    int sizes[3];
+  };
+  std::vector<Entry> entries;
+  Entry entry;
+  while (file >> word >> entry.k >> entry.m >> entry.n >> entry.sizes[0] >> entry.sizes[1] >> entry.sizes[2]) {
+    entry.scalar = -1;
+    for (int s = 0; s < Tuning::NumScalars; ++s)
+      if (word == internal::blocking_sizes_tuning_scalar_name(s)) entry.scalar = s;
+    if (entry.scalar < 0 || entry.k <= 0 || entry.m <= 0 || entry.n <= 0 || entry.sizes[0] <= 0 ||
+        entry.sizes[1] <= 0 || entry.sizes[2] <= 0)
+      return false;
+    entries.push_back(entry);
+  }
+  if (!file.eof()) return false;
+
+  Tuning& tuning = internal::blocking_sizes_tuning_table();
+  for (std::size_t i = 0; i < entries.size(); ++i)
+    std::copy(entries[i].sizes, entries[i].sizes + 3, tuning.entry(entries[i].scalar, entries[i].k, entries[i].m,
+                                                                   entries[i].n));
+  if (!entries.empty()) tuning.enabled = true;
+  return true;
+}
+
+}  // end namespace Eigen
+
+#endif  // EIGEN_BLOCKING_SIZES_TUNER_H
@@ -0,0 +1,3 @@
+#ifndef EIGEN_BLOCKINGSIZESTUNER_MODULE_H
+#error "Please include Eigen/BlockingSizesTuner instead of including headers inside the src directory directly."
+#endif
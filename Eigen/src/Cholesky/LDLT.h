@@ -472,6 +472,7 @@ struct LDLT_Traits<MatrixType, Upper> {
 template <typename MatrixType, int UpLo_>
 template <typename InputType>
 LDLT<MatrixType, UpLo_>& LDLT<MatrixType, UpLo_>::compute(const EigenBase<InputType>& a) {
+  EIGEN_INSTRUMENTED_REGION("LDLT::compute");
   eigen_assert(a.rows() == a.cols());
   const Index size = a.rows();
 
@@ -716,6 +716,13 @@ EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void resize_if_allowed(DstXprType& dst, co
   eigen_assert(dst.rows() == dstRows && dst.cols() == dstCols);
 }
 
+#if defined(EIGEN_GEMM_THREADPOOL)
+// Evaluates large assignments with the thread pool of the products, see setParallelAssignmentThreshold(). Defined in
+// products/Parallelizer.h.
+template <typename Kernel, typename EnableIf = void>
+struct parallel_dense_assignment_loop;
+#endif
+
 template <typename DstXprType, typename SrcXprType, typename Functor>
 EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE EIGEN_CONSTEXPR void call_dense_assignment_loop(DstXprType& dst,
                                                                                       const SrcXprType& src,
@@ -734,6 +741,9 @@ EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE EIGEN_CONSTEXPR void call_dense_assignment
   typedef generic_dense_assignment_kernel<DstEvaluatorType, SrcEvaluatorType, Functor> Kernel;
   Kernel kernel(dstEvaluator, srcEvaluator, func, dst.const_cast_derived());
 
+#if defined(EIGEN_GEMM_THREADPOOL) && !defined(EIGEN_GPU_COMPILE_PHASE)
+  if (!is_constant_evaluated() && parallel_dense_assignment_loop<Kernel>::run(kernel)) return;
+#endif
   dense_assignment_loop<Kernel>::run(kernel);
 }
 
@@ -0,0 +1,139 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_PRODUCT_H
+#define EIGEN_BATCHED_PRODUCT_H
+
+// IWYU pragma: private
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+// Kernel computing one product of a batch. All sizes are known at compile time, so that the coefficient-based
+// product is fully specialized (and unrolled for the smallest sizes), and never goes through the blocking and
+// packing of the general matrix-matrix product.
+template <typename LhsType, typename RhsType, typename DstType>
+struct batched_product_impl {
+  typedef typename DstType::Scalar Scalar;
+
+  EIGEN_STATIC_ASSERT_FIXED_SIZE(LhsType)
+  EIGEN_STATIC_ASSERT_FIXED_SIZE(RhsType)
+  EIGEN_STATIC_ASSERT_FIXED_SIZE(DstType)
+  EIGEN_STATIC_ASSERT((is_same<typename LhsType::Scalar, Scalar>::value &&
+                       is_same<typename RhsType::Scalar, Scalar>::value),
+                      YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+  EIGEN_STATIC_ASSERT(int(LhsType::ColsAtCompileTime) == int(RhsType::RowsAtCompileTime) &&
+                          int(LhsType::RowsAtCompileTime) == int(DstType::RowsAtCompileTime) &&
+                          int(RhsType::ColsAtCompileTime) == int(DstType::ColsAtCompileTime),
+                      INVALID_MATRIX_PRODUCT)
+
+  // Estimated cost of a single product of the batch.
+  static constexpr float Cost = static_cast<float>(int(DstType::SizeAtCompileTime) *
+                                                   int(LhsType::ColsAtCompileTime) *
+                                                   (NumTraits<Scalar>::MulCost + NumTraits<Scalar>::AddCost));
+
+  static EIGEN_STRONG_INLINE void run(const Scalar* lhs, const Scalar* rhs, Scalar* dst) {
+    Map<DstType>(dst).noalias() = Map<const LhsType>(lhs).lazyProduct(Map<const RhsType>(rhs));
+  }
+
+  // Strided batch: the k-th matrices start at lhs + k * lhsStride, rhs + k * rhsStride and dst + k * dstStride.
+  struct StridedFunctor {
+    EIGEN_STRONG_INLINE void operator()(Index k) const {
+      run(lhs + k * lhsStride, rhs + k * rhsStride, dst + k * dstStride);
+    }
+    const Scalar* lhs;
+    Index lhsStride;
+    const Scalar* rhs;
+    Index rhsStride;
+    Scalar* dst;
+    Index dstStride;
+  };
+
+  // Pointer-array batch: the k-th matrices start at lhs[k], rhs[k] and dst[k].
+  struct ArrayFunctor {
+    EIGEN_STRONG_INLINE void operator()(Index k) const { run(lhs[k], rhs[k], dst[k]); }
+    const Scalar* const* lhs;
+    const Scalar* const* rhs;
+    Scalar* const* dst;
+  };
+};
+
+}  // end namespace internal
+
+/** \ingroup Core_Module
+ *
+ * Computes a batch of \a batchSize independent small matrix products \f$ C_k = A_k B_k \f$, where the matrices of
+ * each batch are stored contiguously at a constant distance from each other (in number of scalars):
+ * \f$ A_k \f$ starts at \c lhs+k*lhsStride, \f$ B_k \f$ at \c rhs+k*rhsStride, and \f$ C_k \f$ at \c dst+k*dstStride.
+ *
+ * The template parameters are the fixed-size matrix types describing the layout of a single lhs, rhs and result
+ * matrix, e.g.:
+ * \code
+ * batchedProduct<Matrix4f, Matrix4f, Matrix4f>(n, A, 16, B, 16, C, 16);
+ * \endcode
+ *
+ * Each product is computed by a kernel specialized for these compile-time sizes, without any runtime dispatch,
+ * blocking size computation or packing buffer. The result matrices must not overlap with the operands.
+ *
+ * \sa batchedProduct(Index, const Scalar* const*, const Scalar* const*, Scalar* const*)
+ */
+template <typename LhsType, typename RhsType, typename DstType>
+void batchedProduct(Index batchSize, const typename DstType::Scalar* lhs, Index lhsStride,
+                    const typename DstType::Scalar* rhs, Index rhsStride, typename DstType::Scalar* dst,
+                    Index dstStride) {
+  typedef internal::batched_product_impl<LhsType, RhsType, DstType> Impl;
+  const typename Impl::StridedFunctor func = {lhs, lhsStride, rhs, rhsStride, dst, dstStride};
+  for (Index k = 0; k < batchSize; ++k) func(k);
+}
+
+/** \ingroup Core_Module
+ *
+ * Same as above, but the batch is given as arrays of pointers to the individual matrices:
+ * \f$ A_k \f$ starts at \c lhs[k], \f$ B_k \f$ at \c rhs[k], and \f$ C_k \f$ at \c dst[k].
+ */
+template <typename LhsType, typename RhsType, typename DstType>
+void batchedProduct(Index batchSize, const typename DstType::Scalar* const* lhs,
+                    const typename DstType::Scalar* const* rhs, typename DstType::Scalar* const* dst) {
+  typedef internal::batched_product_impl<LhsType, RhsType, DstType> Impl;
+  const typename Impl::ArrayFunctor func = {lhs, rhs, dst};
+  for (Index k = 0; k < batchSize; ++k) func(k);
+}
+
+/** \ingroup Core_Module
+ *
+ * Strided batched product distributing the batch over the threads of \a device, typically a CoreThreadPoolDevice.
+ */
+template <typename LhsType, typename RhsType, typename DstType, typename Device>
+void batchedProduct(Index batchSize, const typename DstType::Scalar* lhs, Index lhsStride,
+                    const typename DstType::Scalar* rhs, Index rhsStride, typename DstType::Scalar* dst,
+                    Index dstStride, Device& device) {
+  typedef internal::batched_product_impl<LhsType, RhsType, DstType> Impl;
+  typename Impl::StridedFunctor func = {lhs, lhsStride, rhs, rhsStride, dst, dstStride};
+  device.template parallelFor<typename Impl::StridedFunctor, 1>(0, batchSize, func, Impl::Cost);
+}
+
+/** \ingroup Core_Module
+ *
+ * Pointer-array batched product distributing the batch over the threads of \a device, typically a
+ * CoreThreadPoolDevice.
+ */
+template <typename LhsType, typename RhsType, typename DstType, typename Device>
+void batchedProduct(Index batchSize, const typename DstType::Scalar* const* lhs,
+                    const typename DstType::Scalar* const* rhs, typename DstType::Scalar* const* dst,
+                    Device& device) {
+  typedef internal::batched_product_impl<LhsType, RhsType, DstType> Impl;
+  typename Impl::ArrayFunctor func = {lhs, rhs, dst};
+  device.template parallelFor<typename Impl::ArrayFunctor, 1>(0, batchSize, func, Impl::Cost);
+}
+
+}  // end namespace Eigen
+
+#endif  // EIGEN_BATCHED_PRODUCT_H
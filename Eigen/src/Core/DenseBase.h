@@ -344,6 +344,7 @@ class DenseBase
   EIGEN_DEVICE_FUNC Derived& setZero();
   EIGEN_DEVICE_FUNC Derived& setOnes();
   EIGEN_DEVICE_FUNC Derived& setRandom();
+  Derived& setRandom(const RandomStream& stream);
 
   template <typename OtherDerived>
   EIGEN_DEVICE_FUNC bool isApprox(const DenseBase<OtherDerived>& other,
@@ -460,6 +461,11 @@ class DenseBase
     return maxCoeff<PropagateFast>(index);
   }
 
+  template <typename ValuesType, typename IndicesType>
+  void maxCoeffs(Index k, ValuesType& values, IndicesType& rows, IndicesType& cols) const;
+  template <typename ValuesType, typename IndicesType>
+  void maxCoeffs(Index k, ValuesType& values, IndicesType& indices) const;
+
   template <typename BinaryOp>
   EIGEN_DEVICE_FUNC Scalar redux(const BinaryOp& func) const;
 
@@ -515,6 +521,17 @@ class DenseBase
   static const RandomReturnType Random(Index rows, Index cols);
   static const RandomReturnType Random(Index size);
   static const RandomReturnType Random();
+  static const RandomReturnType Random(Index rows, Index cols, const RandomStream& stream);
+  static const RandomReturnType Random(Index size, const RandomStream& stream);
+  static const RandomReturnType Random(const RandomStream& stream);
+
+  typedef CwiseNullaryOp<internal::counter_random_op<Scalar, true>, PlainObject> RandomNormalReturnType;
+  static const RandomNormalReturnType RandomNormal(Index rows, Index cols);
+  static const RandomNormalReturnType RandomNormal(Index size);
+  static const RandomNormalReturnType RandomNormal();
+  static const RandomNormalReturnType RandomNormal(Index rows, Index cols, const RandomStream& stream);
+  static const RandomNormalReturnType RandomNormal(Index size, const RandomStream& stream);
+  static const RandomNormalReturnType RandomNormal(const RandomStream& stream);
 
   template <typename ThenDerived, typename ElseDerived>
   inline EIGEN_DEVICE_FUNC
@@ -11,6 +11,11 @@
 #define EIGEN_DEVICEWRAPPER_H
 
 namespace Eigen {
+namespace internal {
+template <typename Xpr, typename Func, typename Device>
+struct redux_with_device;
+}  // namespace internal
+
 template <typename Derived, typename Device>
 struct DeviceWrapper {
   using Base = EigenBase<internal::remove_all_t<Derived>>;
@@ -38,6 +43,32 @@ struct DeviceWrapper {
     return m_xpr;
   }
 
+  // full reductions, see DenseBase::redux()
+  template <typename Func>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar redux(const Func& func) const {
+    eigen_assert(m_xpr.rows() > 0 && m_xpr.cols() > 0 && "you are using an empty matrix");
+    return internal::redux_with_device<internal::remove_all_t<Derived>, Func, Device>::run(m_xpr, func, m_device);
+  }
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar sum() const {
+    if (m_xpr.size() == 0) return Scalar(0);
+    return redux(internal::scalar_sum_op<Scalar, Scalar>());
+  }
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar mean() const {
+    return redux(internal::scalar_sum_op<Scalar, Scalar>()) / Scalar(m_xpr.size());
+  }
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar prod() const {
+    if (m_xpr.size() == 0) return Scalar(1);
+    return redux(internal::scalar_product_op<Scalar>());
+  }
+  template <int NaNPropagation = PropagateFast>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar minCoeff() const {
+    return redux(internal::scalar_min_op<Scalar, Scalar, NaNPropagation>());
+  }
+  template <int NaNPropagation = PropagateFast>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar maxCoeff() const {
+    return redux(internal::scalar_max_op<Scalar, Scalar, NaNPropagation>());
+  }
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Derived& derived() { return m_xpr; }
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Device& device() { return m_device; }
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE NoAlias<DeviceWrapper, EigenBase> noalias() {
@@ -90,6 +121,14 @@ struct dense_assignment_loop_with_device {
   static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE EIGEN_CONSTEXPR void run(Kernel& kernel, Device&) { Base::run(kernel); }
 };
 
+// unless otherwise specified, reductions are evaluated by the calling thread
+template <typename Xpr, typename Func, typename Device>
+struct redux_with_device {
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE typename Xpr::Scalar run(const Xpr& xpr, const Func& func, Device&) {
+    return xpr.redux(func);
+  }
+};
+
 // entry point for a generic expression with device
 template <typename Dst, typename Src, typename Func, typename Device>
 EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE EIGEN_CONSTEXPR void call_assignment_no_alias(DeviceWrapper<Dst, Device> dst,
@@ -307,13 +307,13 @@ struct gemv_dense_selector<OnTheRight, ColMajor, true> {
     if (!MightCannotUseDest) {
       // shortcut if we are sure to be able to use dest directly,
       // this ease the compiler to generate cleaner and more optimzized code for most common cases
-      general_matrix_vector_product<Index, LhsScalar, LhsMapper, ColMajor, LhsBlasTraits::NeedToConjugate, RhsScalar,
-                                    RhsMapper, RhsBlasTraits::NeedToConjugate>::run(actualLhs.rows(), actualLhs.cols(),
-                                                                                    LhsMapper(actualLhs.data(),
-                                                                                              actualLhs.outerStride()),
-                                                                                    RhsMapper(actualRhs.data(),
-                                                                                              actualRhs.innerStride()),
-                                                                                    dest.data(), 1, compatibleAlpha);
+      parallel_matrix_vector_product<Index, LhsScalar, LhsMapper, ColMajor, LhsBlasTraits::NeedToConjugate, RhsScalar,
+                                     RhsMapper, RhsBlasTraits::NeedToConjugate>::run(actualLhs.rows(), actualLhs.cols(),
+                                                                                     LhsMapper(actualLhs.data(),
+                                                                                               actualLhs.outerStride()),
+                                                                                     RhsMapper(actualRhs.data(),
+                                                                                               actualRhs.innerStride()),
+                                                                                     dest.data(), 1, compatibleAlpha);
     } else {
       gemv_static_vector_if<ResScalar, ActualDest::SizeAtCompileTime, ActualDest::MaxSizeAtCompileTime,
                             MightCannotUseDest>
@@ -337,13 +337,13 @@ struct gemv_dense_selector<OnTheRight, ColMajor, true> {
           MappedDest(actualDestPtr, dest.size()) = dest;
       }
 
-      general_matrix_vector_product<Index, LhsScalar, LhsMapper, ColMajor, LhsBlasTraits::NeedToConjugate, RhsScalar,
-                                    RhsMapper, RhsBlasTraits::NeedToConjugate>::run(actualLhs.rows(), actualLhs.cols(),
-                                                                                    LhsMapper(actualLhs.data(),
-                                                                                              actualLhs.outerStride()),
-                                                                                    RhsMapper(actualRhs.data(),
-                                                                                              actualRhs.innerStride()),
-                                                                                    actualDestPtr, 1, compatibleAlpha);
+      parallel_matrix_vector_product<Index, LhsScalar, LhsMapper, ColMajor, LhsBlasTraits::NeedToConjugate, RhsScalar,
+                                     RhsMapper, RhsBlasTraits::NeedToConjugate>::run(actualLhs.rows(), actualLhs.cols(),
+                                                                                     LhsMapper(actualLhs.data(),
+                                                                                               actualLhs.outerStride()),
+                                                                                     RhsMapper(actualRhs.data(),
+                                                                                               actualRhs.innerStride()),
+                                                                                     actualDestPtr, 1, compatibleAlpha);
 
       if (!evalToDest) {
         if (!alphaIsCompatible)
@@ -399,8 +399,8 @@ struct gemv_dense_selector<OnTheRight, RowMajor, true> {
 
     typedef const_blas_data_mapper<LhsScalar, Index, RowMajor> LhsMapper;
     typedef const_blas_data_mapper<RhsScalar, Index, ColMajor> RhsMapper;
-    general_matrix_vector_product<Index, LhsScalar, LhsMapper, RowMajor, LhsBlasTraits::NeedToConjugate, RhsScalar,
-                                  RhsMapper, RhsBlasTraits::NeedToConjugate>::
+    parallel_matrix_vector_product<Index, LhsScalar, LhsMapper, RowMajor, LhsBlasTraits::NeedToConjugate, RhsScalar,
+                                   RhsMapper, RhsBlasTraits::NeedToConjugate>::
         run(actualLhs.rows(), actualLhs.cols(), LhsMapper(actualLhs.data(), actualLhs.outerStride()),
             RhsMapper(actualRhsPtr, 1), dest.data(),
             dest.col(0).innerStride(),  // NOTE  if dest is not a vector at compile-time, then dest.innerStride() might
@@ -0,0 +1,240 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PACKED_MATRIX_H
+#define EIGEN_PACKED_MATRIX_H
+
+// IWYU pragma: private
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+template <typename Scalar_>
+class PackedMatrix;
+
+namespace internal {
+
+template <typename Scalar, typename Rhs>
+struct packed_lhs_product_retval;
+
+template <typename Scalar, typename Rhs>
+struct traits<packed_lhs_product_retval<Scalar, Rhs> > {
+  typedef Matrix<Scalar, Dynamic, Rhs::ColsAtCompileTime, ColMajor, Dynamic, Rhs::MaxColsAtCompileTime> ReturnType;
+};
+
+template <typename Scalar, typename Rhs>
+struct packed_lhs_product_retval : public ReturnByValue<packed_lhs_product_retval<Scalar, Rhs> > {
+  typedef typename traits<packed_lhs_product_retval>::ReturnType ReturnType;
+  typedef blas_traits<Rhs> RhsBlasTraits;
+  typedef typename RhsBlasTraits::DirectLinearAccessType ActualRhsType;
+  typedef remove_all_t<ActualRhsType> ActualRhsTypeCleaned;
+
+  packed_lhs_product_retval(const PackedMatrix<Scalar>& lhs, const Rhs& rhs) : m_lhs(lhs), m_rhs(rhs) {
+    eigen_assert(lhs.cols() == rhs.rows() && "invalid matrix product");
+  }
+
+  inline Index rows() const { return m_lhs.rows(); }
+  inline Index cols() const { return m_rhs.cols(); }
+
+  template <typename Dest>
+  void evalTo(Dest& dst) const {
+    run(dst, Scalar(1), true);
+  }
+
+  template <typename Dest>
+  void addTo(Dest& dst) const {
+    run(dst, Scalar(1), false);
+  }
+
+  template <typename Dest>
+  void subTo(Dest& dst) const {
+    run(dst, Scalar(-1), false);
+  }
+
+  template <typename Dest>
+  void scaleAndAddTo(Dest& dst, const Scalar& alpha) const {
+    run(dst, alpha, false);
+  }
+
+ private:
+  // Computes dst = alpha * lhs * rhs if overwrite is true, and dst += alpha * lhs * rhs otherwise.
+  template <typename Dest>
+  void run(Dest& dst, const Scalar& alpha, bool overwrite) const {
+    eigen_assert(dst.rows() == rows() && dst.cols() == cols());
+    if (rows() == 0 || cols() == 0) return;
+    if (m_lhs.cols() == 0) {
+      if (overwrite) dst.setZero();
+      return;
+    }
+    // The packed lhs can only be used to compute a column-major result, so anything else goes through a temporary.
+    enum { DestIsColMajor = (int(Dest::Flags) & DirectAccessBit) && !(int(Dest::Flags) & RowMajorBit) };
+    run(dst, alpha, overwrite, std::integral_constant<bool, bool(DestIsColMajor)>());
+  }
+
+  template <typename Dest>
+  void run(Dest& dst, const Scalar& alpha, bool overwrite, std::true_type) const {
+    add_const_on_value_type_t<ActualRhsType> rhs = RhsBlasTraits::extract(m_rhs);
+    Scalar actualAlpha = alpha * RhsBlasTraits::extractScalarFactor(m_rhs);
+    if (overlaps(dst, rhs)) {
+      // The kernel writes the result while it still reads the rhs, e.g., in x = packed * x, so the rhs is copied first
+      // as the general matrix product would do without noalias().
+      typename ActualRhsTypeCleaned::PlainObject rhsCopy(rhs);
+      runPacked(dst, actualAlpha, overwrite, rhsCopy);
+    } else {
+      runPacked(dst, actualAlpha, overwrite, rhs);
+    }
+  }
+
+  template <typename Dest>
+  void run(Dest& dst, const Scalar& alpha, bool overwrite, std::false_type) const {
+    ReturnType tmp = ReturnType::Zero(rows(), cols());
+    run(tmp, alpha, false, std::true_type());
+    if (overwrite)
+      dst = tmp;
+    else
+      dst += tmp;
+  }
+
+  template <typename Dest, typename ActualRhs>
+  void runPacked(Dest& dst, const Scalar& actualAlpha, bool overwrite, const ActualRhs& rhs) const {
+    if (overwrite) dst.setZero();
+    general_matrix_matrix_product_packed_lhs<
+        Index, Scalar, (ActualRhs::Flags & RowMajorBit) ? RowMajor : ColMajor, bool(RhsBlasTraits::NeedToConjugate),
+        Dest::InnerStrideAtCompileTime>::run(rows(), cols(), m_lhs.cols(), m_lhs.data(), m_lhs.blockRows(),
+                                             m_lhs.blockDepth(), &rhs.coeffRef(0, 0), rhs.outerStride(), dst.data(),
+                                             dst.innerStride(), dst.outerStride(), actualAlpha);
+  }
+
+  // Returns true if the coefficients of the two direct access expressions may share some memory.
+  template <typename A, typename B>
+  static bool overlaps(const A& a, const B& b) {
+    const std::uintptr_t aBegin = reinterpret_cast<std::uintptr_t>(a.data());
+    const std::uintptr_t bBegin = reinterpret_cast<std::uintptr_t>(b.data());
+    const std::uintptr_t aEnd = aBegin + sizeof(Scalar) * std::size_t(extent(a));
+    const std::uintptr_t bEnd = bBegin + sizeof(Scalar) * std::size_t(extent(b));
+    return aBegin < bEnd && bBegin < aEnd;
+  }
+
+  // Returns the number of coefficients between the first and the last coefficients of the expression, included.
+  template <typename Xpr>
+  static Index extent(const Xpr& xpr) {
+    if (xpr.size() == 0) return 0;
+    return (xpr.outerSize() - 1) * xpr.outerStride() + (xpr.innerSize() - 1) * xpr.innerStride() + 1;
+  }
+
+  const PackedMatrix<Scalar>& m_lhs;
+  typename Rhs::Nested m_rhs;
+};
+
+}  // end namespace internal
+
+/** \class PackedMatrix
+ * \ingroup Core_Module
+ *
+ * \brief A dense matrix stored in the packed layout of the matrix-matrix product kernel
+ *
+ * \tparam Scalar_ the type of the coefficients
+ *
+ * The general matrix-matrix product copies blocks of its left-hand side into a cache-friendly layout before running
+ * the inner kernel. When the same matrix is multiplied by many different right-hand sides, this packing is repeated
+ * on every call. A PackedMatrix performs it once, using the same level 3 blocking as the regular product, and keeps
+ * the result around so that subsequent products directly run on the packed blocks:
+ * \code
+ * PackedMatrix<float> packed(weights);   // or: auto packed = prepack(weights);
+ * for (const MatrixXf& input : inputs) {
+ *   output = packed * input;
+ *   ...
+ * }
+ * \endcode
+ *
+ * The right-hand side can be any dense expression, and may alias the result as in \c x \c = \c packed \c * \c x, in
+ * which case it is copied first. Products are computed on a single thread.
+ *
+ * The coefficients of the original matrix cannot be accessed anymore, and later changes to it are not reflected by
+ * the packed matrix. Call compute() to pack it again.
+ *
+ * \sa prepack()
+ */
+template <typename Scalar_>
+class PackedMatrix {
+ public:
+  typedef Scalar_ Scalar;
+
+  /** Default constructor, builds an empty packed matrix. */
+  PackedMatrix() : m_rows(0), m_cols(0), m_mc(0), m_kc(0) {}
+
+  /** Packs \a matrix, see compute(). */
+  template <typename Derived>
+  explicit PackedMatrix(const MatrixBase<Derived>& matrix, Index expectedCols = -1) {
+    compute(matrix, expectedCols);
+  }
+
+  /** Packs \a matrix as the left-hand side of matrix products.
+   *
+   * \param expectedCols the typical number of columns of the right-hand sides. It is used to select the blocking
+   *        sizes, and defaults to the number of rows of \a matrix.
+   */
+  template <typename Derived>
+  PackedMatrix& compute(const MatrixBase<Derived>& matrix, Index expectedCols = -1) {
+    EIGEN_STATIC_ASSERT((internal::is_same<typename Derived::Scalar, Scalar>::value),
+                        YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+    enum { StorageOrder = Derived::IsRowMajor ? RowMajor : ColMajor };
+    typedef internal::general_matrix_matrix_product_packed_lhs<Index, Scalar, ColMajor, false, 1> Packer;
+
+    const Ref<const Matrix<Scalar, Dynamic, Dynamic, StorageOrder>, 0, OuterStride<> > lhs(matrix.derived());
+    m_rows = lhs.rows();
+    m_cols = lhs.cols();
+    internal::gemm_blocking_space<ColMajor, Scalar, Scalar, Dynamic, Dynamic, Dynamic> blocking(
+        m_rows, expectedCols < 0 ? m_rows : expectedCols, m_cols, 1, true);
+    m_mc = numext::mini(m_rows, blocking.mc());
+    m_kc = numext::mini(m_cols, blocking.kc());
+    m_data.resize(m_rows > 0 && m_cols > 0 ? Packer::packedSize(m_rows, m_cols, m_mc, m_kc) : 0);
+    if (m_data.size() > 0)
+      Packer::template pack<StorageOrder, false>(m_rows, m_cols, lhs.data(), lhs.outerStride(), m_data.data(), m_mc,
+                                                 m_kc);
+    return *this;
+  }
+
+  /** \returns the number of rows of the packed matrix */
+  inline Index rows() const { return m_rows; }
+  /** \returns the number of columns of the packed matrix */
+  inline Index cols() const { return m_cols; }
+  /** \returns the number of rows of the packed blocks */
+  inline Index blockRows() const { return m_mc; }
+  /** \returns the number of columns of the packed blocks */
+  inline Index blockDepth() const { return m_kc; }
+  /** \returns a pointer to the packed coefficients */
+  inline const Scalar* data() const { return m_data.data(); }
+
+  /** \returns an expression of the product of the packed matrix with \a rhs */
+  template <typename Rhs>
+  const internal::packed_lhs_product_retval<Scalar, Rhs> operator*(const MatrixBase<Rhs>& rhs) const {
+    EIGEN_STATIC_ASSERT((internal::is_same<typename Rhs::Scalar, Scalar>::value),
+                        YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+    return internal::packed_lhs_product_retval<Scalar, Rhs>(*this, rhs.derived());
+  }
+
+ protected:
+  Matrix<Scalar, Dynamic, 1> m_data;
+  Index m_rows;
+  Index m_cols;
+  Index m_mc;
+  Index m_kc;
+};
+
+/** \relates PackedMatrix
+ * \returns \a matrix packed as the left-hand side of matrix products, see PackedMatrix::compute() */
+template <typename Derived>
+PackedMatrix<typename Derived::Scalar> prepack(const MatrixBase<Derived>& matrix, Index expectedCols = -1) {
+  return PackedMatrix<typename Derived::Scalar>(matrix, expectedCols);
+}
+
+}  // end namespace Eigen
+
+#endif  // EIGEN_PACKED_MATRIX_H
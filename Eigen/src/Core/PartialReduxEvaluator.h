@@ -67,6 +67,25 @@ EIGEN_DEVICE_FUNC PacketType packetwise_redux_empty_value(const scalar_product_o
 template <typename Func, typename Evaluator, int Unrolling = packetwise_redux_traits<Func, Evaluator>::Unrolling>
 struct packetwise_redux_impl;
 
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+/* Perform the actual reduction along the fixed-shape tree of the full reductions, see deterministic_redux_impl, such
+ * that every lane of the result matches the scalar path */
+template <typename Func, typename Evaluator, int Unrolling>
+struct packetwise_redux_impl {
+  template <typename PacketType>
+  static PacketType run(const Evaluator& eval, const Func& func, Index size) {
+    if (size == 0) return packetwise_redux_empty_value<PacketType>(func);
+    auto get = [&](Index i) { return eval.template packetByOuterInner<Unaligned, PacketType>(i, 0); };
+    const redux_packet_op<Func> op = {func};
+    auto leaf = [&](Index i) {
+      const Index begin = i * Index(deterministic_redux_shape::LeafSize);
+      return deterministic_redux_lanes<PacketType>(
+          op, get, begin, numext::mini<Index>(begin + Index(deterministic_redux_shape::LeafSize), size));
+    };
+    return deterministic_redux_leaves<PacketType>(op, leaf, 0, deterministic_redux_shape::leaves(size));
+  }
+};
+#else
 /* Perform the actual reduction with unrolling */
 template <typename Func, typename Evaluator>
 struct packetwise_redux_impl<Func, Evaluator, CompleteUnrolling> {
@@ -119,6 +138,7 @@ struct packetwise_redux_impl<Func, Evaluator, NoUnrolling> {
     return p;
   }
 };
+#endif  // EIGEN_DETERMINISTIC_REDUCTIONS
 
 template <typename ArgType, typename MemberOp, int Direction>
 struct evaluator<PartialReduxExpr<ArgType, MemberOp, Direction> >
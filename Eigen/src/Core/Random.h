@@ -15,18 +15,419 @@
 
 namespace Eigen {
 
+/** \class RandomStream
+ * \ingroup Core_Module
+ *
+ * \brief A seeded stream of random numbers for DenseBase::Random() and DenseBase::RandomNormal()
+ *
+ * The coefficients of a random expression are computed by a counter-based generator (Threefry, see Salmon et al.,
+ * "Parallel random numbers: as easy as 1, 2, 3", SC'11), which encrypts the position of each coefficient in the
+ * storage order with a key derived from the seed and the stream. Therefore, the random coefficients only depend on the
+ * stream and on the size and storage order of the expression, and not on the traversal, the vectorization or the
+ * number of threads evaluating it. Distinct streams of the same seed are independent, e.g. one per thread or task.
+ *
+ * \sa DenseBase::Random(Index,Index,const RandomStream&), DenseBase::RandomNormal(Index,Index,const RandomStream&)
+ */
+class RandomStream {
+ public:
+  /** Default constructor, drawing the seed from std::rand(), see std::srand().
+   *
+   * \not_reentrant
+   */
+  RandomStream() : m_seed(internal::random<uint64_t>()), m_stream(0) {}
+
+  /** Constructs the stream of index \a stream of the given \a seed. */
+  explicit RandomStream(uint64_t seed, uint64_t stream = 0) : m_seed(seed), m_stream(stream) {}
+
+  uint64_t seed() const { return m_seed; }
+  uint64_t stream() const { return m_stream; }
+
+ private:
+  uint64_t m_seed;
+  uint64_t m_stream;
+};
+
 namespace internal {
 
+template <typename Word>
+struct threefry_traits;
+
+template <>
+struct threefry_traits<uint32_t> {
+  static constexpr uint32_t Parity = 0x1BD11BDAu;
+  static constexpr int Rotations[8] = {13, 15, 26, 6, 17, 29, 16, 24};
+};
+
+template <>
+struct threefry_traits<uint64_t> {
+  static constexpr uint64_t Parity = 0x1BD11BDAA9FC1A22ull;
+  static constexpr int Rotations[8] = {16, 42, 12, 31, 16, 32, 24, 21};
+};
+
+// Broadcasts a word to the lanes of T, which is either the word type itself or an integer packet of the same width.
+template <typename T, typename Word>
+EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE T threefry_set1(Word w) {
+  return pset1<T>(static_cast<typename unpacket_traits<T>::type>(w));
+}
+
+template <typename Word, int Round = 0, bool Done = (Round == 20)>
+struct threefry_rounds {
+  template <typename T>
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void run(T& x0, T& x1, const Word* ks) {
+    constexpr int Bits = sizeof(Word) * CHAR_BIT;
+    constexpr int R = threefry_traits<Word>::Rotations[Round % 8];
+    x0 = padd(x0, x1);
+    x1 = pxor(por(plogical_shift_left<R>(x1), plogical_shift_right<Bits - R>(x1)), x0);
+    if (Round % 4 == 3) {
+      // Key injection every four rounds.
+      constexpr int S = Round / 4 + 1;
+      x0 = padd(x0, threefry_set1<T>(ks[S % 3]));
+      x1 = padd(x1, threefry_set1<T>(static_cast<Word>(ks[(S + 1) % 3] + S)));
+    }
+    threefry_rounds<Word, Round + 1>::run(x0, x1, ks);
+  }
+};
+
+template <typename Word, int Round>
+struct threefry_rounds<Word, Round, true> {
+  template <typename T>
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void run(T&, T&, const Word*) {}
+};
+
+// The Threefry-2x32-20 and Threefry-2x64-20 block ciphers. The words of the counter are either scalars or integer
+// packets, whose lanes are encrypted independently.
+template <typename Word>
+class threefry_key {
+ public:
+  EIGEN_DEVICE_FUNC threefry_key(Word k0, Word k1) {
+    m_ks[0] = k0;
+    m_ks[1] = k1;
+    m_ks[2] = static_cast<Word>(threefry_traits<Word>::Parity ^ k0 ^ k1);
+  }
+
+  template <typename T>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void encrypt(T& x0, T& x1) const {
+    x0 = padd(x0, threefry_set1<T>(m_ks[0]));
+    x1 = padd(x1, threefry_set1<T>(m_ks[1]));
+    threefry_rounds<Word>::run(x0, x1, m_ks);
+  }
+
+ private:
+  Word m_ks[3];
+};
+
+template <typename Packet, typename = void>
+struct has_integer_packet : std::false_type {};
+template <typename Packet>
+struct has_integer_packet<Packet, void_t<typename unpacket_traits<Packet>::integer_packet>> : std::true_type {};
+
+template <typename Scalar>
+struct counter_random_traits {
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef typename packet_traits<Scalar>::type Packet;
+  // Words of the counter and of the random bits.
+  typedef std::conditional_t<(sizeof(RealScalar) <= 4), uint32_t, uint64_t> Word;
+  enum {
+    Enabled = std::is_floating_point<RealScalar>::value || std::is_same<RealScalar, half>::value ||
+              std::is_same<RealScalar, bfloat16>::value ||
+              (std::is_integral<RealScalar>::value && sizeof(RealScalar) <= 8 && !NumTraits<Scalar>::IsComplex),
+    // The random bits are reinterpreted as the mantissa of floats and doubles in their integer packets.
+    PacketAccess = (std::is_same<Scalar, float>::value || std::is_same<Scalar, double>::value) &&
+                   packet_traits<Scalar>::Vectorizable && has_integer_packet<Packet>::value,
+    NormalPacketAccess = PacketAccess && packet_traits<Scalar>::HasLog && packet_traits<Scalar>::HasSqrt &&
+                         packet_traits<Scalar>::HasCos
+  };
+};
+
+// \returns a float in [base, 2 * base) made of the high bits of x, where base is a power of two.
+template <typename Scalar, typename Word>
+EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar counter_random_mantissa(Word x, const Scalar& base) {
+  typedef typename numext::get_integer_by_size<sizeof(Scalar)>::unsigned_type Bits;
+  constexpr int Shift = sizeof(Word) * CHAR_BIT - (std::numeric_limits<Scalar>::digits - 1);
+  return numext::bit_cast<Scalar>(static_cast<Bits>(static_cast<Bits>(x >> Shift) | numext::bit_cast<Bits>(base)));
+}
+
+template <typename Packet, typename PacketI>
+EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Packet pcounter_random_mantissa(const PacketI& x,
+                                                                      const typename unpacket_traits<Packet>::type& base) {
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  typedef typename unpacket_traits<PacketI>::type Lane;
+  constexpr int Shift = sizeof(Lane) * CHAR_BIT - (std::numeric_limits<Scalar>::digits - 1);
+  return preinterpret<Packet>(por(plogical_shift_right<Shift>(x), pset1<PacketI>(numext::bit_cast<Lane>(base))));
+}
+
+// Maps a word of random bits to a coefficient uniformly distributed over the whole range of integer types, and over
+// [-1, 1) for floating point types.
+template <typename Scalar, bool IsInteger = NumTraits<Scalar>::IsInteger>
+struct counter_random_uniform {
+  template <typename Word>
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar run(Word x) {
+    return counter_random_mantissa(x, Scalar(2)) - Scalar(3);
+  }
+};
+
+template <typename Scalar>
+struct counter_random_uniform<Scalar, true> {
+  template <typename Word>
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar run(Word x) {
+    return static_cast<Scalar>(x);
+  }
+};
+
+template <>
+struct counter_random_uniform<bool, true> {
+  template <typename Word>
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE bool run(Word x) {
+    return (x & 1) != 0;
+  }
+};
+
+template <>
+struct counter_random_uniform<long double, false> {
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE long double run(uint64_t x) {
+    return static_cast<long double>(counter_random_uniform<double>::run(x));
+  }
+};
+
+// Box-Muller transform of two words of random bits, computed in float for 32-bit words and in double for 64-bit ones.
+template <typename Word, typename Real = std::conditional_t<sizeof(Word) == 4, float, double>>
+EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void counter_random_box_muller(Word x0, Word x1, Real& radius, Real& angle) {
+  radius = numext::sqrt(Real(-2) * numext::log(Real(2) - counter_random_mantissa(x0, Real(1))));
+  angle = Real(2 * EIGEN_PI) * (counter_random_mantissa(x1, Real(1)) - Real(1));
+}
+
+template <typename Scalar, bool Normal, bool IsComplex = NumTraits<Scalar>::IsComplex>
+struct counter_random_from_words {
+  template <typename Word>
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar run(Word x0, Word) {
+    return counter_random_uniform<Scalar>::run(x0);
+  }
+};
+
+template <typename Scalar>
+struct counter_random_from_words<Scalar, false, true> {
+  template <typename Word>
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar run(Word x0, Word x1) {
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    return Scalar(counter_random_uniform<RealScalar>::run(x0), counter_random_uniform<RealScalar>::run(x1));
+  }
+};
+
+template <typename Scalar>
+struct counter_random_from_words<Scalar, true, false> {
+  EIGEN_STATIC_ASSERT(!NumTraits<Scalar>::IsInteger, THIS_FUNCTION_IS_NOT_FOR_INTEGER_NUMERIC_TYPES)
+  template <typename Word>
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar run(Word x0, Word x1) {
+    std::conditional_t<sizeof(Word) == 4, float, double> radius, angle;
+    counter_random_box_muller(x0, x1, radius, angle);
+    return static_cast<Scalar>(radius * numext::cos(angle));
+  }
+};
+
+// The real and imaginary parts of complex normal coefficients are independent standard normal numbers.
+template <typename Scalar>
+struct counter_random_from_words<Scalar, true, true> {
+  template <typename Word>
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar run(Word x0, Word x1) {
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    std::conditional_t<sizeof(Word) == 4, float, double> radius, angle;
+    counter_random_box_muller(x0, x1, radius, angle);
+    return Scalar(static_cast<RealScalar>(radius * numext::cos(angle)),
+                  static_cast<RealScalar>(radius * numext::sin(angle)));
+  }
+};
+
+template <typename Packet, bool Normal>
+struct pcounter_random_from_words {
+  template <typename PacketI>
+  static EIGEN_STRONG_INLINE Packet run(const PacketI& x0, const PacketI&) {
+    typedef typename unpacket_traits<Packet>::type Scalar;
+    return psub(pcounter_random_mantissa<Packet>(x0, Scalar(2)), pset1<Packet>(Scalar(3)));
+  }
+};
+
+template <typename Packet>
+struct pcounter_random_from_words<Packet, true> {
+  template <typename PacketI>
+  static EIGEN_STRONG_INLINE Packet run(const PacketI& x0, const PacketI& x1) {
+    typedef typename unpacket_traits<Packet>::type Scalar;
+    const Packet one = pset1<Packet>(Scalar(1));
+    const Packet u1 = psub(pset1<Packet>(Scalar(2)), pcounter_random_mantissa<Packet>(x0, Scalar(1)));
+    const Packet u2 = psub(pcounter_random_mantissa<Packet>(x1, Scalar(1)), one);
+    const Packet radius = psqrt(pmul(pset1<Packet>(Scalar(-2)), plog(u1)));
+    return pmul(radius, pcos(pmul(pset1<Packet>(Scalar(2 * EIGEN_PI)), u2)));
+  }
+};
+
+// Random coefficients, uniform or standard normal, computed from the encryption of their position in the storage
+// order of the expression. For 32-bit words, the counter is made of the low and high words of the position.
+template <typename Scalar, bool Normal>
+struct counter_random_op {
+  typedef counter_random_traits<Scalar> Traits;
+  typedef typename Traits::Word Word;
+  enum { PacketAccess = Normal ? int(Traits::NormalPacketAccess) : int(Traits::PacketAccess) };
+
+  counter_random_op(const RandomStream& stream, Index rows, Index cols, bool rowMajor)
+      : m_key(make_key(stream)), m_rowStride(rowMajor ? cols : 1), m_colStride(rowMajor ? 1 : rows) {}
+  counter_random_op(Index rows, Index cols, bool rowMajor) : counter_random_op(RandomStream(), rows, cols, rowMajor) {}
+
+  EIGEN_STRONG_INLINE Scalar operator()(Index i, Index j) const { return (*this)(i * m_rowStride + j * m_colStride); }
+
+  EIGEN_STRONG_INLINE Scalar operator()(Index index) const {
+    return coeff(index, std::integral_constant<bool, Normal && PacketAccess>());
+  }
+
+  template <typename Packet>
+  EIGEN_STRONG_INLINE Packet packetOp(Index i, Index j) const {
+    return packetOp<Packet>(i * m_rowStride + j * m_colStride);
+  }
+
+  template <typename Packet>
+  EIGEN_STRONG_INLINE Packet packetOp(Index index) const {
+    return packet<Packet>(
+        index, std::integral_constant<bool, Normal && !std::is_same<Packet, typename Traits::Packet>::value>());
+  }
+
+ private:
+  template <typename Packet>
+  EIGEN_STRONG_INLINE Packet packet(Index index, std::false_type) const {
+    typedef typename unpacket_traits<Packet>::integer_packet PacketI;
+    typedef typename unpacket_traits<PacketI>::type Lane;
+    enum { Size = unpacket_traits<Packet>::size };
+    PacketI x0, x1;
+    if (static_cast<Word>(index) > static_cast<Word>(~Word(Size - 1))) {
+      // The low words of the lanes would wrap around.
+      Lane w0[Size], w1[Size];
+      for (Index k = 0; k < Size; ++k) {
+        Word y0, y1;
+        words(index + k, y0, y1);
+        w0[k] = static_cast<Lane>(y0);
+        w1[k] = static_cast<Lane>(y1);
+      }
+      x0 = ploadu<PacketI>(w0);
+      x1 = ploadu<PacketI>(w1);
+    } else {
+      x0 = plset<PacketI>(static_cast<Lane>(static_cast<Word>(index)));
+      x1 = pset1<PacketI>(static_cast<Lane>(high_word(index)));
+      m_key.encrypt(x0, x1);
+    }
+    return pcounter_random_from_words<Packet, Normal>::run(x0, x1);
+  }
+
+  // The vectorized normal transform depends on the packet size in the last bits, hence the normal coefficients are
+  // always computed with full packets, including the scalar ones.
+  template <typename Packet>
+  EIGEN_STRONG_INLINE Packet packet(Index index, std::true_type) const {
+    typedef typename Traits::Packet FullPacket;
+    EIGEN_ALIGN_MAX Scalar values[unpacket_traits<FullPacket>::size];
+    pstore(values, packet<FullPacket>(index, std::false_type()));
+    return ploadu<Packet>(values);
+  }
+  static threefry_key<Word> make_key(const RandomStream& stream) {
+    // Keys of the streams, as the encryption of (seed, stream) with a fixed key.
+    uint64_t k0 = stream.seed(), k1 = stream.stream();
+    threefry_key<uint64_t>(0x243F6A8885A308D3ull, 0x13198A2E03707344ull).encrypt(k0, k1);
+    return threefry_key<Word>(static_cast<Word>(k0), static_cast<Word>(k1));
+  }
+
+  static EIGEN_STRONG_INLINE Word high_word(Index index) {
+    return sizeof(Word) == 4 ? static_cast<Word>(static_cast<uint64_t>(index) >> 32) : Word(0);
+  }
+
+  EIGEN_STRONG_INLINE void words(Index index, Word& x0, Word& x1) const {
+    x0 = static_cast<Word>(index);
+    x1 = high_word(index);
+    m_key.encrypt(x0, x1);
+  }
+
+  EIGEN_STRONG_INLINE Scalar coeff(Index index, std::false_type) const {
+    Word x0, x1;
+    words(index, x0, x1);
+    return counter_random_from_words<Scalar, Normal>::run(x0, x1);
+  }
+
+  EIGEN_STRONG_INLINE Scalar coeff(Index index, std::true_type) const {
+    return pfirst(packet<typename Traits::Packet>(index, std::false_type()));
+  }
+
+  threefry_key<Word> m_key;
+  Index m_rowStride;
+  Index m_colStride;
+};
+
+template <typename Scalar, bool Normal>
+struct functor_traits<counter_random_op<Scalar, Normal> > {
+  enum {
+    Cost = 80 * NumTraits<typename counter_random_traits<Scalar>::Word>::AddCost +
+           (Normal ? 4 * NumTraits<Scalar>::MulCost + 60 : 0),
+    PacketAccess = counter_random_op<Scalar, Normal>::PacketAccess,
+    IsRepeatable = true
+  };
+};
+
+template <typename Scalar, bool Normal>
+struct functor_has_linear_access<counter_random_op<Scalar, Normal> > {
+  enum { ret = 1 };
+};
+
+// Custom scalar types draw their coefficients one after the other from internal::random().
 template <typename Scalar>
-struct scalar_random_op {
+struct sequential_random_op {
+  sequential_random_op(Index, Index, bool) {}
   inline const Scalar operator()() const { return random<Scalar>(); }
 };
 
 template <typename Scalar>
-struct functor_traits<scalar_random_op<Scalar> > {
+struct functor_traits<sequential_random_op<Scalar> > {
   enum { Cost = 5 * NumTraits<Scalar>::MulCost, PacketAccess = false, IsRepeatable = false };
 };
 
+template <typename Scalar>
+struct scalar_random_op : std::conditional_t<counter_random_traits<Scalar>::Enabled, counter_random_op<Scalar, false>,
+                                             sequential_random_op<Scalar> > {
+  typedef std::conditional_t<counter_random_traits<Scalar>::Enabled, counter_random_op<Scalar, false>,
+                             sequential_random_op<Scalar> >
+      Base;
+  using Base::Base;
+};
+
+template <typename Scalar>
+struct functor_traits<scalar_random_op<Scalar> > : functor_traits<typename scalar_random_op<Scalar>::Base> {};
+
+template <typename Scalar>
+struct functor_has_linear_access<scalar_random_op<Scalar> > {
+  enum { ret = 1 };
+};
+
+// For unreliable compilers, see NullaryFunctors.h.
+#if !(EIGEN_COMP_MSVC || EIGEN_COMP_GNUC || (EIGEN_COMP_ICC >= 1600))
+template <typename Scalar, typename IndexType>
+struct has_nullary_operator<scalar_random_op<Scalar>, IndexType> {
+  enum { value = !counter_random_traits<Scalar>::Enabled };
+};
+template <typename Scalar, typename IndexType>
+struct has_unary_operator<scalar_random_op<Scalar>, IndexType> {
+  enum { value = counter_random_traits<Scalar>::Enabled };
+};
+template <typename Scalar, typename IndexType>
+struct has_binary_operator<scalar_random_op<Scalar>, IndexType> {
+  enum { value = counter_random_traits<Scalar>::Enabled };
+};
+
+template <typename Scalar, bool Normal, typename IndexType>
+struct has_nullary_operator<counter_random_op<Scalar, Normal>, IndexType> {
+  enum { value = 0 };
+};
+template <typename Scalar, bool Normal, typename IndexType>
+struct has_unary_operator<counter_random_op<Scalar, Normal>, IndexType> {
+  enum { value = 1 };
+};
+template <typename Scalar, bool Normal, typename IndexType>
+struct has_binary_operator<counter_random_op<Scalar, Normal>, IndexType> {
+  enum { value = 1 };
+};
+#endif
+
 }  // end namespace internal
 
 /** \returns a random matrix expression
@@ -47,9 +448,10 @@ struct functor_traits<scalar_random_op<Scalar> > {
  * Example: \include MatrixBase_random_int_int.cpp
  * Output: \verbinclude MatrixBase_random_int_int.out
  *
- * This expression has the "evaluate before nesting" flag so that it will be evaluated into
- * a temporary matrix whenever it is nested in a larger expression. This prevents unexpected
- * behavior with expressions involving random matrices.
+ * For arithmetic, half, bfloat16 and complex scalar types, the coefficients are computed from their position by a
+ * counter-based generator seeded from std::rand(), see class RandomStream. Nested in a larger expression, they are
+ * vectorized and computed on the fly, and the expression has the same coefficients each time it is evaluated. Other
+ * scalar types draw their coefficients from internal::random() and have the "evaluate before nesting" flag.
  *
  * See DenseBase::NullaryExpr(Index, const CustomNullaryOp&) for an example using C++11 random generators.
  *
@@ -57,7 +459,7 @@ struct functor_traits<scalar_random_op<Scalar> > {
  */
 template <typename Derived>
 inline const typename DenseBase<Derived>::RandomReturnType DenseBase<Derived>::Random(Index rows, Index cols) {
-  return NullaryExpr(rows, cols, internal::scalar_random_op<Scalar>());
+  return NullaryExpr(rows, cols, internal::scalar_random_op<Scalar>(rows, cols, PlainObject::IsRowMajor));
 }
 
 /** \returns a random vector expression
@@ -78,15 +480,17 @@ inline const typename DenseBase<Derived>::RandomReturnType DenseBase<Derived>::R
  * Example: \include MatrixBase_random_int.cpp
  * Output: \verbinclude MatrixBase_random_int.out
  *
- * This expression has the "evaluate before nesting" flag so that it will be evaluated into
- * a temporary vector whenever it is nested in a larger expression. This prevents unexpected
- * behavior with expressions involving random matrices.
+ * For arithmetic, half, bfloat16 and complex scalar types, the coefficients are computed from their position by a
+ * counter-based generator seeded from std::rand(), see class RandomStream. Nested in a larger expression, they are
+ * vectorized and computed on the fly, and the expression has the same coefficients each time it is evaluated. Other
+ * scalar types draw their coefficients from internal::random() and have the "evaluate before nesting" flag.
  *
  * \sa DenseBase::setRandom(), DenseBase::Random(Index,Index), DenseBase::Random()
  */
 template <typename Derived>
 inline const typename DenseBase<Derived>::RandomReturnType DenseBase<Derived>::Random(Index size) {
-  return NullaryExpr(size, internal::scalar_random_op<Scalar>());
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+  return Random(RowsAtCompileTime == 1 ? 1 : size, RowsAtCompileTime == 1 ? size : 1);
 }
 
 /** \returns a fixed-size random matrix or vector expression
@@ -100,9 +504,10 @@ inline const typename DenseBase<Derived>::RandomReturnType DenseBase<Derived>::R
  * Example: \include MatrixBase_random.cpp
  * Output: \verbinclude MatrixBase_random.out
  *
- * This expression has the "evaluate before nesting" flag so that it will be evaluated into
- * a temporary matrix whenever it is nested in a larger expression. This prevents unexpected
- * behavior with expressions involving random matrices.
+ * For arithmetic, half, bfloat16 and complex scalar types, the coefficients are computed from their position by a
+ * counter-based generator seeded from std::rand(), see class RandomStream. Nested in a larger expression, they are
+ * vectorized and computed on the fly, and the expression has the same coefficients each time it is evaluated. Other
+ * scalar types draw their coefficients from internal::random() and have the "evaluate before nesting" flag.
  *
  * \not_reentrant
  *
@@ -110,7 +515,129 @@ inline const typename DenseBase<Derived>::RandomReturnType DenseBase<Derived>::R
  */
 template <typename Derived>
 inline const typename DenseBase<Derived>::RandomReturnType DenseBase<Derived>::Random() {
-  return NullaryExpr(RowsAtCompileTime, ColsAtCompileTime, internal::scalar_random_op<Scalar>());
+  return Random(RowsAtCompileTime, ColsAtCompileTime);
+}
+
+/** \returns a random matrix expression whose coefficients are drawn from the given \a stream
+ *
+ * Numbers are uniformly spread through their whole definition range for integer types,
+ * and in the [-1:1] range for floating point scalar types.
+ *
+ * The coefficients only depend on the \a stream and on the size and storage order of the expression, see class
+ * RandomStream. This is only available for arithmetic, half, bfloat16 and complex scalar types.
+ *
+ * Example:
+ * \code
+ * MatrixXf a = MatrixXf::Random(3, 4, RandomStream(42));
+ * MatrixXf b = MatrixXf::Random(3, 4, RandomStream(42));     // a == b
+ * MatrixXf c = MatrixXf::Random(3, 4, RandomStream(42, 1));  // independent of a
+ * \endcode
+ *
+ * \sa DenseBase::Random(Index,Index), DenseBase::RandomNormal(Index,Index,const RandomStream&)
+ */
+template <typename Derived>
+inline const typename DenseBase<Derived>::RandomReturnType DenseBase<Derived>::Random(Index rows, Index cols,
+                                                                                      const RandomStream& stream) {
+  EIGEN_STATIC_ASSERT(internal::counter_random_traits<Scalar>::Enabled, THIS_TYPE_IS_NOT_SUPPORTED)
+  return NullaryExpr(rows, cols, internal::scalar_random_op<Scalar>(stream, rows, cols, PlainObject::IsRowMajor));
+}
+
+/** \returns a random vector expression whose coefficients are drawn from the given \a stream
+ *
+ * \only_for_vectors
+ *
+ * \sa DenseBase::Random(Index,Index,const RandomStream&)
+ */
+template <typename Derived>
+inline const typename DenseBase<Derived>::RandomReturnType DenseBase<Derived>::Random(Index size,
+                                                                                      const RandomStream& stream) {
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+  return Random(RowsAtCompileTime == 1 ? 1 : size, RowsAtCompileTime == 1 ? size : 1, stream);
+}
+
+/** \returns a fixed-size random matrix or vector expression whose coefficients are drawn from the given \a stream
+ *
+ * \sa DenseBase::Random(Index,Index,const RandomStream&)
+ */
+template <typename Derived>
+inline const typename DenseBase<Derived>::RandomReturnType DenseBase<Derived>::Random(const RandomStream& stream) {
+  return Random(RowsAtCompileTime, ColsAtCompileTime, stream);
+}
+
+/** \returns a matrix expression of standard normal random numbers drawn from the given \a stream
+ *
+ * The numbers are computed from uniform ones with the Box-Muller transform. The real and imaginary parts of
+ * complex coefficients are independent standard normal numbers. Integer scalar types are not supported.
+ *
+ * As with Random(Index,Index,const RandomStream&), the coefficients only depend on the \a stream and on the size and
+ * storage order of the expression, and are vectorized for float and double.
+ *
+ * \sa DenseBase::RandomNormal(Index,Index), DenseBase::Random(Index,Index,const RandomStream&), class RandomStream
+ */
+template <typename Derived>
+inline const typename DenseBase<Derived>::RandomNormalReturnType DenseBase<Derived>::RandomNormal(
+    Index rows, Index cols, const RandomStream& stream) {
+  EIGEN_STATIC_ASSERT(internal::counter_random_traits<Scalar>::Enabled, THIS_TYPE_IS_NOT_SUPPORTED)
+  return NullaryExpr(rows, cols,
+                     internal::counter_random_op<Scalar, true>(stream, rows, cols, PlainObject::IsRowMajor));
+}
+
+/** \returns a vector expression of standard normal random numbers drawn from the given \a stream
+ *
+ * \only_for_vectors
+ *
+ * \sa DenseBase::RandomNormal(Index,Index,const RandomStream&)
+ */
+template <typename Derived>
+inline const typename DenseBase<Derived>::RandomNormalReturnType DenseBase<Derived>::RandomNormal(
+    Index size, const RandomStream& stream) {
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+  return RandomNormal(RowsAtCompileTime == 1 ? 1 : size, RowsAtCompileTime == 1 ? size : 1, stream);
+}
+
+/** \returns a fixed-size matrix or vector expression of standard normal random numbers drawn from the given \a stream
+ *
+ * \sa DenseBase::RandomNormal(Index,Index,const RandomStream&)
+ */
+template <typename Derived>
+inline const typename DenseBase<Derived>::RandomNormalReturnType DenseBase<Derived>::RandomNormal(
+    const RandomStream& stream) {
+  return RandomNormal(RowsAtCompileTime, ColsAtCompileTime, stream);
+}
+
+/** \returns a matrix expression of standard normal random numbers, seeded from std::rand()
+ *
+ * \not_reentrant
+ *
+ * \sa DenseBase::RandomNormal(Index,Index,const RandomStream&)
+ */
+template <typename Derived>
+inline const typename DenseBase<Derived>::RandomNormalReturnType DenseBase<Derived>::RandomNormal(Index rows,
+                                                                                                  Index cols) {
+  return RandomNormal(rows, cols, RandomStream());
+}
+
+/** \returns a vector expression of standard normal random numbers, seeded from std::rand()
+ *
+ * \only_for_vectors
+ * \not_reentrant
+ *
+ * \sa DenseBase::RandomNormal(Index,const RandomStream&)
+ */
+template <typename Derived>
+inline const typename DenseBase<Derived>::RandomNormalReturnType DenseBase<Derived>::RandomNormal(Index size) {
+  return RandomNormal(size, RandomStream());
+}
+
+/** \returns a fixed-size matrix or vector expression of standard normal random numbers, seeded from std::rand()
+ *
+ * \not_reentrant
+ *
+ * \sa DenseBase::RandomNormal(const RandomStream&)
+ */
+template <typename Derived>
+inline const typename DenseBase<Derived>::RandomNormalReturnType DenseBase<Derived>::RandomNormal() {
+  return RandomNormal(RandomStream());
 }
 
 /** Sets all coefficients in this expression to random values.
@@ -130,6 +657,15 @@ EIGEN_DEVICE_FUNC inline Derived& DenseBase<Derived>::setRandom() {
   return *this = Random(rows(), cols());
 }
 
+/** Sets all coefficients in this expression to random values drawn from the given \a stream.
+ *
+ * \sa DenseBase::Random(Index,Index,const RandomStream&), setRandom()
+ */
+template <typename Derived>
+inline Derived& DenseBase<Derived>::setRandom(const RandomStream& stream) {
+  return *this = Random(rows(), cols(), stream);
+}
+
 /** Resizes to the given \a newSize, and sets all coefficients in this expression to random values.
  *
  * Numbers are uniformly spread through their whole definition range for integer types,
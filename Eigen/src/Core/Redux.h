@@ -416,6 +416,184 @@ class redux_evaluator : public internal::evaluator<XprType_> {
   }
 };
 
+// Combines values[0], ..., values[count - 1] pairwise along a balanced binary tree, such that the result only depends
+// on the number of values, and not on the order in which they have been computed.
+template <typename Func, typename Scalar>
+EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar pairwise_redux(const Func& func, Scalar* values, Index count) {
+  for (Index stride = 1; stride < count; stride *= 2)
+    for (Index i = 0; i + stride < count; i += 2 * stride) values[i] = func(values[i], values[i + stride]);
+  return values[0];
+}
+
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+
+/***************************************************************************
+ * Part 3b : fixed-shape reductions, see EIGEN_DETERMINISTIC_REDUCTIONS
+ *
+ * The values x_0, ..., x_{n-1} to be reduced are cut into leaves of LeafSize consecutive values. Within a leaf, x_k
+ * is accumulated into the lane k % Lanes, and the lanes are combined by pairwise_redux(). The results of the leaves
+ * are combined by pairwise_redux() as well. The shape of the whole tree thus only depends on n, and any aligned range
+ * of 2^l leaves is a subtree that can be reduced on its own, e.g., by another thread.
+ *
+ * For full reductions, the values are the coefficients in storage order, and the lanes are held by packets whenever
+ * the packet size divides the number of lanes. For vectorized partial reductions, every value is a packet of several
+ * reductions, whose lanes then follow the very same tree as the corresponding scalar reductions.
+ ***************************************************************************/
+
+struct deterministic_redux_shape {
+  enum { Lanes = 16, LeafSize = 1024 };
+  static Index leaves(Index size) { return numext::div_ceil(size, Index(LeafSize)); }
+};
+
+// Reduces the leaves [begin, end) given by leaf(i), where begin is a multiple of a power of two which is at least
+// end - begin. The reductions of the complete subtrees are kept on a stack, and combined as soon as two of them are
+// of the same size, which happens at the carries of a binary counter.
+template <typename T, typename Op, typename LeafFunc>
+T deterministic_redux_leaves(const Op& op, const LeafFunc& leaf, Index begin, Index end) {
+  T partials[8 * sizeof(Index)];
+  int top = 0;
+  for (Index i = begin; i < end; ++i) {
+    T value = leaf(i);
+    for (Index carry = i - begin; carry & 1; carry >>= 1) value = op(partials[--top], value);
+    partials[top++] = value;
+  }
+  T res = partials[--top];
+  while (top > 0) res = op(partials[--top], res);
+  return res;
+}
+
+// Reduces the values [begin, end) of a leaf. The values are read by get(k), which is called once per value, in
+// increasing order of k.
+template <typename T, typename Op, typename Getter>
+T deterministic_redux_lanes(const Op& op, const Getter& get, Index begin, Index end) {
+  enum { Lanes = deterministic_redux_shape::Lanes };
+  T lanes[Lanes];
+  const Index count = numext::mini<Index>(end - begin, Lanes);
+  for (Index l = 0; l < count; ++l) lanes[l] = get(begin + l);
+  Index k = begin + count;
+  for (; k + Lanes <= end; k += Lanes)
+    for (Index l = 0; l < Lanes; ++l) lanes[l] = op(lanes[l], get(k + l));
+  for (Index l = 0; k + l < end; ++l) lanes[l] = op(lanes[l], get(k + l));
+  return pairwise_redux(op, lanes, count);
+}
+
+template <typename Func>
+struct redux_packet_op {
+  template <typename Packet>
+  EIGEN_STRONG_INLINE Packet operator()(const Packet& a, const Packet& b) const {
+    return func.packetOp(a, b);
+  }
+  const Func& func;
+};
+
+// Reduces the coefficients [begin, end) of a leaf, in storage order.
+template <typename Func, typename Evaluator, bool Vectorize>
+struct deterministic_redux_leaf {
+  typedef typename Evaluator::Scalar Scalar;
+
+  static Scalar run(const Evaluator& eval, const Func& func, Index innerSize, Index begin, Index end) {
+    Index outer = begin / innerSize, inner = begin % innerSize;
+    auto next = [&](Index) {
+      const Scalar value = eval.coeffByOuterInner(outer, inner);
+      if (++inner == innerSize) {
+        inner = 0;
+        ++outer;
+      }
+      return value;
+    };
+    return deterministic_redux_lanes<Scalar>(func, next, begin, end);
+  }
+};
+
+// The lanes are held by Lanes / PacketSize packets, which yields the very same results as the scalar lanes above.
+template <typename Func, typename Evaluator>
+struct deterministic_redux_leaf<Func, Evaluator, true> {
+  typedef typename Evaluator::Scalar Scalar;
+  typedef typename redux_traits<Func, Evaluator>::PacketType PacketType;
+  enum {
+    Lanes = int(deterministic_redux_shape::Lanes),
+    PacketSize = int(redux_traits<Func, Evaluator>::PacketSize),
+    Packets = Lanes / PacketSize
+  };
+
+  // Loads the next Lanes coefficients, which are gathered if they span several outer vectors.
+  static EIGEN_STRONG_INLINE void load(const Evaluator& eval, Index innerSize, Index& outer, Index& inner,
+                                       PacketType* packets) {
+    if (inner + Lanes <= innerSize) {
+      for (int q = 0; q < Packets; ++q)
+        packets[q] = eval.template packetByOuterInner<Unaligned, PacketType>(outer, inner + q * PacketSize);
+      inner += Lanes;
+    } else {
+      Scalar values[Lanes];
+      for (int l = 0; l < Lanes; ++l) {
+        values[l] = eval.coeffByOuterInner(outer, inner);
+        if (++inner == innerSize) {
+          inner = 0;
+          ++outer;
+        }
+      }
+      for (int q = 0; q < Packets; ++q) packets[q] = ploadu<PacketType>(values + q * PacketSize);
+    }
+    if (inner == innerSize) {
+      inner = 0;
+      ++outer;
+    }
+  }
+
+  static Scalar run(const Evaluator& eval, const Func& func, Index innerSize, Index begin, Index end) {
+    if (end - begin < Lanes)
+      return deterministic_redux_leaf<Func, Evaluator, false>::run(eval, func, innerSize, begin, end);
+    Index outer = begin / innerSize, inner = begin % innerSize;
+    PacketType acc[Packets], packets[Packets];
+    load(eval, innerSize, outer, inner, acc);
+    Index k = begin + Lanes;
+    for (; k + Lanes <= end; k += Lanes) {
+      load(eval, innerSize, outer, inner, packets);
+      for (int q = 0; q < Packets; ++q) acc[q] = func.packetOp(acc[q], packets[q]);
+    }
+    Scalar lanes[Lanes];
+    for (int q = 0; q < Packets; ++q) pstoreu(lanes + q * PacketSize, acc[q]);
+    for (Index l = 0; k + l < end; ++l) {
+      lanes[l] = func(lanes[l], eval.coeffByOuterInner(outer, inner));
+      if (++inner == innerSize) {
+        inner = 0;
+        ++outer;
+      }
+    }
+    return pairwise_redux(func, lanes, Index(Lanes));
+  }
+};
+
+template <typename Func, typename Evaluator>
+struct deterministic_redux_impl {
+  typedef typename Evaluator::Scalar Scalar;
+  typedef deterministic_redux_leaf<Func, Evaluator,
+                                   bool(redux_traits<Func, Evaluator>::MightVectorize) &&
+                                       int(deterministic_redux_shape::Lanes) %
+                                               int(redux_traits<Func, Evaluator>::PacketSize) ==
+                                           0>
+      Leaf;
+
+  // Reduces the leaves [beginLeaf, endLeaf) of the coefficients of xpr.
+  template <typename XprType>
+  static Scalar run(const Evaluator& eval, const Func& func, const XprType& xpr, Index beginLeaf, Index endLeaf) {
+    const Index size = xpr.size(), innerSize = xpr.innerSize();
+    auto leaf = [&](Index i) {
+      const Index begin = i * Index(deterministic_redux_shape::LeafSize);
+      return Leaf::run(eval, func, innerSize, begin,
+                       numext::mini<Index>(begin + Index(deterministic_redux_shape::LeafSize), size));
+    };
+    return deterministic_redux_leaves<Scalar>(func, leaf, beginLeaf, endLeaf);
+  }
+
+  template <typename XprType>
+  static Scalar run(const Evaluator& eval, const Func& func, const XprType& xpr) {
+    return run(eval, func, xpr, 0, deterministic_redux_shape::leaves(xpr.size()));
+  }
+};
+
+#endif  // EIGEN_DETERMINISTIC_REDUCTIONS
+
 }  // end namespace internal
 
 /***************************************************************************
@@ -429,6 +607,10 @@ class redux_evaluator : public internal::evaluator<XprType_> {
  *
  * \warning the matrix must be not empty, otherwise an assertion is triggered.
  *
+ * \note If \c EIGEN_DETERMINISTIC_REDUCTIONS is defined, the coefficients are combined along a tree whose shape only
+ * depends on the number of coefficients, such that the result does not depend on the instruction set, nor on the
+ * number of threads of a CoreThreadPoolDevice.
+ *
  * \sa DenseBase::sum(), DenseBase::minCoeff(), DenseBase::maxCoeff(), MatrixBase::colwise(), MatrixBase::rowwise()
  */
 template <typename Derived>
@@ -442,7 +624,11 @@ EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE typename internal::traits<Derived>::Scalar
 
   // The initial expression is passed to the reducer as an additional argument instead of
   // passing it as a member of redux_evaluator to help
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+  return internal::deterministic_redux_impl<Func, ThisEvaluator>::run(thisEval, func, derived());
+#else
   return internal::redux_impl<Func, ThisEvaluator>::run(thisEval, func, derived());
+#endif
 }
 
 /** \returns the minimum of all coefficients of \c *this.
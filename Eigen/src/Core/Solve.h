@@ -112,6 +112,7 @@ struct evaluator<Solve<Decomposition, RhsType> >
 
   EIGEN_DEVICE_FUNC explicit evaluator(const SolveType &solve) : m_result(solve.rows(), solve.cols()) {
     internal::construct_at<Base>(this, m_result);
+    EIGEN_INSTRUMENTED_REGION("solve");
     solve.dec()._solve_impl(solve.rhs(), m_result);
   }
 
@@ -130,6 +131,7 @@ struct Assignment<DstXprType, Solve<DecType, RhsType>, internal::assign_op<Scala
     Index dstCols = src.cols();
     if ((dst.rows() != dstRows) || (dst.cols() != dstCols)) dst.resize(dstRows, dstCols);
 
+    EIGEN_INSTRUMENTED_REGION("solve");
     src.dec()._solve_impl(src.rhs(), dst);
   }
 };
@@ -144,6 +146,7 @@ struct Assignment<DstXprType, Solve<Transpose<const DecType>, RhsType>, internal
     Index dstCols = src.cols();
     if ((dst.rows() != dstRows) || (dst.cols() != dstCols)) dst.resize(dstRows, dstCols);
 
+    EIGEN_INSTRUMENTED_REGION("solve");
     src.dec().nestedExpression().template _solve_impl_transposed<false>(src.rhs(), dst);
   }
 };
@@ -163,6 +166,7 @@ struct Assignment<
     Index dstCols = src.cols();
     if ((dst.rows() != dstRows) || (dst.cols() != dstCols)) dst.resize(dstRows, dstCols);
 
+    EIGEN_INSTRUMENTED_REGION("solve");
     src.dec().nestedExpression().nestedExpression().template _solve_impl_transposed<true>(src.rhs(), dst);
   }
 };
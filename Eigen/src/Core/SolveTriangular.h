@@ -18,13 +18,22 @@ namespace Eigen {
 namespace internal {
 
 // Forward declarations:
-// The following two routines are implemented in the products/TriangularSolver*.h files
+// The following routines are implemented in the products/TriangularSolver*.h files
 template <typename LhsScalar, typename RhsScalar, typename Index, int Side, int Mode, bool Conjugate, int StorageOrder>
 struct triangular_solve_vector;
 
+template <typename LhsScalar, typename RhsScalar, typename Index, int Side, int Mode, bool Conjugate, int StorageOrder>
+struct parallel_triangular_solve_vector;
+
+inline namespace EIGEN_KERNEL_NAMESPACE {
 template <typename Scalar, typename Index, int Side, int Mode, bool Conjugate, int TriStorageOrder,
           int OtherStorageOrder, int OtherInnerStride>
 struct triangular_solve_matrix;
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
+
+template <typename Scalar, typename Index, int Side, int Mode, bool Conjugate, int TriStorageOrder,
+          int OtherStorageOrder, int OtherInnerStride>
+struct parallel_triangular_solve_matrix;
 
 // small helper struct extracting some traits on the underlying solver operation
 template <typename Lhs, typename Rhs, int Side>
@@ -66,11 +75,10 @@ struct triangular_solver_selector<Lhs, Rhs, Side, Mode, NoUnrolling, 1> {
 
     if (!useRhsDirectly) MappedRhs(actualRhs, rhs.size()) = rhs;
 
-    triangular_solve_vector<LhsScalar, RhsScalar, Index, Side, Mode, LhsProductTraits::NeedToConjugate,
-                            (int(Lhs::Flags) & RowMajorBit) ? RowMajor : ColMajor>::run(actualLhs.cols(),
-                                                                                        actualLhs.data(),
-                                                                                        actualLhs.outerStride(),
-                                                                                        actualRhs);
+    enum { StorageOrder = (int(Lhs::Flags) & RowMajorBit) ? RowMajor : ColMajor };
+    parallel_triangular_solve_vector<LhsScalar, RhsScalar, Index, Side, Mode, LhsProductTraits::NeedToConjugate,
+                                     StorageOrder>::run(actualLhs.cols(), actualLhs.data(), actualLhs.outerStride(),
+                                                        actualRhs);
 
     if (!useRhsDirectly) rhs = MappedRhs(actualRhs, rhs.size());
   }
@@ -101,12 +109,13 @@ struct triangular_solver_selector<Lhs, Rhs, Side, Mode, NoUnrolling, Dynamic> {
 
     BlockingType blocking(rhs.rows(), rhs.cols(), size, 1, false);
 
-    triangular_solve_matrix<Scalar, Index, Side, Mode, LhsProductTraits::NeedToConjugate,
-                            (int(Lhs::Flags) & RowMajorBit) ? RowMajor : ColMajor,
-                            (Rhs::Flags & RowMajorBit) ? RowMajor : ColMajor,
-                            Rhs::InnerStrideAtCompileTime>::run(size, othersize, &actualLhs.coeffRef(0, 0),
-                                                                actualLhs.outerStride(), &rhs.coeffRef(0, 0),
-                                                                rhs.innerStride(), rhs.outerStride(), blocking);
+    parallel_triangular_solve_matrix<Scalar, Index, Side, Mode, LhsProductTraits::NeedToConjugate,
+                                     (int(Lhs::Flags) & RowMajorBit) ? RowMajor : ColMajor,
+                                     (Rhs::Flags & RowMajorBit) ? RowMajor : ColMajor,
+                                     Rhs::InnerStrideAtCompileTime>::run(size, othersize, &actualLhs.coeffRef(0, 0),
+                                                                         actualLhs.outerStride(), &rhs.coeffRef(0, 0),
+                                                                         rhs.innerStride(), rhs.outerStride(),
+                                                                         blocking);
   }
 };
 
@@ -403,154 +403,200 @@ struct coeff_visitor {
   }
 };
 
-template <typename Scalar, int NaNPropagation, bool is_min = true>
-struct minmax_compare {
+// Orders the candidates of the min and max visitors: better(a, b) is true if a must replace b when it comes after it.
+// Default implementation used by non-floating types, where we do not need special logic for NaN handling.
+template <typename Scalar, bool is_min, int NaNPropagation, bool isInt = NumTraits<Scalar>::IsInteger>
+struct minmax_coeff_order {
   typedef typename packet_traits<Scalar>::type Packet;
-  static EIGEN_DEVICE_FUNC inline bool compare(Scalar a, Scalar b) { return a < b; }
-  static EIGEN_DEVICE_FUNC inline Scalar predux(const Packet& p) { return predux_min<NaNPropagation>(p); }
+  static EIGEN_DEVICE_FUNC inline bool better(const Scalar& a, const Scalar& b) { return is_min ? a < b : b < a; }
+  static EIGEN_DEVICE_FUNC inline Packet pbetter(const Packet& a, const Packet& b) {
+    return is_min ? pcmp_lt(a, b) : pcmp_lt(b, a);
+  }
 };
 
-template <typename Scalar, int NaNPropagation>
-struct minmax_compare<Scalar, NaNPropagation, false> {
+// Suppress NaN. The only case in which we return NaN is if the matrix is all NaN,
+// in which case, row=0, col=0 is returned for the location.
+template <typename Scalar, bool is_min>
+struct minmax_coeff_order<Scalar, is_min, PropagateNumbers, false> {
   typedef typename packet_traits<Scalar>::type Packet;
-  static EIGEN_DEVICE_FUNC inline bool compare(Scalar a, Scalar b) { return a > b; }
-  static EIGEN_DEVICE_FUNC inline Scalar predux(const Packet& p) { return predux_max<NaNPropagation>(p); }
+  typedef minmax_coeff_order<Scalar, is_min, PropagateNumbers, true> Numbers;
+  static EIGEN_DEVICE_FUNC inline bool better(const Scalar& a, const Scalar& b) {
+    return (!(numext::isnan)(a) && (numext::isnan)(b)) || Numbers::better(a, b);
+  }
+  static EIGEN_DEVICE_FUNC inline Packet pbetter(const Packet& a, const Packet& b) {
+    return por(pandnot(pcmp_eq(a, a), pcmp_eq(b, b)), Numbers::pbetter(a, b));
+  }
 };
 
-// Default implementation used by non-floating types, where we do not
-// need special logic for NaN handling.
-template <typename Derived, bool is_min, int NaNPropagation,
-          bool isInt = NumTraits<typename Derived::Scalar>::IsInteger>
-struct minmax_coeff_visitor : coeff_visitor<Derived> {
-  using Scalar = typename Derived::Scalar;
-  using Packet = typename packet_traits<Scalar>::type;
-  using Comparator = minmax_compare<Scalar, NaNPropagation, is_min>;
-  static constexpr Index PacketSize = packet_traits<Scalar>::size;
-
-  EIGEN_DEVICE_FUNC inline void operator()(const Scalar& value, Index i, Index j) {
-    if (Comparator::compare(value, this->res)) {
-      this->res = value;
-      this->row = i;
-      this->col = j;
-    }
-  }
-  EIGEN_DEVICE_FUNC inline void packet(const Packet& p, Index i, Index j) {
-    Scalar value = Comparator::predux(p);
-    if (Comparator::compare(value, this->res)) {
-      const Packet range = preverse(plset<Packet>(Scalar(1)));
-      Packet mask = pcmp_eq(pset1<Packet>(value), p);
-      Index max_idx = PacketSize - static_cast<Index>(predux_max(pand(range, mask)));
-      this->res = value;
-      this->row = Derived::IsRowMajor ? i : i + max_idx;
-      this->col = Derived::IsRowMajor ? j + max_idx : j;
-    }
+// Propagate NaNs. If the matrix contains NaN, the location of the first NaN
+// will be returned in row and col.
+template <typename Scalar, bool is_min, int NaNPropagation>
+struct minmax_coeff_order<Scalar, is_min, NaNPropagation, false> {
+  typedef typename packet_traits<Scalar>::type Packet;
+  typedef minmax_coeff_order<Scalar, is_min, NaNPropagation, true> Numbers;
+  static EIGEN_DEVICE_FUNC inline bool better(const Scalar& a, const Scalar& b) {
+    return ((numext::isnan)(a) && !(numext::isnan)(b)) || Numbers::better(a, b);
   }
-  EIGEN_DEVICE_FUNC inline void initpacket(const Packet& p, Index i, Index j) {
-    Scalar value = Comparator::predux(p);
-    const Packet range = preverse(plset<Packet>(Scalar(1)));
-    Packet mask = pcmp_eq(pset1<Packet>(value), p);
-    Index max_idx = PacketSize - static_cast<Index>(predux_max(pand(range, mask)));
-    this->res = value;
-    this->row = Derived::IsRowMajor ? i : i + max_idx;
-    this->col = Derived::IsRowMajor ? j + max_idx : j;
+  static EIGEN_DEVICE_FUNC inline Packet pbetter(const Packet& a, const Packet& b) {
+    return por(pandnot(pcmp_eq(b, b), pcmp_eq(a, a)), Numbers::pbetter(a, b));
   }
 };
 
-// Suppress NaN. The only case in which we return NaN is if the matrix is all NaN,
-// in which case, row=0, col=0 is returned for the location.
-template <typename Derived, bool is_min>
-struct minmax_coeff_visitor<Derived, is_min, PropagateNumbers, false> : coeff_visitor<Derived> {
-  typedef typename Derived::Scalar Scalar;
+// The packets are reduced lane-wise: each lane keeps its best coefficient along with the ordinal of the packet it
+// comes from, both being blended with the comparison mask. The lanes are only reduced to a single location when the
+// packets stop being contiguous, i.e., at the end of an inner vector, before a scalar coefficient, and at the end of
+// the traversal, see finish(). The ordinals are stored as Scalar, which represents them exactly below MaxPackets.
+template <typename Derived, bool is_min, int NaNPropagation>
+struct minmax_coeff_visitor : coeff_visitor<Derived> {
+  using Scalar = typename Derived::Scalar;
   using Packet = typename packet_traits<Scalar>::type;
-  using Comparator = minmax_compare<Scalar, PropagateNumbers, is_min>;
+  using Order = minmax_coeff_order<Scalar, is_min, NaNPropagation>;
+  static constexpr int PacketSize = packet_traits<Scalar>::size;
+  static constexpr bool IsRowMajor = Derived::IsRowMajor;
+  static constexpr Index MaxPackets = Index(1) << (std::numeric_limits<Scalar>::digits < 30
+                                                       ? std::numeric_limits<Scalar>::digits
+                                                       : 30);
+
+  EIGEN_DEVICE_FUNC minmax_coeff_visitor()
+      : m_best(pset1<Packet>(Scalar(0))),
+        m_bestOrdinals(m_best),
+        m_ordinals(m_best),
+        m_outer(0),
+        m_inner(0),
+        m_next(0),
+        m_pending(false) {}
 
   EIGEN_DEVICE_FUNC inline void operator()(const Scalar& value, Index i, Index j) {
-    if ((!(numext::isnan)(value) && (numext::isnan)(this->res)) || Comparator::compare(value, this->res)) {
+    if (m_pending) finish();
+    if (Order::better(value, this->res)) {
       this->res = value;
       this->row = i;
       this->col = j;
     }
   }
   EIGEN_DEVICE_FUNC inline void packet(const Packet& p, Index i, Index j) {
-    const Index PacketSize = packet_traits<Scalar>::size;
-    Scalar value = Comparator::predux(p);
-    if ((!(numext::isnan)(value) && (numext::isnan)(this->res)) || Comparator::compare(value, this->res)) {
-      const Packet range = preverse(plset<Packet>(Scalar(1)));
-      /* mask will be zero for NaNs, so they will be ignored. */
-      Packet mask = pcmp_eq(pset1<Packet>(value), p);
-      Index max_idx = PacketSize - static_cast<Index>(predux_max(pand(range, mask)));
-      this->res = value;
-      this->row = Derived::IsRowMajor ? i : i + max_idx;
-      this->col = Derived::IsRowMajor ? j + max_idx : j;
+    const Index outer = IsRowMajor ? i : j, inner = IsRowMajor ? j : i;
+    if (m_pending && outer == m_outer && inner == m_next && m_next - m_inner < MaxPackets * PacketSize) {
+      m_ordinals = padd(m_ordinals, pset1<Packet>(Scalar(1)));
+      const Packet mask = Order::pbetter(p, m_best);
+      m_best = pselect(mask, p, m_best);
+      m_bestOrdinals = pselect(mask, m_ordinals, m_bestOrdinals);
+      m_next += PacketSize;
+    } else {
+      if (m_pending) finish();
+      start(p, outer, inner);
     }
   }
   EIGEN_DEVICE_FUNC inline void initpacket(const Packet& p, Index i, Index j) {
-    const Index PacketSize = packet_traits<Scalar>::size;
-    Scalar value = Comparator::predux(p);
-    if ((numext::isnan)(value)) {
-      this->res = value;
-      this->row = 0;
-      this->col = 0;
-      return;
+    this->init(pfirst(p), i, j);
+    start(p, IsRowMajor ? i : j, IsRowMajor ? j : i);
+  }
+
+  // Reduces the pending lanes into res, row and col.
+  EIGEN_DEVICE_FUNC inline void finish() {
+    if (!m_pending) return;
+    m_pending = false;
+    Scalar values[PacketSize], ordinals[PacketSize];
+    pstoreu(values, m_best);
+    pstoreu(ordinals, m_bestOrdinals);
+    // offset of the best coefficient from the first packet, the first one wins ties
+    Index lane = 0, offset = cast<Scalar, Index>(ordinals[0]) * PacketSize;
+    for (Index k = 1; k < PacketSize; ++k) {
+      const Index k_offset = cast<Scalar, Index>(ordinals[k]) * PacketSize + k;
+      if (Order::better(values[k], values[lane]) || (!Order::better(values[lane], values[k]) && k_offset < offset)) {
+        lane = k;
+        offset = k_offset;
+      }
+    }
+    if (Order::better(values[lane], this->res)) {
+      this->res = values[lane];
+      this->row = IsRowMajor ? m_outer : m_inner + offset;
+      this->col = IsRowMajor ? m_inner + offset : m_outer;
     }
-    const Packet range = preverse(plset<Packet>(Scalar(1)));
-    /* mask will be zero for NaNs, so they will be ignored. */
-    Packet mask = pcmp_eq(pset1<Packet>(value), p);
-    Index max_idx = PacketSize - static_cast<Index>(predux_max(pand(range, mask)));
-    this->res = value;
-    this->row = Derived::IsRowMajor ? i : i + max_idx;
-    this->col = Derived::IsRowMajor ? j + max_idx : j;
   }
+
+ private:
+  EIGEN_DEVICE_FUNC inline void start(const Packet& p, Index outer, Index inner) {
+    m_best = p;
+    m_ordinals = m_bestOrdinals = pset1<Packet>(Scalar(0));
+    m_outer = outer;
+    m_inner = inner;
+    m_next = inner + PacketSize;
+    m_pending = true;
+  }
+
+  Packet m_best, m_bestOrdinals, m_ordinals;
+  Index m_outer, m_inner, m_next;
+  bool m_pending;
 };
 
-// Propagate NaNs. If the matrix contains NaN, the location of the first NaN
-// will be returned in row and col.
 template <typename Derived, bool is_min, int NaNPropagation>
-struct minmax_coeff_visitor<Derived, is_min, NaNPropagation, false> : coeff_visitor<Derived> {
-  typedef typename Derived::Scalar Scalar;
-  using Packet = typename packet_traits<Scalar>::type;
-  using Comparator = minmax_compare<Scalar, PropagateNaN, is_min>;
+struct functor_traits<minmax_coeff_visitor<Derived, is_min, NaNPropagation>> {
+  using Scalar = typename Derived::Scalar;
+  enum { Cost = NumTraits<Scalar>::AddCost, LinearAccess = false, PacketAccess = packet_traits<Scalar>::HasCmp };
+};
 
-  EIGEN_DEVICE_FUNC inline void operator()(const Scalar& value, Index i, Index j) {
-    const bool value_is_nan = (numext::isnan)(value);
-    if ((value_is_nan && !(numext::isnan)(this->res)) || Comparator::compare(value, this->res)) {
-      this->res = value;
-      this->row = i;
-      this->col = j;
+// Keeps the k largest coefficients in a heap whose top is the smallest of them, the first ones in the traversal
+// order winning ties. NaNs are ignored. A packet is only unpacked if one of its coefficients beats the top of the heap.
+template <typename Derived>
+struct topk_coeff_visitor {
+  using Scalar = typename Derived::Scalar;
+  using Packet = typename packet_traits<Scalar>::type;
+  static constexpr int PacketSize = packet_traits<Scalar>::size;
+  // a coefficient and its position in the traversal order
+  typedef std::pair<Scalar, Index> Entry;
+
+  explicit topk_coeff_visitor(Index k) : m_k(k), m_position(0) { m_heap.reserve(k); }
+
+  inline void init(const Scalar& value, Index, Index) { push(value); }
+  inline void init(const Scalar& value, Index) { push(value); }
+  inline void operator()(const Scalar& value, Index, Index) { push(value); }
+  inline void operator()(const Scalar& value, Index) { push(value); }
+  inline void initpacket(const Packet& p, Index, Index) { pushpacket(p); }
+  inline void initpacket(const Packet& p, Index) { pushpacket(p); }
+  inline void packet(const Packet& p, Index, Index) { pushpacket(p); }
+  inline void packet(const Packet& p, Index) { pushpacket(p); }
+
+  // Sorts the heap, from the largest coefficient to the smallest one.
+  inline const std::vector<Entry>& finish() {
+    std::sort_heap(m_heap.begin(), m_heap.end(), better);
+    return m_heap;
+  }
+
+ private:
+  static inline bool better(const Entry& a, const Entry& b) {
+    return b.first < a.first || (!(a.first < b.first) && a.second < b.second);
+  }
+  inline void push(const Scalar& value) {
+    const Index position = m_position++;
+    if ((numext::isnan)(value) || m_k == 0) return;
+    if (Index(m_heap.size()) < m_k) {
+      m_heap.emplace_back(value, position);
+      std::push_heap(m_heap.begin(), m_heap.end(), better);
+    } else if (m_heap.front().first < value) {
+      std::pop_heap(m_heap.begin(), m_heap.end(), better);
+      m_heap.back() = Entry(value, position);
+      std::push_heap(m_heap.begin(), m_heap.end(), better);
     }
   }
-  EIGEN_DEVICE_FUNC inline void packet(const Packet& p, Index i, Index j) {
-    const Index PacketSize = packet_traits<Scalar>::size;
-    Scalar value = Comparator::predux(p);
-    const bool value_is_nan = (numext::isnan)(value);
-    if ((value_is_nan && !(numext::isnan)(this->res)) || Comparator::compare(value, this->res)) {
-      const Packet range = preverse(plset<Packet>(Scalar(1)));
-      // If the value is NaN, pick the first position of a NaN, otherwise pick the first extremal value.
-      Packet mask = value_is_nan ? pnot(pcmp_eq(p, p)) : pcmp_eq(pset1<Packet>(value), p);
-      Index max_idx = PacketSize - static_cast<Index>(predux_max(pand(range, mask)));
-      this->res = value;
-      this->row = Derived::IsRowMajor ? i : i + max_idx;
-      this->col = Derived::IsRowMajor ? j + max_idx : j;
+  inline void pushpacket(const Packet& p) {
+    if (m_k > 0 && Index(m_heap.size()) == m_k && !predux_any(pcmp_lt(pset1<Packet>(m_heap.front().first), p))) {
+      m_position += PacketSize;
+      return;
     }
+    Scalar values[PacketSize];
+    pstoreu(values, p);
+    for (int k = 0; k < PacketSize; ++k) push(values[k]);
   }
-  EIGEN_DEVICE_FUNC inline void initpacket(const Packet& p, Index i, Index j) {
-    const Index PacketSize = packet_traits<Scalar>::size;
-    Scalar value = Comparator::predux(p);
-    const bool value_is_nan = (numext::isnan)(value);
-    const Packet range = preverse(plset<Packet>(Scalar(1)));
-    // If the value is NaN, pick the first position of a NaN, otherwise pick the first extremal value.
-    Packet mask = value_is_nan ? pnot(pcmp_eq(p, p)) : pcmp_eq(pset1<Packet>(value), p);
-    Index max_idx = PacketSize - static_cast<Index>(predux_max(pand(range, mask)));
-    this->res = value;
-    this->row = Derived::IsRowMajor ? i : i + max_idx;
-    this->col = Derived::IsRowMajor ? j + max_idx : j;
-  }
+
+  std::vector<Entry> m_heap;
+  Index m_k, m_position;
 };
 
-template <typename Derived, bool is_min, int NaNPropagation>
-struct functor_traits<minmax_coeff_visitor<Derived, is_min, NaNPropagation>> {
+template <typename Derived>
+struct functor_traits<topk_coeff_visitor<Derived>> {
   using Scalar = typename Derived::Scalar;
-  enum { Cost = NumTraits<Scalar>::AddCost, LinearAccess = false, PacketAccess = packet_traits<Scalar>::HasCmp };
+  enum { Cost = 2 * NumTraits<Scalar>::AddCost, LinearAccess = true, PacketAccess = packet_traits<Scalar>::HasCmp };
 };
 
 template <typename Scalar>
@@ -653,6 +699,7 @@ EIGEN_DEVICE_FUNC typename internal::traits<Derived>::Scalar DenseBase<Derived>:
 
   internal::minmax_coeff_visitor<Derived, true, NaNPropagation> minVisitor;
   this->visit(minVisitor);
+  minVisitor.finish();
   *rowId = minVisitor.row;
   if (colId) *colId = minVisitor.col;
   return minVisitor.res;
@@ -677,6 +724,7 @@ EIGEN_DEVICE_FUNC typename internal::traits<Derived>::Scalar DenseBase<Derived>:
 
   internal::minmax_coeff_visitor<Derived, true, NaNPropagation> minVisitor;
   this->visit(minVisitor);
+  minVisitor.finish();
   *index = IndexType((RowsAtCompileTime == 1) ? minVisitor.col : minVisitor.row);
   return minVisitor.res;
 }
@@ -700,6 +748,7 @@ EIGEN_DEVICE_FUNC typename internal::traits<Derived>::Scalar DenseBase<Derived>:
 
   internal::minmax_coeff_visitor<Derived, false, NaNPropagation> maxVisitor;
   this->visit(maxVisitor);
+  maxVisitor.finish();
   *rowPtr = maxVisitor.row;
   if (colPtr) *colPtr = maxVisitor.col;
   return maxVisitor.res;
@@ -724,10 +773,66 @@ EIGEN_DEVICE_FUNC typename internal::traits<Derived>::Scalar DenseBase<Derived>:
   EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
   internal::minmax_coeff_visitor<Derived, false, NaNPropagation> maxVisitor;
   this->visit(maxVisitor);
+  maxVisitor.finish();
   *index = (RowsAtCompileTime == 1) ? maxVisitor.col : maxVisitor.row;
   return maxVisitor.res;
 }
 
+/** Puts in \a values the \a k largest coefficients of *this, sorted by decreasing values, and in \a rows and \a cols
+ * their locations. Equal coefficients are sorted in the storage order of *this.
+ *
+ * NaN coefficients are ignored, so that fewer than \a k coefficients are returned if *this has fewer than \a k
+ * numbers. The vectors \a values, \a rows and \a cols are resized to the number of returned coefficients.
+ *
+ * The coefficients are visited once, and the vectorized path only unpacks the packets holding one of the largest
+ * coefficients found so far.
+ *
+ * \sa maxCoeffs(Index,ValuesType&,IndicesType&), maxCoeff(IndexType*,IndexType*), DenseBase::visit()
+ */
+template <typename Derived>
+template <typename ValuesType, typename IndicesType>
+void DenseBase<Derived>::maxCoeffs(Index k, ValuesType& values, IndicesType& rows, IndicesType& cols) const {
+  eigen_assert(k >= 0 && "k must be nonnegative");
+  internal::topk_coeff_visitor<Derived> visitor(numext::mini(k, size()));
+  this->visit(visitor);
+  const auto& entries = visitor.finish();
+  const Index count = static_cast<Index>(entries.size());
+  values.resize(count);
+  rows.resize(count);
+  cols.resize(count);
+  for (Index i = 0; i < count; ++i) {
+    const Index position = entries[i].second;
+    values(i) = entries[i].first;
+    rows(i) = static_cast<typename IndicesType::Scalar>(IsRowMajor ? position / this->cols() : position % this->rows());
+    cols(i) = static_cast<typename IndicesType::Scalar>(IsRowMajor ? position % this->cols() : position / this->rows());
+  }
+}
+
+/** Puts in \a values the \a k largest coefficients of *this, sorted by decreasing values, and in \a indices their
+ * indices. Equal coefficients are sorted by increasing indices.
+ *
+ * NaN coefficients are ignored, so that fewer than \a k coefficients are returned if *this has fewer than \a k
+ * numbers. The vectors \a values and \a indices are resized to the number of returned coefficients.
+ *
+ * \sa maxCoeffs(Index,ValuesType&,IndicesType&,IndicesType&), maxCoeff(IndexType*)
+ */
+template <typename Derived>
+template <typename ValuesType, typename IndicesType>
+void DenseBase<Derived>::maxCoeffs(Index k, ValuesType& values, IndicesType& indices) const {
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+  eigen_assert(k >= 0 && "k must be nonnegative");
+  internal::topk_coeff_visitor<Derived> visitor(numext::mini(k, size()));
+  this->visit(visitor);
+  const auto& entries = visitor.finish();
+  const Index count = static_cast<Index>(entries.size());
+  values.resize(count);
+  indices.resize(count);
+  for (Index i = 0; i < count; ++i) {
+    values(i) = entries[i].first;
+    indices(i) = static_cast<typename IndicesType::Scalar>(entries[i].second);
+  }
+}
+
 /** \returns true if all coefficients are true
  *
  * Example: \include MatrixBase_all.cpp
@@ -22,8 +22,13 @@
 #include "../../InternalHeaderCheck.h"
 
 #if !defined(EIGEN_USE_AVX512_GEMM_KERNELS)
+// The deterministic mode relies on the accumulation order of the generic gebp kernel.
+#if defined(EIGEN_DETERMINISTIC_REDUCTIONS)
+#define EIGEN_USE_AVX512_GEMM_KERNELS 0
+#else
 #define EIGEN_USE_AVX512_GEMM_KERNELS 1
 #endif
+#endif
 
 #define SECOND_FETCH (32)
 #if (EIGEN_COMP_GNUC_STRICT != 0) && !defined(EIGEN_ARCH_AVX512_GEMM_KERNEL_USE_LESS_A_REGS)
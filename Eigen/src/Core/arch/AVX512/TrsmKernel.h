@@ -1062,9 +1062,11 @@ void triSolve(Scalar *A_arr, Scalar *B_arr, int64_t M, int64_t numRHS, int64_t L
 // Template specializations of trsmKernelL/R for float/double and inner strides of 1.
 #if (EIGEN_USE_AVX512_TRSM_KERNELS)
 #if (EIGEN_USE_AVX512_TRSM_R_KERNELS)
+inline namespace EIGEN_KERNEL_NAMESPACE {
 template <typename Scalar, typename Index, int Mode, bool Conjugate, int TriStorageOrder, int OtherInnerStride,
           bool Specialized>
 struct trsmKernelR;
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
 
 template <typename Index, int Mode, int TriStorageOrder>
 struct trsmKernelR<float, Index, Mode, false, TriStorageOrder, 1, true> {
@@ -1113,9 +1115,11 @@ EIGEN_DONT_INLINE void trsmKernelR<double, Index, Mode, false, TriStorageOrder,
 
 // These trsm kernels require temporary memory allocation
 #if (EIGEN_USE_AVX512_TRSM_L_KERNELS)
+inline namespace EIGEN_KERNEL_NAMESPACE {
 template <typename Scalar, typename Index, int Mode, bool Conjugate, int TriStorageOrder, int OtherInnerStride,
           bool Specialized = true>
 struct trsmKernelL;
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
 
 template <typename Index, int Mode, int TriStorageOrder>
 struct trsmKernelL<float, Index, Mode, false, TriStorageOrder, 1, true> {
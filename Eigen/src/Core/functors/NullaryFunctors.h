@@ -241,19 +241,6 @@ template <typename Scalar, typename IndexType>
 struct has_binary_operator<linspaced_op<Scalar>, IndexType> {
   enum { value = 0 };
 };
-
-template <typename Scalar, typename IndexType>
-struct has_nullary_operator<scalar_random_op<Scalar>, IndexType> {
-  enum { value = 1 };
-};
-template <typename Scalar, typename IndexType>
-struct has_unary_operator<scalar_random_op<Scalar>, IndexType> {
-  enum { value = 0 };
-};
-template <typename Scalar, typename IndexType>
-struct has_binary_operator<scalar_random_op<Scalar>, IndexType> {
-  enum { value = 0 };
-};
 #endif
 
 }  // end namespace internal
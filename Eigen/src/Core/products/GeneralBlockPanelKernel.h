@@ -102,6 +102,8 @@ inline void manage_caching_sizes(Action action, std::ptrdiff_t* l1, std::ptrdiff
   }
 }
 
+inline namespace EIGEN_KERNEL_NAMESPACE {
+
 /* Helper for computeProductBlockingSizes.
  *
  * Given a m x k times k x n matrix product of scalar types \c LhsScalar and \c RhsScalar,
@@ -283,6 +285,8 @@ void evaluateProductBlockingSizesHeuristic(Index& k, Index& m, Index& n, Index n
   }
 }
 
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
+
 template <typename Index>
 inline bool useSpecificBlockingSizes(Index& k, Index& m, Index& n) {
 #ifdef EIGEN_TEST_SPECIFIC_BLOCKING_SIZES
@@ -300,6 +304,72 @@ inline bool useSpecificBlockingSizes(Index& k, Index& m, Index& n) {
   return false;
 }
 
+/* Blocking sizes of the general matrix-matrix products tuned on the host, see setTunedBlockingSizes().
+ *
+ * The products are gathered per scalar type and per shape class, where a shape class is made of the products whose
+ * depth, rows and columns have the same powers of two rounded down, clamped between 16 and 2048. An entry whose kc
+ * is zero has not been tuned. */
+struct blocking_sizes_tuning {
+  enum { NumScalars = 4, MinLog2Size = 4, MaxLog2Size = 11, NumShapeClasses = MaxLog2Size - MinLog2Size + 1 };
+
+  bool enabled;
+  int sizes[NumScalars][NumShapeClasses][NumShapeClasses][NumShapeClasses][3];
+
+  static int shape_class(std::ptrdiff_t size) {
+    int log2_size = 0;
+    while (size >>= 1) ++log2_size;
+    return numext::mini<int>(numext::maxi<int>(log2_size, MinLog2Size), MaxLog2Size) - MinLog2Size;
+  }
+
+  int* entry(int scalar, std::ptrdiff_t k, std::ptrdiff_t m, std::ptrdiff_t n) {
+    return sizes[scalar][shape_class(k)][shape_class(m)][shape_class(n)];
+  }
+};
+
+/** \internal Being zero-initialized, the table is available before any dynamic initialization takes place. */
+inline blocking_sizes_tuning& blocking_sizes_tuning_table() {
+  static blocking_sizes_tuning table;
+  return table;
+}
+
+template <typename LhsScalar, typename RhsScalar>
+struct blocking_sizes_tuning_scalar {
+  enum { value = -1 };
+};
+template <>
+struct blocking_sizes_tuning_scalar<float, float> {
+  enum { value = 0 };
+};
+template <>
+struct blocking_sizes_tuning_scalar<double, double> {
+  enum { value = 1 };
+};
+template <>
+struct blocking_sizes_tuning_scalar<std::complex<float>, std::complex<float> > {
+  enum { value = 2 };
+};
+template <>
+struct blocking_sizes_tuning_scalar<std::complex<double>, std::complex<double> > {
+  enum { value = 3 };
+};
+
+template <typename LhsScalar, typename RhsScalar, int KcFactor, typename Index>
+inline bool useTunedBlockingSizes(Index& k, Index& m, Index& n, Index num_threads) {
+  enum { ScalarId = blocking_sizes_tuning_scalar<LhsScalar, RhsScalar>::value };
+  // The sizes are tuned for the single threaded general matrix-matrix products only.
+  if (ScalarId < 0 || KcFactor != 1 || num_threads != 1) return false;
+  blocking_sizes_tuning& tuning = blocking_sizes_tuning_table();
+  if (!tuning.enabled) return false;
+  const int* sizes = tuning.entry(ScalarId < 0 ? 0 : int(ScalarId), k, m, n);
+  if (sizes[0] == 0) return false;
+  k = numext::mini<Index>(k, sizes[0]);
+  m = numext::mini<Index>(m, sizes[1]);
+  n = numext::mini<Index>(n, sizes[2]);
+  return true;
+}
+
+inline namespace EIGEN_KERNEL_NAMESPACE {
+
 /** \brief Computes the blocking parameters for a m x k times k x n matrix product
  *
  * \param[in,out] k Input: the third dimension of the product. Output: the blocking size along the same dimension.
@@ -313,15 +383,27 @@ inline bool useSpecificBlockingSizes(Index& k, Index& m, Index& n) {
  *
  * The blocking size parameters may be evaluated:
  *   - either by a heuristic based on cache sizes;
+ *   - or using the sizes tuned on the host for the shape of the product (see setTunedBlockingSizes());
  *   - or using fixed prescribed values (for testing purposes).
  *
+ * If \c EIGEN_DETERMINISTIC_REDUCTIONS is defined, the blocking size along the depth is fixed to 256.
+ *
  * \sa setCpuCacheSizes */
 
 template <typename LhsScalar, typename RhsScalar, int KcFactor, typename Index>
 void computeProductBlockingSizes(Index& k, Index& m, Index& n, Index num_threads = 1) {
-  if (!useSpecificBlockingSizes(k, m, n)) {
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+  // The blocking along the depth fixes the order in which the products are accumulated into the result, so that it
+  // must not depend on the number of threads, nor on the cache sizes.
+  const Index kc = numext::mini<Index>(k, 256);
+  evaluateProductBlockingSizesHeuristic<LhsScalar, RhsScalar, KcFactor, Index>(k, m, n, num_threads);
+  k = kc;
+#else
+  if (!useSpecificBlockingSizes(k, m, n) &&
+      !useTunedBlockingSizes<LhsScalar, RhsScalar, KcFactor>(k, m, n, num_threads)) {
     evaluateProductBlockingSizesHeuristic<LhsScalar, RhsScalar, KcFactor, Index>(k, m, n, num_threads);
   }
+#endif
 }
 
 template <typename LhsScalar, typename RhsScalar, typename Index>
@@ -329,6 +411,8 @@ inline void computeProductBlockingSizes(Index& k, Index& m, Index& n, Index num_
   computeProductBlockingSizes<LhsScalar, RhsScalar, 1, Index>(k, m, n, num_threads);
 }
 
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
+
 template <typename RhsPacket, typename RhsPacketx4, int registers_taken>
 struct RhsPanelHelper {
  private:
@@ -948,6 +1032,18 @@ class gebp_traits<RealScalar, std::complex<RealScalar>, false, ConjRhs_, Arch, P
  protected:
 };
 
+/* Adds alpha * c to the coefficient r of the result in the scalar paths of gebp_kernel. In the deterministic mode,
+ * see EIGEN_DETERMINISTIC_REDUCTIONS, this is rounded like the packet paths, such that the result of a coefficient
+ * does not depend on the path computing it. */
+template <typename ResScalar>
+EIGEN_STRONG_INLINE void gebp_scalar_acc(ResScalar& r, const ResScalar& alpha, const ResScalar& c) {
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+  r = pmadd(c, alpha, r);
+#else
+  r += alpha * c;
+#endif
+}
+
 /* optimized General packed Block * packed Panel product kernel
  *
  * Mixing type logic: C += A * B
@@ -955,6 +1051,8 @@ class gebp_traits<RealScalar, std::complex<RealScalar>, false, ConjRhs_, Arch, P
  *  |real |cplx | no vectorization yet, would require to pack A with duplication
  *  |cplx |real | easy vectorization
  */
+inline namespace EIGEN_KERNEL_NAMESPACE {
+
 template <typename LhsScalar, typename RhsScalar, typename Index, typename DataMapper, int mr, int nr,
           bool ConjugateLhs, bool ConjugateRhs>
 struct gebp_kernel {
@@ -1010,6 +1108,8 @@ struct gebp_kernel {
                                     Index offsetA = 0, Index offsetB = 0);
 };
 
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
+
 template <typename LhsScalar, typename RhsScalar, typename Index, typename DataMapper, int mr, int nr,
           bool ConjugateLhs, bool ConjugateRhs,
           int SwappedLhsProgress =
@@ -1260,11 +1360,16 @@ struct lhs_process_one_packet {
         // This trick is crutial to get good performance with FMA, otherwise it is
         // actually faster to perform separated MUL+ADD because of a naturally
         // better instruction-level parallelism.
+        // In the deterministic mode, all k accumulate in C* as in the other paths.
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+        AccPacket &D0 = C0, &D1 = C1, &D2 = C2, &D3 = C3;
+#else
         AccPacket D0, D1, D2, D3;
         traits.initAcc(D0);
         traits.initAcc(D1);
         traits.initAcc(D2);
         traits.initAcc(D3);
+#endif
 
         LinearMapper r0 = res.getLinearMapper(i, j2 + 0);
         LinearMapper r1 = res.getLinearMapper(i, j2 + 1);
@@ -1302,10 +1407,12 @@ struct lhs_process_one_packet {
 
           EIGEN_ASM_COMMENT("end gebp micro kernel 1/half/quarterX4");
         }
+#ifndef EIGEN_DETERMINISTIC_REDUCTIONS
         C0 = padd(C0, D0);
         C1 = padd(C1, D1);
         C2 = padd(C2, D2);
         C3 = padd(C3, D3);
+#endif
 
         // process remaining peeled loop
         for (Index k = peeled_kc; k < depth; k++) {
@@ -1428,6 +1535,9 @@ EIGEN_DONT_INLINE void gebp_kernel<LhsScalar, RhsScalar, Index, DataMapper, mr,
                                                              Index offsetA, Index offsetB) {
   Traits traits;
   SwappedTraits straits;
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+  EIGEN_UNUSED_VARIABLE(straits);
+#endif
 
   if (strideA == -1) strideA = depth;
   if (strideB == -1) strideB = depth;
@@ -2367,14 +2477,14 @@ EIGEN_DONT_INLINE void gebp_kernel<LhsScalar, RhsScalar, Index, DataMapper, mr,
 
             blB += 8;
           }
-          res(i, j2 + 0) += alpha * C0;
-          res(i, j2 + 1) += alpha * C1;
-          res(i, j2 + 2) += alpha * C2;
-          res(i, j2 + 3) += alpha * C3;
-          res(i, j2 + 4) += alpha * C4;
-          res(i, j2 + 5) += alpha * C5;
-          res(i, j2 + 6) += alpha * C6;
-          res(i, j2 + 7) += alpha * C7;
+          gebp_scalar_acc(res(i, j2 + 0), alpha, C0);
+          gebp_scalar_acc(res(i, j2 + 1), alpha, C1);
+          gebp_scalar_acc(res(i, j2 + 2), alpha, C2);
+          gebp_scalar_acc(res(i, j2 + 3), alpha, C3);
+          gebp_scalar_acc(res(i, j2 + 4), alpha, C4);
+          gebp_scalar_acc(res(i, j2 + 5), alpha, C5);
+          gebp_scalar_acc(res(i, j2 + 6), alpha, C6);
+          gebp_scalar_acc(res(i, j2 + 7), alpha, C7);
         }
       }
     }
@@ -2387,6 +2497,9 @@ EIGEN_DONT_INLINE void gebp_kernel<LhsScalar, RhsScalar, Index, DataMapper, mr,
         prefetch(&blA[0]);
         const RhsScalar* blB = &blockB[j2 * strideB + offsetB * 4];
 
+        // The swapped path accumulates several k within the lanes of a packet, so that the deterministic mode always
+        // takes the scalar path.
+#ifndef EIGEN_DETERMINISTIC_REDUCTIONS
         // If LhsProgress is 8 or 16, it assumes that there is a
         // half or quarter packet, respectively, of the same size as
         // nr (which is currently 4) for the return type.
@@ -2493,6 +2606,7 @@ EIGEN_DONT_INLINE void gebp_kernel<LhsScalar, RhsScalar, Index, DataMapper, mr,
             res.scatterPacket(i, j2, R);
           }
         } else  // scalar path
+#endif
         {
           // get a 1 x 4 res block as registers
           ResScalar C0(0), C1(0), C2(0), C3(0);
@@ -2515,10 +2629,10 @@ EIGEN_DONT_INLINE void gebp_kernel<LhsScalar, RhsScalar, Index, DataMapper, mr,
 
             blB += 4;
           }
-          res(i, j2 + 0) += alpha * C0;
-          res(i, j2 + 1) += alpha * C1;
-          res(i, j2 + 2) += alpha * C2;
-          res(i, j2 + 3) += alpha * C3;
+          gebp_scalar_acc(res(i, j2 + 0), alpha, C0);
+          gebp_scalar_acc(res(i, j2 + 1), alpha, C1);
+          gebp_scalar_acc(res(i, j2 + 2), alpha, C2);
+          gebp_scalar_acc(res(i, j2 + 3), alpha, C3);
         }
       }
     }
@@ -2536,7 +2650,7 @@ EIGEN_DONT_INLINE void gebp_kernel<LhsScalar, RhsScalar, Index, DataMapper, mr,
           RhsScalar B_0 = blB[k];
           C0 = cj.pmadd(A0, B_0, C0);
         }
-        res(i, j2) += alpha * C0;
+        gebp_scalar_acc(res(i, j2), alpha, C0);
       }
     }
   }
@@ -3148,6 +3262,55 @@ inline void setCpuCacheSizes(std::ptrdiff_t l1, std::ptrdiff_t l2, std::ptrdiff_
   internal::manage_caching_sizes(SetAction, &l1, &l2, &l3);
 }
 
+/** Sets the blocking sizes \a kc, \a mc and \a nc of the single threaded general matrix-matrix products of \a Scalar
+ * (\c float, \c double, or their complex counterparts) having the shape class of a \a m x \a k times \a k x \a n
+ * product. A shape class gathers all the products whose depth, rows and columns have the same powers of two rounded
+ * down, clamped between 16 and 2048. The blocking sizes are used instead of the ones computed from the cpu cache sizes,
+ * after being reduced to the dimensions of the product.
+ *
+ * A zero \a kc removes the tuned sizes of the shape class. Like setCpuCacheSizes(), this function must not be called
+ * while matrix products are running. The sizes are usually measured and saved by the BlockingSizesTuner module.
+ *
+ * \sa tunedBlockingSizes(), clearTunedBlockingSizes() */
+template <typename Scalar>
+inline void setTunedBlockingSizes(Index k, Index m, Index n, Index kc, Index mc, Index nc) {
+  enum { ScalarId = internal::blocking_sizes_tuning_scalar<Scalar, Scalar>::value };
+  EIGEN_STATIC_ASSERT(ScalarId >= 0, THIS_TYPE_IS_NOT_SUPPORTED)
+  eigen_assert(kc >= 0 && mc >= 0 && nc >= 0 && (kc == 0 || (mc > 0 && nc > 0)));
+  internal::blocking_sizes_tuning& tuning = internal::blocking_sizes_tuning_table();
+  int* sizes = tuning.entry(ScalarId, k, m, n);
+  sizes[0] = int(numext::mini<Index>(kc, NumTraits<int>::highest()));
+  sizes[1] = int(numext::mini<Index>(mc, NumTraits<int>::highest()));
+  sizes[2] = int(numext::mini<Index>(nc, NumTraits<int>::highest()));
+  if (kc > 0) tuning.enabled = true;
+}
+
+/** \returns whether blocking sizes have been tuned for the products of \a Scalar having the shape class of a \a m x
+ * \a k times \a k x \a n product, in which case they are stored in \a kc, \a mc and \a nc.
+ *
+ * \sa setTunedBlockingSizes() */
+template <typename Scalar>
+inline bool tunedBlockingSizes(Index k, Index m, Index n, Index& kc, Index& mc, Index& nc) {
+  enum { ScalarId = internal::blocking_sizes_tuning_scalar<Scalar, Scalar>::value };
+  EIGEN_STATIC_ASSERT(ScalarId >= 0, THIS_TYPE_IS_NOT_SUPPORTED)
+  const int* sizes = internal::blocking_sizes_tuning_table().entry(ScalarId, k, m, n);
+  if (sizes[0] == 0) return false;
+  kc = sizes[0];
+  mc = sizes[1];
+  nc = sizes[2];
+  return true;
+}
+
+/** Removes all the blocking sizes set by setTunedBlockingSizes(), such that all the products use the blocking sizes
+ * computed from the cpu cache sizes again.
+ *
+ * \sa setTunedBlockingSizes() */
+inline void clearTunedBlockingSizes() {
+  internal::blocking_sizes_tuning& tuning = internal::blocking_sizes_tuning_table();
+  std::fill_n(&tuning.sizes[0][0][0][0][0], sizeof(tuning.sizes) / sizeof(int), 0);
+  tuning.enabled = false;
+}
+
 }  // end namespace Eigen
 
 #endif  // EIGEN_GENERAL_BLOCK_PANEL_H
@@ -17,8 +17,20 @@ namespace Eigen {
 
 namespace internal {
 
+inline namespace EIGEN_KERNEL_NAMESPACE {
 template <typename LhsScalar_, typename RhsScalar_>
 class level3_blocking;
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
+
+/* Element-wise epilogue of the general matrix-matrix product that does nothing.
+ * An epilogue is called as epilogue(i, j, rows, cols) on every mc x nc block of the column-major result once the
+ * whole depth has been accumulated into it, i.e., in the same pass over the result as the last depth panel. */
+struct gemm_no_epilogue {
+  template <typename Index>
+  EIGEN_STRONG_INLINE void operator()(Index, Index, Index, Index) const {}
+  template <typename Block, typename Index>
+  EIGEN_STRONG_INLINE void operator()(Block&, Index, Index) const {}
+};
 
 /* Specialization for a row-major destination matrix => simple transposition of the product */
 template <typename Index, typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs, typename RhsScalar,
@@ -38,8 +50,71 @@ struct general_matrix_matrix_product<Index, LhsScalar, LhsStorageOrder, Conjugat
                                   ResInnerStride>::run(cols, rows, depth, rhs, rhsStride, lhs, lhsStride, res, resIncr,
                                                        resStride, alpha, blocking, info);
   }
+
+  template <typename Epilogue>
+  static EIGEN_STRONG_INLINE void run(Index rows, Index cols, Index depth, const LhsScalar* lhs, Index lhsStride,
+                                      const RhsScalar* rhs, Index rhsStride, ResScalar* res, Index resIncr,
+                                      Index resStride, ResScalar alpha, level3_blocking<RhsScalar, LhsScalar>& blocking,
+                                      GemmParallelInfo<Index>* info, const Epilogue& epilogue) {
+    // Note that the epilogue receives the block coordinates of the transposed product.
+    general_matrix_matrix_product<Index, RhsScalar, RhsStorageOrder == RowMajor ? ColMajor : RowMajor, ConjugateRhs,
+                                  LhsScalar, LhsStorageOrder == RowMajor ? ColMajor : RowMajor, ConjugateLhs, ColMajor,
+                                  ResInnerStride>::run(cols, rows, depth, rhs, rhsStride, lhs, lhsStride, res, resIncr,
+                                                       resStride, alpha, blocking, info, epilogue);
+  }
+};
+
+#if defined(EIGEN_DISPATCH_TO_VARIANTS)
+/* Forwards the general matrix-matrix product to the kernel variant registered for the host CPU, if any, see
+ * Eigen/DispatchVariant. Returns false if the product has to be computed by the kernels of this translation unit. */
+template <typename LhsScalar, typename RhsScalar, bool Dispatchable>
+struct gemm_variant_dispatch {
+  template <typename... Args>
+  static bool run(const Args&...) {
+    return false;
+  }
 };
 
+template <typename Scalar>
+struct gemm_variant_dispatch<Scalar, Scalar, true> {
+  template <typename Index>
+  static bool run(Index rows, Index cols, Index depth, const Scalar* lhs, Index lhsStride, bool lhsRowMajor,
+                  const Scalar* rhs, Index rhsStride, bool rhsRowMajor, Scalar* res, Index resStride, Scalar alpha,
+                  GemmParallelInfo<Index>* info) {
+    const dispatch_kernels<Scalar>& kernels = dispatched_kernels<Scalar>();
+    if (!kernels.gemm) return false;
+#if defined(EIGEN_GEMM_THREADPOOL)
+    if (info) {
+      GemmParallelTileInfo<Index>* tile_info = info->tile_info;
+      const dispatch_gemm_tiles tiles = {tile_info->tile_rows, tile_info->tile_cols, tile_info->num_row_tiles,
+                                         tile_info->num_tiles, info->first_tile, tile_info, &claim_tile<Index>,
+                                         &finish_tile<Index>};
+      kernels.gemm(rows, cols, depth, lhs, lhsStride, lhsRowMajor, rhs, rhsStride, rhsRowMajor, res, resStride, alpha,
+                   &tiles);
+      return true;
+    }
+#else
+    // Every OpenMP thread computes its own slab of the result independently.
+    EIGEN_UNUSED_VARIABLE(info);
+#endif
+    kernels.gemm(rows, cols, depth, lhs, lhsStride, lhsRowMajor, rhs, rhsStride, rhsRowMajor, res, resStride, alpha, 0);
+    return true;
+  }
+
+#if defined(EIGEN_GEMM_THREADPOOL)
+  template <typename Index>
+  static dispatch_index claim_tile(void* tile_info) {
+    return static_cast<GemmParallelTileInfo<Index>*>(tile_info)->claim();
+  }
+
+  template <typename Index>
+  static void finish_tile(void* tile_info) {
+    static_cast<GemmParallelTileInfo<Index>*>(tile_info)->finish();
+  }
+#endif
+};
+#endif  // defined(EIGEN_DISPATCH_TO_VARIANTS)
+
 /*  Specialization for a col-major destination matrix
  *    => Blocking algorithm following Goto's paper */
 template <typename Index, typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs, typename RhsScalar,
@@ -52,6 +127,25 @@ struct general_matrix_matrix_product<Index, LhsScalar, LhsStorageOrder, Conjugat
   static void run(Index rows, Index cols, Index depth, const LhsScalar* lhs_, Index lhsStride, const RhsScalar* rhs_,
                   Index rhsStride, ResScalar* res_, Index resIncr, Index resStride, ResScalar alpha,
                   level3_blocking<LhsScalar, RhsScalar>& blocking, GemmParallelInfo<Index>* info = 0) {
+    run(rows, cols, depth, lhs_, lhsStride, rhs_, rhsStride, res_, resIncr, resStride, alpha, blocking, info,
+        gemm_no_epilogue());
+  }
+
+  template <typename Epilogue>
+  static void run(Index rows, Index cols, Index depth, const LhsScalar* lhs_, Index lhsStride, const RhsScalar* rhs_,
+                  Index rhsStride, ResScalar* res_, Index resIncr, Index resStride, ResScalar alpha,
+                  level3_blocking<LhsScalar, RhsScalar>& blocking, GemmParallelInfo<Index>* info,
+                  const Epilogue& epilogue) {
+#if defined(EIGEN_DISPATCH_TO_VARIANTS)
+    enum {
+      Dispatchable = !ConjugateLhs && !ConjugateRhs && ResInnerStride == 1 &&
+                     std::is_same<Epilogue, gemm_no_epilogue>::value && !NumTraits<LhsScalar>::IsComplex
+    };
+    if (gemm_variant_dispatch<LhsScalar, RhsScalar, bool(Dispatchable)>::run(
+            rows, cols, depth, lhs_, lhsStride, LhsStorageOrder == RowMajor, rhs_, rhsStride,
+            RhsStorageOrder == RowMajor, res_, resStride, alpha, info))
+      return;
+#endif
     typedef const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> LhsMapper;
     typedef const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> RhsMapper;
     typedef blas_data_mapper<typename Traits::ResScalar, Index, ColMajor, Unaligned, ResInnerStride> ResMapper;
@@ -69,7 +163,46 @@ struct general_matrix_matrix_product<Index, LhsScalar, LhsStorageOrder, Conjugat
     gemm_pack_rhs<RhsScalar, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
     gebp_kernel<LhsScalar, RhsScalar, Index, ResMapper, Traits::mr, Traits::nr, ConjugateLhs, ConjugateRhs> gebp;
 
-#if !defined(EIGEN_USE_BLAS) && (defined(EIGEN_HAS_OPENMP) || defined(EIGEN_GEMM_THREADPOOL))
+#if !defined(EIGEN_USE_BLAS) && defined(EIGEN_GEMM_THREADPOOL)
+    if (info) {
+      // this is the tile-based parallel version!
+      // Each thread repeatedly claims a tile of the result, and computes it with its own packed lhs block and the
+      // packed rhs panel shared by the tiles of its column.
+      GemmParallelTileInfo<Index>* tiles = info->tile_info;
+      const Index tile_mc = tiles->tile_rows;
+      const Index tile_nc = tiles->tile_cols;
+      eigen_internal_assert(tiles->num_depth_blocks == numext::maxi<Index>(1, numext::div_ceil(depth, kc)));
+
+      std::size_t sizeA = kc * tile_mc;
+      ei_declare_aligned_stack_constructed_variable(LhsScalar, blockA, sizeA, 0);
+
+      for (Index t = info->first_tile; t < tiles->num_tiles; t = tiles->claim()) {
+        const Index col_tile = t / tiles->num_row_tiles;
+        const Index i2 = (t % tiles->num_row_tiles) * tile_mc;
+        const Index j2 = col_tile * tile_nc;
+        const Index actual_mc = (std::min)(i2 + tile_mc, rows) - i2;
+        const Index actual_nc = (std::min)(j2 + tile_nc, cols) - j2;
+        RhsScalar* panelB =
+            static_cast<RhsScalar*>(tiles->rhsPanel(col_tile, sizeof(RhsScalar) * std::size_t(depth * actual_nc)));
+
+        for (Index k2 = 0; k2 < depth; k2 += kc) {
+          const Index actual_kc = (std::min)(k2 + kc, depth) - k2;
+          RhsScalar* blockB = panelB + k2 * actual_nc;
+          pack_lhs(blockA, lhs.getSubMapper(i2, k2), actual_kc, actual_mc);
+          if (tiles->claimRhsBlock(col_tile, k2 / kc)) {
+            pack_rhs(blockB, rhs.getSubMapper(k2, j2), actual_kc, actual_nc);
+            tiles->rhsBlockPacked(col_tile, k2 / kc);
+          }
+          gebp(res.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, alpha);
+        }
+        tiles->releaseRhsPanel(col_tile);
+        epilogue(i2, j2, actual_mc, actual_nc);
+
+        // Note that the product operands may go out of scope as soon as the last tile is finished.
+        tiles->finish();
+      }
+    } else
+#elif !defined(EIGEN_USE_BLAS) && defined(EIGEN_HAS_OPENMP)
     if (info) {
       // this is the parallel version!
       int tid = info->logical_thread_id;
@@ -137,6 +270,9 @@ struct general_matrix_matrix_product<Index, LhsScalar, LhsStorageOrder, Conjugat
         // i.e., we simply decrement the number of users by 1
         for (Index i = 0; i < threads; ++i) info->task_info[i].users -= 1;
       }
+
+      // This thread is the only one writing to its vertical slab of the result.
+      epilogue(Index(0), Index(0), rows, cols);
     } else
 #endif  // defined(EIGEN_HAS_OPENMP) || defined(EIGEN_GEMM_THREADPOOL)
     {
@@ -175,6 +311,9 @@ struct general_matrix_matrix_product<Index, LhsScalar, LhsStorageOrder, Conjugat
 
             // Everything is packed, we can now call the panel * block kernel:
             gebp(res.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, alpha);
+
+            // The block is final after the last panel of the depth dimension.
+            if (k2 + actual_kc == depth) epilogue(i2, j2, actual_mc, actual_nc);
           }
         }
       }
@@ -182,16 +321,122 @@ struct general_matrix_matrix_product<Index, LhsScalar, LhsStorageOrder, Conjugat
   }
 };
 
+/*  Column-major product with a lhs that has been packed ahead of time, see PackedMatrix.
+ *  The lhs is stored as the sequence of (mc x kc) blocks visited by the sequential algorithm above, each block
+ *  being laid out as gemm_pack_lhs would produce it and starting on an aligned address. */
+template <typename Index, typename Scalar, int RhsStorageOrder, bool ConjugateRhs, int ResInnerStride>
+struct general_matrix_matrix_product_packed_lhs {
+  typedef gebp_traits<Scalar, Scalar> Traits;
+
+  // Returns the number of coefficients reserved for a packed block of size elements.
+  static Index paddedBlockSize(Index size) {
+    const Index align = numext::maxi<Index>(1, EIGEN_MAX_ALIGN_BYTES / sizeof(Scalar));
+    return numext::div_ceil(size, align) * align;
+  }
+
+  // Returns the number of coefficients required to pack a rows x depth lhs.
+  static Index packedSize(Index rows, Index depth, Index mc, Index kc) {
+    Index size = 0;
+    for (Index i2 = 0; i2 < rows; i2 += mc)
+      for (Index k2 = 0; k2 < depth; k2 += kc)
+        size += paddedBlockSize(((std::min)(i2 + mc, rows) - i2) * ((std::min)(k2 + kc, depth) - k2));
+    return size;
+  }
+
+  template <int LhsStorageOrder, bool ConjugateLhs>
+  static void pack(Index rows, Index depth, const Scalar* lhs_, Index lhsStride, Scalar* blockA, Index mc, Index kc) {
+    typedef const_blas_data_mapper<Scalar, Index, LhsStorageOrder> LhsMapper;
+    LhsMapper lhs(lhs_, lhsStride);
+    gemm_pack_lhs<Scalar, Index, LhsMapper, Traits::mr, Traits::LhsProgress, typename Traits::LhsPacket4Packing,
+                  LhsStorageOrder, ConjugateLhs>
+        pack_lhs;
+    for (Index i2 = 0; i2 < rows; i2 += mc) {
+      const Index actual_mc = (std::min)(i2 + mc, rows) - i2;
+      for (Index k2 = 0; k2 < depth; k2 += kc) {
+        const Index actual_kc = (std::min)(k2 + kc, depth) - k2;
+        pack_lhs(blockA, lhs.getSubMapper(i2, k2), actual_kc, actual_mc);
+        blockA += paddedBlockSize(actual_mc * actual_kc);
+      }
+    }
+  }
+
+  static void run(Index rows, Index cols, Index depth, const Scalar* blockA, Index mc, Index kc, const Scalar* rhs_,
+                  Index rhsStride, Scalar* res_, Index resIncr, Index resStride, Scalar alpha) {
+    typedef const_blas_data_mapper<Scalar, Index, RhsStorageOrder> RhsMapper;
+    typedef blas_data_mapper<Scalar, Index, ColMajor, Unaligned, ResInnerStride> ResMapper;
+    RhsMapper rhs(rhs_, rhsStride);
+    ResMapper res(res_, resStride, resIncr);
+
+    // Only the rhs remains to be blocked along the N direction.
+    Index k = kc, m = mc, nc = cols;
+    computeProductBlockingSizes<Scalar, Scalar>(k, m, nc);
+    nc = (std::min)(cols, nc);
+
+    std::size_t sizeB = kc * nc;
+    ei_declare_aligned_stack_constructed_variable(Scalar, blockB, sizeB, 0);
+
+    gemm_pack_rhs<Scalar, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
+    gebp_kernel<Scalar, Scalar, Index, ResMapper, Traits::mr, Traits::nr, false, ConjugateRhs> gebp;
+
+    const bool pack_rhs_once = mc < rows && kc >= depth && nc == cols;
+
+    for (Index i2 = 0; i2 < rows; i2 += mc) {
+      const Index actual_mc = (std::min)(i2 + mc, rows) - i2;
+      for (Index k2 = 0; k2 < depth; k2 += kc) {
+        const Index actual_kc = (std::min)(k2 + kc, depth) - k2;
+        for (Index j2 = 0; j2 < cols; j2 += nc) {
+          const Index actual_nc = (std::min)(j2 + nc, cols) - j2;
+          if ((!pack_rhs_once) || i2 == 0) pack_rhs(blockB, rhs.getSubMapper(k2, j2), actual_kc, actual_nc);
+          gebp(res.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, alpha);
+        }
+        blockA += paddedBlockSize(actual_mc * actual_kc);
+      }
+    }
+  }
+};
+
 /*********************************************************************************
  *  Specialization of generic_product_impl for "large" GEMM, i.e.,
  *  implementation of the high level wrapper to general_matrix_matrix_product
  **********************************************************************************/
 
+/* Adapts a user epilogue, called as epilogue(block, row, col) on blocks of the destination, to the coordinates of
+ * the underlying column-major product computed from the coefficient (row, col) of the destination. */
+template <typename Dest, typename Epilogue>
+struct gemm_epilogue_adaptor {
+  gemm_epilogue_adaptor(Dest& dest, Index row, Index col, const Epilogue& epilogue)
+      : m_dest(dest), m_row(row), m_col(col), m_epilogue(epilogue) {}
+
+  void operator()(Index i, Index j, Index rows, Index cols) const {
+    if (rows <= 0 || cols <= 0) return;
+    if (Dest::Flags & RowMajorBit) {
+      std::swap(i, j);
+      std::swap(rows, cols);
+    }
+    Block<Dest> block(m_dest, m_row + i, m_col + j, rows, cols);
+    m_epilogue(block, m_row + i, m_col + j);
+  }
+
+  Dest& m_dest;
+  Index m_row;
+  Index m_col;
+  const Epilogue& m_epilogue;
+};
+
+// Applies a user epilogue to the whole destination at once.
+template <typename Dest, typename Epilogue>
+void apply_gemm_epilogue(Dest& dest, const Epilogue& epilogue) {
+  if (dest.rows() == 0 || dest.cols() == 0) return;
+  Block<Dest> block(dest, 0, 0, dest.rows(), dest.cols());
+  epilogue(block, Index(0), Index(0));
+}
+
 template <typename Scalar, typename Index, typename Gemm, typename Lhs, typename Rhs, typename Dest,
-          typename BlockingType>
+          typename BlockingType, typename Epilogue = gemm_no_epilogue>
 struct gemm_functor {
-  gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, const Scalar& actualAlpha, BlockingType& blocking)
-      : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_blocking(blocking) {}
+  gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, const Scalar& actualAlpha, BlockingType& blocking,
+               const Epilogue& epilogue = Epilogue())
+      : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_blocking(blocking), m_epilogue(epilogue) {}
 
   void initParallelSession(Index num_threads) const {
     m_blocking.initParallel(m_lhs.rows(), m_rhs.cols(), m_lhs.cols(), num_threads);
@@ -201,21 +446,39 @@ struct gemm_functor {
   void operator()(Index row, Index rows, Index col = 0, Index cols = -1, GemmParallelInfo<Index>* info = 0) const {
     if (cols == -1) cols = m_rhs.cols();
 
+    run(row, rows, col, cols, info, std::is_same<Epilogue, gemm_no_epilogue>());
+  }
+
+  // Cache block sizes along the M and N directions of the underlying column-major product.
+  Index mc() const { return m_blocking.mc(); }
+  Index nc() const { return m_blocking.nc(); }
+  Index kc() const { return m_blocking.kc(); }
+
+  typedef typename Gemm::Traits Traits;
+
+ protected:
+  // Without epilogue, use the plain kernel entry point which may also be provided by an external BLAS.
+  void run(Index row, Index rows, Index col, Index cols, GemmParallelInfo<Index>* info, std::true_type) const {
     Gemm::run(rows, cols, m_lhs.cols(), &m_lhs.coeffRef(row, 0), m_lhs.outerStride(), &m_rhs.coeffRef(0, col),
               m_rhs.outerStride(), (Scalar*)&(m_dest.coeffRef(row, col)), m_dest.innerStride(), m_dest.outerStride(),
               m_actualAlpha, m_blocking, info);
   }
 
-  typedef typename Gemm::Traits Traits;
+  void run(Index row, Index rows, Index col, Index cols, GemmParallelInfo<Index>* info, std::false_type) const {
+    Gemm::run(rows, cols, m_lhs.cols(), &m_lhs.coeffRef(row, 0), m_lhs.outerStride(), &m_rhs.coeffRef(0, col),
+              m_rhs.outerStride(), (Scalar*)&(m_dest.coeffRef(row, col)), m_dest.innerStride(), m_dest.outerStride(),
+              m_actualAlpha, m_blocking, info, gemm_epilogue_adaptor<Dest, Epilogue>(m_dest, row, col, m_epilogue));
+  }
 
- protected:
   const Lhs& m_lhs;
   const Rhs& m_rhs;
   Dest& m_dest;
   Scalar m_actualAlpha;
   BlockingType& m_blocking;
+  Epilogue m_epilogue;
 };
 
+inline namespace EIGEN_KERNEL_NAMESPACE {
 template <int StorageOrder, typename LhsScalar, typename RhsScalar, int MaxRows, int MaxCols, int MaxDepth,
           int KcFactor = 1, bool FiniteAtCompileTime = MaxRows != Dynamic && MaxCols != Dynamic && MaxDepth != Dynamic>
 class gemm_blocking_space;
@@ -352,6 +615,8 @@ class gemm_blocking_space<StorageOrder, LhsScalar_, RhsScalar_, MaxRows, MaxCols
   }
 };
 
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
+
 }  // end namespace internal
 
 namespace internal {
@@ -409,21 +674,37 @@ struct generic_product_impl<Lhs, Rhs, DenseShape, DenseShape, GemmProduct>
 
   template <typename Dest>
   static void scaleAndAddTo(Dest& dst, const Lhs& a_lhs, const Rhs& a_rhs, const Scalar& alpha) {
+    scaleAndAddTo(dst, a_lhs, a_rhs, alpha, gemm_no_epilogue());
+  }
+
+  // Same as above, but additionally calls epilogue(block, row, col) exactly once on every coefficient of dst after
+  // its final value has been accumulated. The epilogue may be called concurrently on disjoint blocks.
+  template <typename Dest, typename Epilogue>
+  static void scaleAndAddTo(Dest& dst, const Lhs& a_lhs, const Rhs& a_rhs, const Scalar& alpha,
+                            const Epilogue& epilogue) {
     eigen_assert(dst.rows() == a_lhs.rows() && dst.cols() == a_rhs.cols());
-    if (a_lhs.cols() == 0 || a_lhs.rows() == 0 || a_rhs.cols() == 0) return;
+    if (a_lhs.cols() == 0 || a_lhs.rows() == 0 || a_rhs.cols() == 0) {
+      apply_gemm_epilogue(dst, epilogue);
+      return;
+    }
 
     if (dst.cols() == 1) {
       // Fallback to GEMV if either the lhs or rhs is a runtime vector
       typename Dest::ColXpr dst_vec(dst.col(0));
-      return internal::generic_product_impl<Lhs, typename Rhs::ConstColXpr, DenseShape, DenseShape,
-                                            GemvProduct>::scaleAndAddTo(dst_vec, a_lhs, a_rhs.col(0), alpha);
+      internal::generic_product_impl<Lhs, typename Rhs::ConstColXpr, DenseShape, DenseShape,
+                                     GemvProduct>::scaleAndAddTo(dst_vec, a_lhs, a_rhs.col(0), alpha);
+      apply_gemm_epilogue(dst, epilogue);
+      return;
     } else if (dst.rows() == 1) {
       // Fallback to GEMV if either the lhs or rhs is a runtime vector
       typename Dest::RowXpr dst_vec(dst.row(0));
-      return internal::generic_product_impl<typename Lhs::ConstRowXpr, Rhs, DenseShape, DenseShape,
-                                            GemvProduct>::scaleAndAddTo(dst_vec, a_lhs.row(0), a_rhs, alpha);
+      internal::generic_product_impl<typename Lhs::ConstRowXpr, Rhs, DenseShape, DenseShape,
+                                     GemvProduct>::scaleAndAddTo(dst_vec, a_lhs.row(0), a_rhs, alpha);
+      apply_gemm_epilogue(dst, epilogue);
+      return;
     }
 
+    EIGEN_INSTRUMENTED_REGION("gemm");
     add_const_on_value_type_t<ActualLhsType> lhs = LhsBlasTraits::extract(a_lhs);
     add_const_on_value_type_t<ActualRhsType> rhs = RhsBlasTraits::extract(a_rhs);
 
@@ -440,18 +721,64 @@ struct generic_product_impl<Lhs, Rhs, DenseShape, DenseShape, GemmProduct>
             bool(LhsBlasTraits::NeedToConjugate), RhsScalar,
             (ActualRhsTypeCleaned::Flags & RowMajorBit) ? RowMajor : ColMajor, bool(RhsBlasTraits::NeedToConjugate),
             (Dest::Flags & RowMajorBit) ? RowMajor : ColMajor, Dest::InnerStrideAtCompileTime>,
-        ActualLhsTypeCleaned, ActualRhsTypeCleaned, Dest, BlockingType>
+        ActualLhsTypeCleaned, ActualRhsTypeCleaned, Dest, BlockingType, Epilogue>
         GemmFunctor;
 
     BlockingType blocking(dst.rows(), dst.cols(), lhs.cols(), 1, true);
     internal::parallelize_gemm<(Dest::MaxRowsAtCompileTime > 32 || Dest::MaxRowsAtCompileTime == Dynamic)>(
-        GemmFunctor(lhs, rhs, dst, actualAlpha, blocking), a_lhs.rows(), a_rhs.cols(), a_lhs.cols(),
+        GemmFunctor(lhs, rhs, dst, actualAlpha, blocking, epilogue), a_lhs.rows(), a_rhs.cols(), a_lhs.cols(),
         Dest::Flags & RowMajorBit);
   }
 };
 
 }  // end namespace internal
 
+/** \ingroup Core_Module
+ *
+ * Computes \a dst = \a lhs * \a rhs and applies \a epilogue to the result without an additional pass over \a dst.
+ *
+ * The epilogue is a functor called as <tt>epilogue(block, row, col)</tt>, where \c block is a writable block of \a dst
+ * starting at the coefficient (\c row, \c col) whose product has been fully accumulated. It is typically used to add a
+ * bias, apply an activation function or a scaling:
+ * \code
+ * struct BiasRelu {
+ *   const VectorXf& bias;
+ *   template <typename Block>
+ *   void operator()(Block& block, Index row, Index) const {
+ *     block = (block.colwise() + bias.segment(row, block.rows())).cwiseMax(0.f);
+ *   }
+ * };
+ * fusedProduct(A, B, C, BiasRelu{bias});
+ * \endcode
+ * Within the matrix-matrix product, the epilogue is applied to each mc x nc block of the result right after the last
+ * depth panel has been accumulated into it, which saves a separate pass over the whole of \a dst but does not keep
+ * the block in registers: it may already have been partially evicted from the cache by the time the epilogue runs.
+ * Every coefficient of \a dst is passed to the epilogue exactly once, but blocks may be processed concurrently when
+ * the product is multithreaded, so the epilogue must be safe to call from several threads on disjoint blocks.
+ *
+ * \a dst is resized if needed and must not alias \a lhs or \a rhs.
+ */
+template <typename Lhs, typename Rhs, typename Dest, typename Epilogue>
+void fusedProduct(const MatrixBase<Lhs>& lhs, const MatrixBase<Rhs>& rhs, MatrixBase<Dest>& dst,
+                  const Epilogue& epilogue) {
+  typedef typename Dest::Scalar Scalar;
+  dst.derived().resize(lhs.rows(), rhs.cols());
+#if defined(EIGEN_USE_BLAS)
+  // The external BLAS has no hook for the epilogue.
+  dst.derived().noalias() = lhs.derived() * rhs.derived();
+  internal::apply_gemm_epilogue(dst.derived(), epilogue);
+#else
+  if ((rhs.rows() + dst.rows() + dst.cols()) < EIGEN_GEMM_TO_COEFFBASED_THRESHOLD && rhs.rows() > 0) {
+    dst.derived().noalias() = lhs.derived().lazyProduct(rhs.derived());
+    internal::apply_gemm_epilogue(dst.derived(), epilogue);
+  } else {
+    dst.derived().setZero();
+    internal::generic_product_impl<Lhs, Rhs, DenseShape, DenseShape, GemmProduct>::scaleAndAddTo(
+        dst.derived(), lhs.derived(), rhs.derived(), Scalar(1), epilogue);
+  }
+#endif
+}
+
 }  // end namespace Eigen
 
 #endif  // EIGEN_GENERAL_MATRIX_MATRIX_H
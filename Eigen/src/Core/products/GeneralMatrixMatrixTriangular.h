@@ -68,6 +68,63 @@ struct general_matrix_matrix_triangular_product<Index, LhsScalar, LhsStorageOrde
                                       const RhsScalar* rhs_, Index rhsStride, ResScalar* res_, Index resIncr,
                                       Index resStride, const ResScalar& alpha,
                                       level3_blocking<LhsScalar, RhsScalar>& blocking) {
+    // Each thread computes the columns of the triangular result within one range. The ranges are chosen to hold the
+    // same number of coefficients of the triangle, and are at least 64 columns wide to amortize the packing. The
+    // minimal work per thread is the one of parallelize_gemm.
+    const double work = 0.5 * static_cast<double>(size) * static_cast<double>(size) * static_cast<double>(depth);
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+    // The ranges would change the blocking of the products, and hence the order in which they are accumulated.
+    const int threads = 1;
+    EIGEN_UNUSED_VARIABLE(work)
+#else
+    const int threads = parallel_threads(work, 50000, size / 64);
+#endif
+    if (threads <= 1) {
+      run_sequential(size, depth, lhs_, lhsStride, rhs_, rhsStride, res_, resIncr, resStride, alpha, blocking);
+      return;
+    }
+
+    ei_declare_aligned_stack_constructed_variable(Index, bounds, threads + 1, 0);
+    balanced_partition(
+        size, threads, Index(16),
+        [size](Index j) {
+          // Number of coefficients of the triangle within the first j columns.
+          const double jd = static_cast<double>(j);
+          return UpLo == Lower ? jd * static_cast<double>(size) - 0.5 * jd * (jd - 1) : 0.5 * jd * (jd + 1);
+        },
+        bounds);
+
+    parallelize_tasks(threads, [&](int t) {
+      const Index j0 = bounds[t], j1 = bounds[t + 1];
+      if (j1 == j0) return;
+      const LhsScalar* lhs_j0 = lhs_ + (LhsStorageOrder == RowMajor ? j0 * lhsStride : j0);
+      const RhsScalar* rhs_j0 = rhs_ + (RhsStorageOrder == RowMajor ? j0 : j0 * rhsStride);
+
+      // The triangular block on the diagonal.
+      gemm_blocking_space<ColMajor, LhsScalar, RhsScalar, Dynamic, Dynamic, Dynamic> tri_blocking(j1 - j0, j1 - j0,
+                                                                                                  depth, 1, false);
+      run_sequential(j1 - j0, depth, lhs_j0, lhsStride, rhs_j0, rhsStride, res_ + j0 * resIncr + j0 * resStride,
+                     resIncr, resStride, alpha, tri_blocking);
+
+      // The rectangular block below (resp. above) it, with rows [j1, size) (resp. [0, j0)).
+      const Index i0 = UpLo == Lower ? j1 : 0;
+      const Index rows = UpLo == Lower ? size - j1 : j0;
+      if (rows == 0) return;
+      const LhsScalar* lhs_i0 = lhs_ + (LhsStorageOrder == RowMajor ? i0 * lhsStride : i0);
+      gemm_blocking_space<ColMajor, LhsScalar, RhsScalar, Dynamic, Dynamic, Dynamic> gemm_blocking(rows, j1 - j0,
+                                                                                                   depth, 1, true);
+      general_matrix_matrix_product<Index, LhsScalar, LhsStorageOrder, ConjugateLhs, RhsScalar, RhsStorageOrder,
+                                    ConjugateRhs, ColMajor, ResInnerStride>::run(rows, j1 - j0, depth, lhs_i0,
+                                                                                 lhsStride, rhs_j0, rhsStride,
+                                                                                 res_ + i0 * resIncr + j0 * resStride,
+                                                                                 resIncr, resStride, alpha,
+                                                                                 gemm_blocking);
+    });
+  }
+
+  static void run_sequential(Index size, Index depth, const LhsScalar* lhs_, Index lhsStride, const RhsScalar* rhs_,
+                             Index rhsStride, ResScalar* res_, Index resIncr, Index resStride, const ResScalar& alpha,
+                             level3_blocking<LhsScalar, RhsScalar>& blocking) {
     typedef gebp_traits<LhsScalar, RhsScalar> Traits;
 
     typedef const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> LhsMapper;
@@ -62,6 +62,45 @@ class gemv_traits {
   typedef std::conditional_t<Vectorizable, ResPacket_, ResScalar> ResPacket;
 };
 
+#if defined(EIGEN_DISPATCH_TO_VARIANTS)
+/* Forwards the matrix-vector product to the kernel variant registered for the host CPU, if any, see
+ * Eigen/DispatchVariant. Only the plain data mappers of dense matrices and vectors are forwarded. */
+template <typename LhsScalar, typename LhsMapper, bool ConjugateLhs, typename RhsScalar, typename RhsMapper,
+          bool ConjugateRhs>
+struct gemv_variant_dispatch {
+  template <typename... Args>
+  static bool run(const Args&...) {
+    return false;
+  }
+};
+
+template <typename Scalar, typename Index>
+struct gemv_variant_dispatch<Scalar, const_blas_data_mapper<Scalar, Index, ColMajor>, false, Scalar,
+                             const_blas_data_mapper<Scalar, Index, RowMajor>, false> {
+  static bool run(Index rows, Index cols, const const_blas_data_mapper<Scalar, Index, ColMajor>& lhs,
+                  const const_blas_data_mapper<Scalar, Index, RowMajor>& rhs, Scalar* res, Index resIncr,
+                  Scalar alpha) {
+    const dispatch_kernels<Scalar>& kernels = dispatched_kernels<Scalar>();
+    if (!kernels.gemv) return false;
+    kernels.gemv(rows, cols, lhs.data(), lhs.stride(), false, rhs.data(), rhs.stride(), res, resIncr, alpha);
+    return true;
+  }
+};
+
+template <typename Scalar, typename Index>
+struct gemv_variant_dispatch<Scalar, const_blas_data_mapper<Scalar, Index, RowMajor>, false, Scalar,
+                             const_blas_data_mapper<Scalar, Index, ColMajor>, false> {
+  static bool run(Index rows, Index cols, const const_blas_data_mapper<Scalar, Index, RowMajor>& lhs,
+                  const const_blas_data_mapper<Scalar, Index, ColMajor>& rhs, Scalar* res, Index resIncr,
+                  Scalar alpha) {
+    const dispatch_kernels<Scalar>& kernels = dispatched_kernels<Scalar>();
+    if (!kernels.gemv) return false;
+    kernels.gemv(rows, cols, lhs.data(), lhs.stride(), true, rhs.data(), 1, res, resIncr, alpha);
+    return true;
+  }
+};
+#endif  // defined(EIGEN_DISPATCH_TO_VARIANTS)
+
 /* Optimized col-major matrix * vector product:
  * This algorithm processes the matrix per vertical panels,
  * which are then processed horizontally per chunck of 8*PacketSize x 1 vertical segments.
@@ -110,6 +149,11 @@ general_matrix_vector_product<Index, LhsScalar, LhsMapper, ColMajor, ConjugateLh
                                             ResScalar* res, Index resIncr, RhsScalar alpha) {
   EIGEN_UNUSED_VARIABLE(resIncr);
   eigen_internal_assert(resIncr == 1);
+#if defined(EIGEN_DISPATCH_TO_VARIANTS)
+  if (gemv_variant_dispatch<LhsScalar, LhsMapper, ConjugateLhs, RhsScalar, RhsMapper, ConjugateRhs>::run(
+          rows, cols, alhs, rhs, res, resIncr, alpha))
+    return;
+#endif
 
   // The following copy tells the compiler that lhs's attributes are not modified outside this function
   // This helps GCC to generate propoer code.
@@ -301,6 +345,11 @@ EIGEN_DEVICE_FUNC EIGEN_DONT_INLINE void
 general_matrix_vector_product<Index, LhsScalar, LhsMapper, RowMajor, ConjugateLhs, RhsScalar, RhsMapper, ConjugateRhs,
                               Version>::run(Index rows, Index cols, const LhsMapper& alhs, const RhsMapper& rhs,
                                             ResScalar* res, Index resIncr, ResScalar alpha) {
+#if defined(EIGEN_DISPATCH_TO_VARIANTS)
+  if (gemv_variant_dispatch<LhsScalar, LhsMapper, ConjugateLhs, RhsScalar, RhsMapper, ConjugateRhs>::run(
+          rows, cols, alhs, rhs, res, resIncr, alpha))
+    return;
+#endif
   // The following copy tells the compiler that lhs's attributes are not modified outside this function
   // This helps GCC to generate propoer code.
   LhsMapper lhs(alhs);
@@ -466,6 +515,64 @@ general_matrix_vector_product<Index, LhsScalar, LhsMapper, RowMajor, ConjugateLh
   }
 }
 
+/* Multithreaded matrix-vector product res += alpha * lhs * rhs, for products large enough to be worth it, see
+ * parallel_threads(). Since the product is memory bound, every thread streams over its own part of the lhs:
+ *  - a row-major lhs, or a col-major lhs with at least as many rows as columns, is split into blocks of rows;
+ *  - a wide col-major lhs is split into panels of columns, whose partial results are accumulated in per-thread
+ *    buffers, and summed into res at the end.
+ * If EIGEN_DETERMINISTIC_REDUCTIONS is defined, the lhs is always split into blocks of rows, such that the result does
+ * not depend on the number of threads. */
+template <typename Index, typename LhsScalar, typename LhsMapper, int LhsStorageOrder, bool ConjugateLhs,
+          typename RhsScalar, typename RhsMapper, bool ConjugateRhs>
+struct parallel_matrix_vector_product {
+  typedef general_matrix_vector_product<Index, LhsScalar, LhsMapper, LhsStorageOrder, ConjugateLhs, RhsScalar,
+                                        RhsMapper, ConjugateRhs>
+      Gemv;
+  typedef typename Gemv::ResScalar ResScalar;
+
+  template <typename AlphaScalar>
+  static void run(Index rows, Index cols, const LhsMapper& lhs, const RhsMapper& rhs, ResScalar* res, Index resIncr,
+                  const AlphaScalar& alpha) {
+    // Minimal number of coefficients of the lhs per thread, and of rows or columns per block.
+    const double kMinTaskSize = 65536;
+    const Index kGranularity = 16;
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+    const bool splitRows = true;
+#else
+    const bool splitRows = LhsStorageOrder == RowMajor || rows >= cols;
+#endif
+    const int threads = parallel_threads(static_cast<double>(rows) * static_cast<double>(cols), kMinTaskSize,
+                                         (splitRows ? rows : cols) / kGranularity);
+    if (threads <= 1) return Gemv::run(rows, cols, lhs, rhs, res, resIncr, alpha);
+
+    const Index size = splitRows ? rows : cols;
+    ei_declare_aligned_stack_constructed_variable(Index, bounds, threads + 1, 0);
+    for (int i = 0; i < threads; ++i) bounds[i] = numext::round_down(size * i / threads, kGranularity);
+    bounds[threads] = size;
+
+    if (splitRows) {
+      parallelize_tasks(threads, [&](int i) {
+        const Index r0 = bounds[i], r1 = bounds[i + 1];
+        if (r1 > r0) Gemv::run(r1 - r0, cols, lhs.getSubMapper(r0, 0), rhs, res + r0 * resIncr, resIncr, alpha);
+      });
+      return;
+    }
+
+    // The first panel is accumulated into res directly.
+    typedef Map<Matrix<ResScalar, Dynamic, 1> > ResMap;
+    ei_declare_aligned_stack_constructed_variable(ResScalar, partial, rows * (threads - 1), 0);
+    parallelize_tasks(threads, [&](int i) {
+      const Index c0 = bounds[i], c1 = bounds[i + 1];
+      ResScalar* actualRes = i == 0 ? res : partial + rows * (i - 1);
+      if (i > 0) ResMap(actualRes, rows).setZero();
+      if (c1 > c0)
+        Gemv::run(rows, c1 - c0, lhs.getSubMapper(0, c0), rhs.getSubMapper(c0, 0), actualRes, Index(1), alpha);
+    });
+    ResMap result(res, rows);
+    for (int i = 1; i < threads; ++i) result += ResMap(partial + rows * (i - 1), rows);
+  }
+};
+
 }  // end namespace internal
 
 }  // end namespace Eigen
@@ -84,6 +84,33 @@ inline ThreadPool* setGemmThreadPool(ThreadPool* new_pool) {
 
 // Gets the ThreadPool used by Eigen parallel Gemm.
 inline ThreadPool* getGemmThreadPool() { return setGemmThreadPool(nullptr); }
+
+namespace internal {
+inline double* parallel_assignment_threshold() {
+  static double threshold = 0;
+  return &threshold;
+}
+}  // namespace internal
+
+/** Sets the cost above which the coefficient-wise assignments, like `x = a * y + b * z`, are evaluated with the thread
+ * pool of the products, see setGemmThreadPool(). The cost of an assignment is its number of coefficients times the
+ * cost of evaluating and storing one of them, in units of additions. A value of 0, the default, evaluates all of them
+ * in the calling thread.
+ *
+ * Only assignments to dense destinations with a size known at runtime are concerned, and never the ones whose source
+ * evaluates its coefficients in a specific order, like Random() for custom scalar types. Random() for the built-in
+ * types is counter-based, see class RandomStream, so it is multithreaded and gives the same coefficients. As with
+ * setGemmThreadPool(), this function should not be called while an assignment is running.
+ *
+ * \sa parallelAssignmentThreshold(), setNbThreads() */
+inline void setParallelAssignmentThreshold(double cost) {
+  eigen_assert(cost >= 0);
+  *internal::parallel_assignment_threshold() = cost;
+}
+
+/** \returns the cost above which the coefficient-wise assignments are multithreaded, or 0 if they never are.
+ * \sa setParallelAssignmentThreshold() */
+inline double parallelAssignmentThreshold() { return *internal::parallel_assignment_threshold(); }
 #endif
 
 namespace internal {
@@ -109,6 +136,11 @@ EIGEN_STRONG_INLINE void parallelize_gemm(const Functor& func, Index rows, Index
                                           bool /*unused*/) {
   func(0, rows, 0, cols);
 }
+inline int parallel_threads(double /*work*/, double /*min_task_work*/, Index /*max_tasks*/) { return 1; }
+template <typename Functor>
+EIGEN_STRONG_INLINE void parallelize_tasks(int tasks, const Functor& func) {
+  for (int i = 0; i < tasks; ++i) func(i);
+}
 
 #else
 
@@ -121,11 +153,120 @@ struct GemmParallelTaskInfo {
   Index lhs_length;
 };
 
+#if defined(EIGEN_GEMM_THREADPOOL)
+// Shared state of the tile-based ThreadPool scheduler. The (column-major) result is cut into a grid of
+// tile_rows x tile_cols tiles which are claimed one at a time by the participating threads. Tiles are numbered
+// column panel by column panel, such that consecutive tiles share the same rhs panel.
+//
+// The tiles of a column share a single packed copy of their rhs panel. Each of its kc deep blocks is packed by the
+// first thread that needs it while the other ones wait for it, like the lhs blocks of the OpenMP version, and the
+// panel is freed once the last tile of the column is finished. Since that thread is not necessarily the one which
+// allocated the panel, the panels bypass the workspace of the calling thread, see ScopedWorkspace.
+template <typename Index>
+struct GemmParallelTileInfo {
+  GemmParallelTileInfo(Index rows, Index cols, Index depth, Index mc, Index nc, Index kc, Index mr, Index nr,
+                       int threads)
+      : next(0), done(0) {
+    // Start from the cache blocking sizes, and refine the grid until there are enough tiles for every thread to
+    // pick up a few of them. This is what allows fast threads to make up for slow or preempted ones.
+    const Index kTilesPerThread = 4;
+    tile_rows = numext::mini(rows, mc);
+    tile_cols = numext::mini(cols, nc);
+    while (numext::div_ceil(rows, tile_rows) * numext::div_ceil(cols, tile_cols) < kTilesPerThread * threads) {
+      if (tile_cols > 4 * nr)
+        tile_cols = numext::round_down(tile_cols / 2, nr);
+      else if (tile_rows > 4 * mr)
+        tile_rows = numext::round_down(tile_rows / 2, mr);
+      else
+        break;
+    }
+    num_row_tiles = numext::div_ceil(rows, tile_rows);
+    num_col_tiles = numext::div_ceil(cols, tile_cols);
+    num_tiles = num_row_tiles * num_col_tiles;
+    num_depth_blocks = numext::maxi<Index>(1, numext::div_ceil(depth, numext::maxi<Index>(1, kc)));
+
+    rhs_panels.reset(new std::atomic<void*>[num_col_tiles]);
+    rhs_panel_users.reset(new std::atomic<Index>[num_col_tiles]);
+    rhs_block_state.reset(new std::atomic<int>[num_col_tiles * num_depth_blocks]);
+    for (Index c = 0; c < num_col_tiles; ++c) {
+      rhs_panels[c].store(nullptr, std::memory_order_relaxed);
+      rhs_panel_users[c].store(num_row_tiles, std::memory_order_relaxed);
+    }
+    for (Index b = 0; b < num_col_tiles * num_depth_blocks; ++b) rhs_block_state[b].store(kUnpacked);
+  }
+
+  // Frees the panels of the columns whose tiles did not share them, e.g., those of the reduced precision products.
+  ~GemmParallelTileInfo() {
+    for (Index c = 0; c < num_col_tiles; ++c) handmade_aligned_free(rhs_panels[c].load(std::memory_order_relaxed));
+  }
+
+  // Returns the index of the next unclaimed tile, or a value >= num_tiles if all tiles have been handed out.
+  Index claim() { return next.fetch_add(1); }
+
+  // Marks a claimed tile as computed, and wakes up the caller once the last one is done.
+  void finish() {
+    if (done.fetch_add(1) + 1 == num_tiles) all_done.Notify();
+  }
+
+  // Returns the packed rhs panel of the column of tiles, of the given size in bytes, allocating it on first use.
+  void* rhsPanel(Index col_tile, std::size_t bytes) {
+    void* panel = rhs_panels[col_tile].load(std::memory_order_acquire);
+    if (panel != nullptr) return panel;
+    void* fresh = handmade_aligned_malloc(bytes);
+    if (!fresh) throw_std_bad_alloc();
+    if (rhs_panels[col_tile].compare_exchange_strong(panel, fresh, std::memory_order_acq_rel)) return fresh;
+    handmade_aligned_free(fresh);
+    return panel;
+  }
+
+  // Returns true if the caller has to pack the depth block of the rhs panel, and to call rhsBlockPacked() afterwards.
+  // Otherwise, returns once the block has been packed by another thread.
+  bool claimRhsBlock(Index col_tile, Index depth_block) {
+    std::atomic<int>& state = rhs_block_state[col_tile * num_depth_blocks + depth_block];
+    int expected = kUnpacked;
+    if (state.load(std::memory_order_acquire) == kPacked) return false;
+    if (state.compare_exchange_strong(expected, kPacking, std::memory_order_acq_rel)) return true;
+    while (state.load(std::memory_order_acquire) != kPacked) EIGEN_THREAD_YIELD();
+    return false;
+  }
+
+  void rhsBlockPacked(Index col_tile, Index depth_block) {
+    rhs_block_state[col_tile * num_depth_blocks + depth_block].store(kPacked, std::memory_order_release);
+  }
+
+  // Called by each tile of the column once it no longer reads the rhs panel, the last one frees it.
+  void releaseRhsPanel(Index col_tile) {
+    if (rhs_panel_users[col_tile].fetch_sub(1, std::memory_order_acq_rel) == 1)
+      handmade_aligned_free(rhs_panels[col_tile].exchange(nullptr, std::memory_order_acq_rel));
+  }
+
+  enum { kUnpacked = 0, kPacking = 1, kPacked = 2 };
+
+  Index tile_rows;
+  Index tile_cols;
+  Index num_row_tiles;
+  Index num_col_tiles;
+  Index num_tiles;
+  Index num_depth_blocks;
+  std::atomic<Index> next;
+  std::atomic<Index> done;
+  Notification all_done;
+  std::unique_ptr<std::atomic<void*>[]> rhs_panels;
+  std::unique_ptr<std::atomic<Index>[]> rhs_panel_users;
+  std::unique_ptr<std::atomic<int>[]> rhs_block_state;
+};
+#endif
+
 template <typename Index>
 struct GemmParallelInfo {
   const int logical_thread_id;
   const int num_threads;
   GemmParallelTaskInfo<Index>* task_info;
+#if defined(EIGEN_GEMM_THREADPOOL)
+  // Shared tile grid, and the first tile that was already claimed by the calling thread.
+  GemmParallelTileInfo<Index>* tile_info = nullptr;
+  Index first_tile = 0;
+#endif
 
   GemmParallelInfo(int logical_thread_id_, int num_threads_, GemmParallelTaskInfo<Index>* task_info_)
       : logical_thread_id(logical_thread_id_), num_threads(num_threads_), task_info(task_info_) {}
@@ -188,22 +329,22 @@ EIGEN_STRONG_INLINE void parallelize_gemm(const Functor& func, Index rows, Index
   // don't parallelize if we are executing in a parallel context already.
   dont_parallelize |= omp_get_num_threads() > 1;
 #elif defined(EIGEN_GEMM_THREADPOOL)
-  // don't parallelize if we have a trivial threadpool or the current thread id
-  // is != -1, indicating that we are already executing on a thread inside the pool.
-  // In other words, we do not allow nested parallelism, since this would lead to
-  // deadlocks due to the workstealing nature of the threadpool.
+  // don't parallelize if we have a trivial threadpool.
+  // Note that nested parallelism is allowed: when called from a thread inside the pool, the calling worker
+  // computes tiles itself while the idle workers steal the helper tasks from its queue. This cannot deadlock,
+  // since the caller only ever waits for tiles that are already being computed by running threads.
   ThreadPool* pool = getGemmThreadPool();
-  dont_parallelize |= (pool == nullptr || pool->CurrentThreadId() != -1);
+  dont_parallelize |= (pool == nullptr);
 #endif
   if (dont_parallelize) return func(0, rows, 0, cols);
 
-  func.initParallelSession(threads);
-
   if (transpose) std::swap(rows, cols);
 
+#if defined(EIGEN_HAS_OPENMP)
+  func.initParallelSession(threads);
+
   ei_declare_aligned_stack_constructed_variable(GemmParallelTaskInfo<Index>, task_info, threads, 0);
 
-#if defined(EIGEN_HAS_OPENMP)
 #pragma omp parallel num_threads(threads)
   {
     Index i = omp_get_thread_num();
@@ -232,42 +373,159 @@ EIGEN_STRONG_INLINE void parallelize_gemm(const Functor& func, Index rows, Index
   }
 
 #elif defined(EIGEN_GEMM_THREADPOOL)
-  ei_declare_aligned_stack_constructed_variable(GemmParallelTaskInfo<Index>, meta_info, threads, 0);
-  Barrier barrier(threads);
-  auto task = [=, &func, &barrier, &task_info](int i) {
-    Index actual_threads = threads;
-    GemmParallelInfo<Index> info(i, static_cast<int>(actual_threads), task_info);
-    Index blockCols = (cols / actual_threads) & ~Index(0x3);
-    Index blockRows = (rows / actual_threads);
-    blockRows = (blockRows / Functor::Traits::mr) * Functor::Traits::mr;
-
-    Index r0 = i * blockRows;
-    Index actualBlockRows = (i + 1 == actual_threads) ? rows - r0 : blockRows;
-
-    Index c0 = i * blockCols;
-    Index actualBlockCols = (i + 1 == actual_threads) ? cols - c0 : blockCols;
-
-    info.task_info[i].lhs_start = r0;
-    info.task_info[i].lhs_length = actualBlockRows;
-
+  // Unlike the OpenMP version above, which gives each thread a fixed slab of the result, the ThreadPool version cuts
+  // the result into (mc x nc) tiles that the participating threads claim one by one. Each tile packs its own lhs
+  // block, and shares the packed rhs panel of its column with the other tiles of the column (see
+  // GemmParallelTileInfo). So a slow or preempted thread only delays the single tile it is working on, or the other
+  // tiles of the column while it packs one of their rhs blocks, and the remaining tiles are picked up by the others.
+  //
+  // The tile state is reference counted, and a task only touches func (which lives on this stack frame) after it
+  // has successfully claimed a tile. Since we do not return before every claimed tile is finished, tasks that are
+  // only dequeued by the pool after the whole product is done simply find no work and exit.
+  std::shared_ptr<GemmParallelTileInfo<Index>> tile_info = std::make_shared<GemmParallelTileInfo<Index>>(
+      rows, cols, depth, func.mc(), func.nc(), func.kc(), Index(Functor::Traits::mr), Index(Functor::Traits::nr),
+      threads);
+  auto task = [=, &func](int i) {
+    Index first_tile = tile_info->claim();
+    if (first_tile >= tile_info->num_tiles) return;
+    GemmParallelInfo<Index> info(i, threads, nullptr);
+    info.tile_info = tile_info.get();
+    info.first_tile = first_tile;
     if (transpose)
-      func(c0, actualBlockCols, 0, rows, &info);
+      func(0, cols, 0, rows, &info);
     else
-      func(0, rows, c0, actualBlockCols, &info);
-
-    barrier.Notify();
+      func(0, rows, 0, cols, &info);
   };
   // Notice that we do not schedule more than "threads" tasks, which allows us to
   // limit number of running threads, even if the threadpool itself was constructed
   // with a larger number of threads.
   for (int i = 0; i < threads - 1; ++i) {
-    pool->Schedule([=, task = std::move(task)] { task(i); });
+    pool->Schedule([=] { task(i); });
   }
   task(threads - 1);
-  barrier.Wait();
+  tile_info->all_done.Wait();
 #endif
 }
 
+/* Returns the number of threads worth running an operation made of the given amount of work, which can be split into
+ * at most max_tasks independent tasks of at least min_task_work each. Returns 1 if the operation has to run in the
+ * calling thread, e.g., if it is already running within a parallel OpenMP region, or if there is no thread pool. */
+inline int parallel_threads(double work, double min_task_work, Index max_tasks) {
+  Index max_threads = numext::mini<Index>(max_tasks, static_cast<Index>(work / min_task_work));
+  // Small operations are the common case, skip querying the threading setup for them.
+  if (max_threads <= 1) return 1;
+#if defined(EIGEN_HAS_OPENMP)
+  if (omp_get_num_threads() > 1) return 1;
+#elif defined(EIGEN_GEMM_THREADPOOL)
+  if (getGemmThreadPool() == nullptr) return 1;
+#endif
+  return numext::maxi(static_cast<int>(numext::mini<Index>(nbThreads(), max_threads)), 1);
+}
+
+#if defined(EIGEN_GEMM_THREADPOOL)
+struct ParallelTasksInfo {
+  explicit ParallelTasksInfo(int tasks_) : tasks(tasks_), next(0), done(0) {}
+  const int tasks;
+  std::atomic<int> next;
+  std::atomic<int> done;
+  Notification all_done;
+};
+#endif
+
+/* Calls func(i) for every i in [0, tasks) from up to tasks threads, and returns once all the calls are done. The calls
+ * must be independent from each other, and tasks is usually obtained from parallel_threads(). */
+template <typename Functor>
+void parallelize_tasks(int tasks, const Functor& func) {
+  if (tasks <= 1) {
+    if (tasks == 1) func(0);
+    return;
+  }
+#if defined(EIGEN_HAS_OPENMP)
+#pragma omp parallel for num_threads(tasks) schedule(static, 1)
+  for (int i = 0; i < tasks; ++i) func(i);
+#elif defined(EIGEN_GEMM_THREADPOOL)
+  // As in parallelize_gemm, the tasks are claimed one by one, such that the calling thread never waits for a task
+  // that is still queued in the pool, and helpers dequeued after all the tasks are done exit without touching func.
+  std::shared_ptr<ParallelTasksInfo> info = std::make_shared<ParallelTasksInfo>(tasks);
+  auto worker = [info, &func]() {
+    for (int i = info->next.fetch_add(1); i < info->tasks; i = info->next.fetch_add(1)) {
+      func(i);
+      if (info->done.fetch_add(1) + 1 == info->tasks) info->all_done.Notify();
+    }
+  };
+  ThreadPool* pool = getGemmThreadPool();
+  for (int i = 0; i < tasks - 1; ++i) pool->Schedule(worker);
+  worker();
+  info->all_done.Wait();
+#endif
+}
+
+#endif
+
+/* Splits [0, size) into parts consecutive ranges of about the same amount of work, for operations whose work is not
+ * evenly spread, like triangular ones. work(i) returns the amount of work of the first i items, and must be
+ * nondecreasing. The bounds of the ranges are stored in bounds[0..parts], rounded down to multiples of granularity,
+ * such that some of the ranges might be empty. */
+template <typename Index, typename Work>
+void balanced_partition(Index size, int parts, Index granularity, const Work& work, Index* bounds) {
+  const double total = static_cast<double>(work(size));
+  bounds[0] = 0;
+  for (int p = 1; p < parts; ++p) {
+    const double target = total * p / parts;
+    Index lo = bounds[p - 1], hi = size;
+    while (lo < hi) {
+      const Index mid = lo + (hi - lo) / 2;
+      if (static_cast<double>(work(mid)) < target)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    bounds[p] = numext::maxi(bounds[p - 1], numext::round_down(lo, granularity));
+  }
+  bounds[parts] = size;
+}
+
+#if defined(EIGEN_GEMM_THREADPOOL)
+template <typename Kernel, typename EnableIf>
+struct parallel_dense_assignment_loop {
+  static bool run(Kernel&) { return false; }
+};
+
+// Completely unrolled assignments are too small to be worth it, and the sources flagged with EvalBeforeNestingBit
+// may not be evaluated out of order.
+template <typename Kernel>
+struct parallel_dense_assignment_loop<
+    Kernel, std::enable_if_t<int(Kernel::AssignmentTraits::Unrolling) != int(CompleteUnrolling) &&
+                             !(int(Kernel::SrcEvaluatorType::Flags) & EvalBeforeNestingBit)>> {
+  static bool run(Kernel& kernel) {
+    const double threshold = parallelAssignmentThreshold();
+    if (threshold <= 0 || nbThreads() <= 1) return false;
+    if (static_cast<double>(kernel.size()) * static_cast<double>(cost_helper<Kernel>::Cost) < threshold) return false;
+    // Assignments running within the pool, e.g., in the tasks of a product, stay in their thread.
+    ThreadPool* pool = getGemmThreadPool();
+    if (pool == nullptr || pool->CurrentThreadId() != -1) return false;
+    CoreThreadPoolDevice device(*pool);
+    dense_assignment_loop_with_device<Kernel, CoreThreadPoolDevice>::run(kernel, device);
+    return true;
+  }
+};
+#endif
+
+#ifdef EIGEN_HUGE_PAGES_ENABLED
+/* Touches the pages of the size bytes at ptr, a multiple of granularity, from the threads of the products. As the
+ * OpenMP products give each thread a contiguous slab of the columns of their (column-major) result, every thread
+ * touches a contiguous part of the buffer, which the first-touch NUMA policy places on its node. */
+inline void first_touch(void* ptr, std::size_t size, std::size_t granularity) {
+  const Index chunks = static_cast<Index>(size / granularity);
+  const int threads = parallel_threads(static_cast<double>(size), static_cast<double>(granularity), chunks);
+  volatile uint8_t* bytes = static_cast<uint8_t*>(ptr);
+  const std::size_t page = system_page_size();
+  parallelize_tasks(threads, [&](int t) {
+    const std::size_t begin = static_cast<std::size_t>(chunks * t / threads) * granularity;
+    const std::size_t end = static_cast<std::size_t>(chunks * (t + 1) / threads) * granularity;
+    for (std::size_t offset = begin; offset < end; offset += page) bytes[offset] = 0;
+  });
+}
 #endif
 
 }  // end namespace internal
@@ -0,0 +1,310 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_QUANTIZED_MATRIX_MATRIX_H
+#define EIGEN_QUANTIZED_MATRIX_MATRIX_H
+
+// IWYU pragma: private
+#include "../InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+#if defined(EIGEN_VECTORIZE_AVX2)
+
+/*  AVX2 micro-kernel of the 8-bit product. pmaddubsw cannot be used on full range operands, since its pairwise sums
+ *  of u8*s8 products saturate at 16 bits, so the blocks are instead packed as int16_t pairs of consecutive depth
+ *  indices and multiplied with pmaddwd, which sums each pair exactly into an int32_t lane. Each step of the kernel
+ *  thus performs mr*nr*2 multiply-adds with 2*nr pmaddwd, on packed operands of half the size of the int32_t ones. */
+template <typename Index>
+struct quantized_gebp_kernel {
+  enum { mr = 16, nr = 4 };
+
+  static Index pairs(Index depth) { return (depth + 1) / 2; }
+  static std::size_t lhsSize(Index rows, Index depth) {
+    return std::size_t(numext::div_ceil(rows, Index(mr))) * mr * 2 * pairs(depth);
+  }
+  static std::size_t rhsSize(Index depth, Index cols) {
+    return std::size_t(numext::div_ceil(cols, Index(nr))) * nr * pairs(depth);
+  }
+
+  // Packs the block into panels of mr rows storing, for each pair of depth indices, the mr pairs (lhs(i,k), lhs(i,k+1))
+  // contiguously. Rows and depth are zero padded.
+  template <typename Block>
+  static void packLhs(int16_t* blockA, const Block& lhs) {
+    const Index rows = lhs.rows(), depth = lhs.cols();
+    for (Index i = 0; i < rows; i += mr) {
+      const Index panel_rows = (std::min)(Index(mr), rows - i);
+      for (Index k = 0; k < depth; k += 2, blockA += 2 * mr) {
+        for (Index r = 0; r < mr; ++r) {
+          blockA[2 * r] = r < panel_rows ? int16_t(lhs.coeff(i + r, k)) : int16_t(0);
+          blockA[2 * r + 1] = r < panel_rows && k + 1 < depth ? int16_t(lhs.coeff(i + r, k + 1)) : int16_t(0);
+        }
+      }
+    }
+  }
+
+  // Packs the block into panels of nr columns storing, for each pair of depth indices, the nr pairs
+  // (rhs(k,j), rhs(k+1,j)) as the low and high halves of an int32_t. Columns and depth are zero padded.
+  template <typename Block>
+  static void packRhs(int32_t* blockB, const Block& rhs) {
+    const Index depth = rhs.rows(), cols = rhs.cols();
+    for (Index j = 0; j < cols; j += nr) {
+      const Index panel_cols = (std::min)(Index(nr), cols - j);
+      for (Index k = 0; k < depth; k += 2, blockB += nr) {
+        for (Index c = 0; c < nr; ++c) {
+          const bool in_col = c < panel_cols;
+          const uint16_t lo = in_col ? uint16_t(int16_t(rhs.coeff(k, j + c))) : uint16_t(0);
+          const uint16_t hi = in_col && k + 1 < depth ? uint16_t(int16_t(rhs.coeff(k + 1, j + c))) : uint16_t(0);
+          blockB[c] = int32_t(uint32_t(lo) | (uint32_t(hi) << 16));
+        }
+      }
+    }
+  }
+
+  // res += A * B for a rows x depth packed block A and a depth x cols packed block B, res being column-major.
+  static void run(int32_t* res, Index resStride, const int16_t* blockA, const int32_t* blockB, Index rows, Index depth,
+                  Index cols) {
+    const Index num_pairs = pairs(depth);
+    for (Index j = 0; j < cols; j += nr) {
+      const Index panel_cols = (std::min)(Index(nr), cols - j);
+      for (Index i = 0; i < rows; i += mr) {
+        const Index panel_rows = (std::min)(Index(mr), rows - i);
+        const int16_t* A = blockA + i * 2 * num_pairs;
+        const int32_t* B = blockB + j * num_pairs;
+        __m256i acc[2][nr];
+        EIGEN_UNROLL_LOOP
+        for (int c = 0; c < nr; ++c) acc[0][c] = acc[1][c] = _mm256_setzero_si256();
+        for (Index p = 0; p < num_pairs; ++p, A += 2 * mr, B += nr) {
+          const __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(A));
+          const __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(A + mr));
+          EIGEN_UNROLL_LOOP
+          for (int c = 0; c < nr; ++c) {
+            const __m256i b = _mm256_set1_epi32(B[c]);
+            acc[0][c] = _mm256_add_epi32(acc[0][c], _mm256_madd_epi16(a0, b));
+            acc[1][c] = _mm256_add_epi32(acc[1][c], _mm256_madd_epi16(a1, b));
+          }
+        }
+        for (Index c = 0; c < panel_cols; ++c) {
+          int32_t* r = res + i + (j + c) * resStride;
+          if (panel_rows == mr) {
+            __m256i* r0 = reinterpret_cast<__m256i*>(r);
+            __m256i* r1 = reinterpret_cast<__m256i*>(r + 8);
+            _mm256_storeu_si256(r0, _mm256_add_epi32(_mm256_loadu_si256(r0), acc[0][c]));
+            _mm256_storeu_si256(r1, _mm256_add_epi32(_mm256_loadu_si256(r1), acc[1][c]));
+          } else {
+            EIGEN_ALIGN32 int32_t tile[mr];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(tile), acc[0][c]);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(tile + 8), acc[1][c]);
+            for (Index k = 0; k < panel_rows; ++k) r[k] += tile[k];
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif
+
+/*  Product of two matrices of 8-bit integers (int8_t or uint8_t) accumulated in int32_t:
+ *    res += lhs * rhs
+ *  The operands are read block by block following the same blocking as the general matrix-matrix product. With AVX2,
+ *  the blocks are packed as int16_t pairs for quantized_gebp_kernel. Otherwise, every block is widened to int32_t in a
+ *  cache-resident buffer right before being packed, such that the memory traffic on the operands stays at the size of
+ *  the narrow type and the int32_t GEBP kernel can be used as is. */
+template <typename Index, typename LhsScalar, int LhsStorageOrder, typename RhsScalar, int RhsStorageOrder>
+struct quantized_matrix_matrix_product {
+  typedef int32_t AccScalar;
+  typedef gebp_traits<AccScalar, AccScalar> Traits;
+
+  static void run(Index rows, Index cols, Index depth, const LhsScalar* lhs_, Index lhsStride, const RhsScalar* rhs_,
+                  Index rhsStride, AccScalar* res_, Index resStride, level3_blocking<AccScalar, AccScalar>& blocking) {
+    typedef Map<const Matrix<LhsScalar, Dynamic, Dynamic, LhsStorageOrder>, 0, OuterStride<> > LhsMap;
+    typedef Map<const Matrix<RhsScalar, Dynamic, Dynamic, RhsStorageOrder>, 0, OuterStride<> > RhsMap;
+    LhsMap lhs(lhs_, rows, depth, OuterStride<>(lhsStride));
+    RhsMap rhs(rhs_, depth, cols, OuterStride<>(rhsStride));
+
+    Index kc = blocking.kc();
+    Index mc = (std::min)(rows, blocking.mc());
+    Index nc = (std::min)(cols, blocking.nc());
+
+#if defined(EIGEN_VECTORIZE_AVX2)
+    typedef quantized_gebp_kernel<Index> Kernel;
+    ei_declare_aligned_stack_constructed_variable(int16_t, blockA, Kernel::lhsSize(mc, kc), 0);
+    ei_declare_aligned_stack_constructed_variable(int32_t, blockB, Kernel::rhsSize(kc, nc), 0);
+
+    for (Index i2 = 0; i2 < rows; i2 += mc) {
+      const Index actual_mc = (std::min)(i2 + mc, rows) - i2;
+      for (Index k2 = 0; k2 < depth; k2 += kc) {
+        const Index actual_kc = (std::min)(k2 + kc, depth) - k2;
+        Kernel::packLhs(blockA, lhs.block(i2, k2, actual_mc, actual_kc));
+        for (Index j2 = 0; j2 < cols; j2 += nc) {
+          const Index actual_nc = (std::min)(j2 + nc, cols) - j2;
+          Kernel::packRhs(blockB, rhs.block(k2, j2, actual_kc, actual_nc));
+          Kernel::run(res_ + i2 + j2 * resStride, resStride, blockA, blockB, actual_mc, actual_kc, actual_nc);
+        }
+      }
+    }
+#else
+    typedef Map<Matrix<AccScalar, Dynamic, Dynamic, ColMajor> > WideMap;
+    typedef const_blas_data_mapper<AccScalar, Index, ColMajor> WideMapper;
+    typedef blas_data_mapper<AccScalar, Index, ColMajor> ResMapper;
+    ResMapper res(res_, resStride);
+
+    std::size_t sizeA = kc * mc;
+    std::size_t sizeB = kc * nc;
+    ei_declare_aligned_stack_constructed_variable(AccScalar, blockA, sizeA, blocking.blockA());
+    ei_declare_aligned_stack_constructed_variable(AccScalar, blockB, sizeB, blocking.blockB());
+    ei_declare_aligned_stack_constructed_variable(AccScalar, wideA, sizeA, 0);
+    ei_declare_aligned_stack_constructed_variable(AccScalar, wideB, sizeB, 0);
+
+    gemm_pack_lhs<AccScalar, Index, WideMapper, Traits::mr, Traits::LhsProgress, typename Traits::LhsPacket4Packing,
+                  ColMajor>
+        pack_lhs;
+    gemm_pack_rhs<AccScalar, Index, WideMapper, Traits::nr, ColMajor> pack_rhs;
+    gebp_kernel<AccScalar, AccScalar, Index, ResMapper, Traits::mr, Traits::nr, false, false> gebp;
+
+    for (Index i2 = 0; i2 < rows; i2 += mc) {
+      const Index actual_mc = (std::min)(i2 + mc, rows) - i2;
+      for (Index k2 = 0; k2 < depth; k2 += kc) {
+        const Index actual_kc = (std::min)(k2 + kc, depth) - k2;
+        WideMap(wideA, actual_mc, actual_kc) = lhs.block(i2, k2, actual_mc, actual_kc).template cast<AccScalar>();
+        pack_lhs(blockA, WideMapper(wideA, actual_mc), actual_kc, actual_mc);
+        for (Index j2 = 0; j2 < cols; j2 += nc) {
+          const Index actual_nc = (std::min)(j2 + nc, cols) - j2;
+          WideMap(wideB, actual_kc, actual_nc) = rhs.block(k2, j2, actual_kc, actual_nc).template cast<AccScalar>();
+          pack_rhs(blockB, WideMapper(wideB, actual_kc), actual_kc, actual_nc);
+          gebp(res.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, AccScalar(1));
+        }
+      }
+    }
+#endif
+  }
+};
+
+template <typename Lhs, typename Rhs>
+void quantized_product_impl(const Lhs& a_lhs, const Rhs& a_rhs, Ref<Matrix<int32_t, Dynamic, Dynamic> > acc) {
+  typedef typename Lhs::Scalar LhsScalar;
+  typedef typename Rhs::Scalar RhsScalar;
+  EIGEN_STATIC_ASSERT(NumTraits<LhsScalar>::IsInteger && NumTraits<RhsScalar>::IsInteger && sizeof(LhsScalar) == 1 &&
+                          sizeof(RhsScalar) == 1,
+                      THIS_METHOD_IS_ONLY_FOR_SMALL_INTEGER_TYPES)
+  enum {
+    LhsStorageOrder = Lhs::IsRowMajor ? RowMajor : ColMajor,
+    RhsStorageOrder = Rhs::IsRowMajor ? RowMajor : ColMajor
+  };
+  const Ref<const Matrix<LhsScalar, Dynamic, Dynamic, LhsStorageOrder>, 0, OuterStride<> > lhs(a_lhs);
+  const Ref<const Matrix<RhsScalar, Dynamic, Dynamic, RhsStorageOrder>, 0, OuterStride<> > rhs(a_rhs);
+  eigen_assert(lhs.cols() == rhs.rows() && acc.rows() == lhs.rows() && acc.cols() == rhs.cols());
+
+  acc.setZero();
+  if (lhs.rows() == 0 || rhs.cols() == 0 || lhs.cols() == 0) return;
+
+  gemm_blocking_space<ColMajor, int32_t, int32_t, Dynamic, Dynamic, Dynamic> blocking(acc.rows(), acc.cols(),
+                                                                                      lhs.cols(), 1, true);
+  quantized_matrix_matrix_product<Index, LhsScalar, LhsStorageOrder, RhsScalar, RhsStorageOrder>::run(
+      lhs.rows(), rhs.cols(), lhs.cols(), lhs.data(), lhs.outerStride(), rhs.data(), rhs.outerStride(), acc.data(),
+      acc.outerStride(), blocking);
+}
+
+// Accumulates directly into column-major destinations, and through a temporary otherwise.
+template <typename Dest, bool DestIsColMajor>
+struct quantized_product_dest {
+  template <typename Lhs, typename Rhs>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& dst) {
+    quantized_product_impl(lhs, rhs, dst);
+  }
+};
+
+template <typename Dest>
+struct quantized_product_dest<Dest, false> {
+  template <typename Lhs, typename Rhs>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& dst) {
+    Matrix<int32_t, Dynamic, Dynamic> acc(lhs.rows(), rhs.cols());
+    quantized_product_impl(lhs, rhs, acc);
+    dst = acc;
+  }
+};
+
+}  // end namespace internal
+
+/** \ingroup Core_Module
+ *
+ * Computes the exact product \a dst = \a lhs * \a rhs of two matrices of 8 bit integers (\c int8_t or \c uint8_t)
+ * with 32 bit integer accumulation. \a dst can be any writable int32 expression, e.g. a block of a larger matrix.
+ *
+ * The operands are widened block by block inside the matrix-matrix product, such that no full-size int32
+ * copy of \a lhs or \a rhs is ever created, as it would be with <tt>lhs.cast<int32_t>() * rhs.cast<int32_t>()</tt>.
+ * The int32 accumulators cannot overflow as long as the depth is at most INT32_MAX / max|lhs_ik * rhs_kj|, i.e.,
+ * 131071 for two \c int8_t operands, 65793 for an \c int8_t and a \c uint8_t operand, and 33025 for two \c uint8_t
+ * operands. Deeper products are the responsibility of the caller.
+ *
+ * \sa quantizedProduct(const MatrixBase<Lhs>&, const LhsZeroPoints&, const LhsScales&, const MatrixBase<Rhs>&,
+ *     const RhsZeroPoints&, const RhsScales&, const MatrixBase<Dest>&)
+ */
+template <typename Lhs, typename Rhs, typename Dest>
+void quantizedProduct(const MatrixBase<Lhs>& lhs, const MatrixBase<Rhs>& rhs, const MatrixBase<Dest>& a_dst) {
+  Dest& dst = a_dst.const_cast_derived();
+  EIGEN_STATIC_ASSERT((internal::is_same<typename Dest::Scalar, int32_t>::value),
+                      YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+  dst.resize(lhs.rows(), rhs.cols());
+  enum {
+    DestIsColMajor = (int(Dest::Flags) & DirectAccessBit) && !(int(Dest::Flags) & RowMajorBit) &&
+                     int(internal::inner_stride_at_compile_time<Dest>::ret) == 1
+  };
+  internal::quantized_product_dest<Dest, bool(DestIsColMajor)>::run(lhs.derived(), rhs.derived(), dst);
+}
+
+/** \ingroup Core_Module
+ *
+ * Computes the product of two affinely quantized matrices and returns it in floating point:
+ * \f[ dst_{ij} = s^{lhs}_i \, s^{rhs}_j \sum_k (lhs_{ik} - z^{lhs}_i)(rhs_{kj} - z^{rhs}_j) \f]
+ * where \f$ z^{lhs} \f$ and \f$ s^{lhs} \f$ are the per-row zero-points and scales of \a lhs, and
+ * \f$ z^{rhs} \f$ and \f$ s^{rhs} \f$ the per-column zero-points and scales of \a rhs. Per-tensor quantization
+ * parameters are obtained by passing constant vectors.
+ *
+ * The integer product is accumulated in int32 as in quantizedProduct(const MatrixBase<Lhs>&, const MatrixBase<Rhs>&,
+ * const MatrixBase<Dest>&), and the zero-point corrections and scaling are then applied in a single pass over the
+ * result, using the row sums of \a lhs and the column sums of \a rhs.
+ */
+template <typename Lhs, typename LhsZeroPoints, typename LhsScales, typename Rhs, typename RhsZeroPoints,
+          typename RhsScales, typename Dest>
+void quantizedProduct(const MatrixBase<Lhs>& lhs, const LhsZeroPoints& lhsZeroPoints, const LhsScales& lhsScales,
+                      const MatrixBase<Rhs>& rhs, const RhsZeroPoints& rhsZeroPoints, const RhsScales& rhsScales,
+                      const MatrixBase<Dest>& a_dst) {
+  Dest& dst = a_dst.const_cast_derived();
+  typedef typename Dest::Scalar Scalar;
+  typedef Matrix<int32_t, Dynamic, 1> IntVector;
+  typedef Matrix<Scalar, Dynamic, 1> ScalarVector;
+  const Index rows = lhs.rows(), cols = rhs.cols(), depth = lhs.cols();
+  eigen_assert(lhsZeroPoints.size() == rows && lhsScales.size() == rows);
+  eigen_assert(rhsZeroPoints.size() == cols && rhsScales.size() == cols);
+
+  Matrix<int32_t, Dynamic, Dynamic> acc(rows, cols);
+  internal::quantized_product_impl(lhs.derived(), rhs.derived(), acc);
+
+  const IntVector lhsZero = lhsZeroPoints.template cast<int32_t>();
+  const IntVector lhsRowSums = lhs.template cast<int32_t>().rowwise().sum();
+  const IntVector rhsColSums = rhs.template cast<int32_t>().colwise().sum().transpose();
+  const ScalarVector lhsScale = lhsScales.template cast<Scalar>();
+
+  // sum_k (a_ik - za_i)(b_kj - zb_j) = acc_ij - zb_j * rowsum(a)_i - za_i * (colsum(b)_j - depth * zb_j)
+  dst.resize(rows, cols);
+  for (Index j = 0; j < cols; ++j) {
+    const int32_t zb = static_cast<int32_t>(rhsZeroPoints.coeff(j));
+    const int32_t correction = rhsColSums.coeff(j) - static_cast<int32_t>(depth) * zb;
+    dst.col(j) = static_cast<Scalar>(rhsScales.coeff(j)) *
+                 lhsScale.cwiseProduct((acc.col(j) - zb * lhsRowSums - correction * lhsZero).template cast<Scalar>());
+  }
+}
+
+}  // end namespace Eigen
+
+#endif  // EIGEN_QUANTIZED_MATRIX_MATRIX_H
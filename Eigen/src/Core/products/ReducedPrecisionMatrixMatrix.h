@@ -0,0 +1,144 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_REDUCED_PRECISION_MATRIX_MATRIX_H
+#define EIGEN_REDUCED_PRECISION_MATRIX_MATRIX_H
+
+// IWYU pragma: private
+#include "../InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+// On x86, products of bfloat16 and half matrices are computed by the float GEBP kernel with float accumulation,
+// instead of the generic kernel which rounds every partial sum back to 16 bits.
+#if defined(EIGEN_VECTORIZE_AVX) && !defined(EIGEN_USE_BLAS)
+
+/*  Product of two matrices of 16-bit floating point numbers accumulated in float:
+ *    res += alpha * lhs * rhs
+ *  Each cache block of the result is accumulated in a float buffer over the whole depth, and rounded only once when
+ *  it is written back. The operand blocks are widened to float with packet conversions right before being packed,
+ *  such that the memory traffic on the operands stays at 16 bits per coefficient. */
+template <typename Index, typename Scalar, int LhsStorageOrder, int RhsStorageOrder, int ResInnerStride>
+struct reduced_precision_matrix_matrix_product {
+  typedef float AccScalar;
+  typedef gebp_traits<AccScalar, AccScalar> Traits;
+
+  static void run(Index rows, Index cols, Index depth, const Scalar* lhs, Index lhsStride, const Scalar* rhs,
+                  Index rhsStride, Scalar* res, Index resIncr, Index resStride, Scalar alpha,
+                  level3_blocking<Scalar, Scalar>& blocking, GemmParallelInfo<Index>* info = 0) {
+    run(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resIncr, resStride, alpha, blocking, info,
+        gemm_no_epilogue());
+  }
+
+  template <typename Epilogue>
+  static void run(Index rows, Index cols, Index depth, const Scalar* lhs_, Index lhsStride, const Scalar* rhs_,
+                  Index rhsStride, Scalar* res_, Index resIncr, Index resStride, Scalar alpha,
+                  level3_blocking<Scalar, Scalar>& /*blocking*/, GemmParallelInfo<Index>* info,
+                  const Epilogue& epilogue) {
+    typedef Map<const Matrix<Scalar, Dynamic, Dynamic, LhsStorageOrder>, 0, OuterStride<> > LhsMap;
+    typedef Map<const Matrix<Scalar, Dynamic, Dynamic, RhsStorageOrder>, 0, OuterStride<> > RhsMap;
+    typedef Map<Matrix<Scalar, Dynamic, Dynamic>, 0, Stride<Dynamic, ResInnerStride> > ResMap;
+    typedef Map<Matrix<AccScalar, Dynamic, Dynamic> > WideMap;
+    typedef const_blas_data_mapper<AccScalar, Index, ColMajor> WideMapper;
+    typedef blas_data_mapper<AccScalar, Index, ColMajor> AccMapper;
+    LhsMap lhs(lhs_, rows, depth, OuterStride<>(lhsStride));
+    RhsMap rhs(rhs_, depth, cols, OuterStride<>(rhsStride));
+    ResMap res(res_, rows, cols, Stride<Dynamic, ResInnerStride>(resStride, resIncr));
+
+    // The blocking of the 16-bit product would overflow the caches with the widened float blocks.
+    Index kc = depth, mc = rows, nc = cols;
+    computeProductBlockingSizes<AccScalar, AccScalar>(kc, mc, nc);
+    Index tile_mc = mc, tile_nc = nc;
+    Index first_tile = 0;
+    Index num_row_tiles = numext::div_ceil(rows, mc);
+    Index num_tiles = num_row_tiles * numext::div_ceil(cols, nc);
+#if defined(EIGEN_GEMM_THREADPOOL)
+    GemmParallelTileInfo<Index>* tiles = info ? info->tile_info : 0;
+    if (tiles) {
+      // The tiles of the result are claimed one by one as in the general matrix-matrix product.
+      tile_mc = tiles->tile_rows;
+      tile_nc = tiles->tile_cols;
+      first_tile = info->first_tile;
+      num_row_tiles = tiles->num_row_tiles;
+      num_tiles = tiles->num_tiles;
+    }
+#else
+    // Every OpenMP thread receives its own slab of the result, which is computed independently.
+    EIGEN_UNUSED_VARIABLE(info);
+#endif
+
+    std::size_t sizeA = kc * tile_mc;
+    std::size_t sizeB = kc * tile_nc;
+    std::size_t sizeAcc = tile_mc * tile_nc;
+    ei_declare_aligned_stack_constructed_variable(AccScalar, blockA, sizeA, 0);
+    ei_declare_aligned_stack_constructed_variable(AccScalar, blockB, sizeB, 0);
+    ei_declare_aligned_stack_constructed_variable(AccScalar, wideA, sizeA, 0);
+    ei_declare_aligned_stack_constructed_variable(AccScalar, wideB, sizeB, 0);
+    ei_declare_aligned_stack_constructed_variable(AccScalar, acc, sizeAcc, 0);
+
+    gemm_pack_lhs<AccScalar, Index, WideMapper, Traits::mr, Traits::LhsProgress, typename Traits::LhsPacket4Packing,
+                  ColMajor>
+        pack_lhs;
+    gemm_pack_rhs<AccScalar, Index, WideMapper, Traits::nr, ColMajor> pack_rhs;
+    gebp_kernel<AccScalar, AccScalar, Index, AccMapper, Traits::mr, Traits::nr, false, false> gebp;
+
+    for (Index t = first_tile; t < num_tiles;) {
+      const Index i2 = (t % num_row_tiles) * tile_mc;
+      const Index j2 = (t / num_row_tiles) * tile_nc;
+      const Index actual_mc = (std::min)(i2 + tile_mc, rows) - i2;
+      const Index actual_nc = (std::min)(j2 + tile_nc, cols) - j2;
+
+      WideMap accBlock(acc, actual_mc, actual_nc);
+      accBlock = res.block(i2, j2, actual_mc, actual_nc).template cast<AccScalar>();
+      for (Index k2 = 0; k2 < depth; k2 += kc) {
+        const Index actual_kc = (std::min)(k2 + kc, depth) - k2;
+        WideMap(wideA, actual_mc, actual_kc) = lhs.block(i2, k2, actual_mc, actual_kc).template cast<AccScalar>();
+        pack_lhs(blockA, WideMapper(wideA, actual_mc), actual_kc, actual_mc);
+        WideMap(wideB, actual_kc, actual_nc) = rhs.block(k2, j2, actual_kc, actual_nc).template cast<AccScalar>();
+        pack_rhs(blockB, WideMapper(wideB, actual_kc), actual_kc, actual_nc);
+        gebp(AccMapper(acc, actual_mc), blockA, blockB, actual_mc, actual_kc, actual_nc,
+             static_cast<AccScalar>(alpha));
+      }
+      res.block(i2, j2, actual_mc, actual_nc) = accBlock.template cast<Scalar>();
+      epilogue(i2, j2, actual_mc, actual_nc);
+
+#if defined(EIGEN_GEMM_THREADPOOL)
+      if (tiles) {
+        // Note that the product operands may go out of scope as soon as the last tile is finished.
+        tiles->finish();
+        t = tiles->claim();
+        continue;
+      }
+#endif
+      ++t;
+    }
+  }
+};
+
+template <typename Index, int LhsStorageOrder, bool ConjugateLhs, int RhsStorageOrder, bool ConjugateRhs,
+          int ResInnerStride>
+struct general_matrix_matrix_product<Index, bfloat16, LhsStorageOrder, ConjugateLhs, bfloat16, RhsStorageOrder,
+                                     ConjugateRhs, ColMajor, ResInnerStride>
+    : reduced_precision_matrix_matrix_product<Index, bfloat16, LhsStorageOrder, RhsStorageOrder, ResInnerStride> {};
+
+template <typename Index, int LhsStorageOrder, bool ConjugateLhs, int RhsStorageOrder, bool ConjugateRhs,
+          int ResInnerStride>
+struct general_matrix_matrix_product<Index, half, LhsStorageOrder, ConjugateLhs, half, RhsStorageOrder, ConjugateRhs,
+                                     ColMajor, ResInnerStride>
+    : reduced_precision_matrix_matrix_product<Index, half, LhsStorageOrder, RhsStorageOrder, ResInnerStride> {};
+
+#endif  // defined(EIGEN_VECTORIZE_AVX) && !defined(EIGEN_USE_BLAS)
+
+}  // end namespace internal
+
+}  // end namespace Eigen
+
+#endif  // EIGEN_REDUCED_PRECISION_MATRIX_MATRIX_H
@@ -0,0 +1,203 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_STRASSEN_MATRIX_MATRIX_H
+#define EIGEN_STRASSEN_MATRIX_MATRIX_H
+
+// IWYU pragma: private
+#include "../InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+/*  Strassen-Winograd product of two column-major matrices:
+ *    C = A * B
+ *  Each level of recursion splits the operands into 2 x 2 blocks and computes the product with 7 block products and
+ *  15 block additions, following the schedule of Boyer, Dumas, Pernet and Zhou ("Memory efficient scheduling of
+ *  Strassen-Winograd's matrix multiplication algorithm", ISSAC 2009), which only needs two temporary blocks per level
+ *  besides the blocks of C. The temporaries of all the levels are carved out of a single workspace, and the products
+ *  at the bottom of the recursion are computed by the general matrix-matrix product. Odd dimensions are handled by
+ *  peeling off the last row, column or depth with matrix-vector and rank-1 products. */
+template <typename Scalar>
+struct strassen_matrix_matrix_product {
+  typedef Matrix<Scalar, Dynamic, Dynamic> MatrixType;
+  typedef Map<const MatrixType, 0, OuterStride<> > ConstMapType;
+  typedef Map<MatrixType, 0, OuterStride<> > MapType;
+
+  // Returns the number of levels of recursion applied to a m x k times k x n product.
+  static int levels(Index m, Index k, Index n, int maxLevels, Index minBlockSize) {
+    int l = 0;
+    while (l < maxLevels && numext::mini(m, numext::mini(k, n)) / 2 >= minBlockSize) {
+      m /= 2;
+      k /= 2;
+      n /= 2;
+      ++l;
+    }
+    return l;
+  }
+
+  // Returns the number of scalars of the workspace needed by run().
+  static Index workspace_size(Index m, Index k, Index n, int levels) {
+    Index size = 0;
+    for (int l = 0; l < levels; ++l) {
+      m /= 2;
+      k /= 2;
+      n /= 2;
+      size += m * numext::maxi(k, n) + k * n;
+    }
+    return size;
+  }
+
+  static ConstMapType block(const ConstMapType& mat, Index i, Index j, Index rows, Index cols) {
+    return ConstMapType(mat.data() + i + j * mat.outerStride(), rows, cols, OuterStride<>(mat.outerStride()));
+  }
+
+  static MapType block(MapType& mat, Index i, Index j, Index rows, Index cols) {
+    return MapType(mat.data() + i + j * mat.outerStride(), rows, cols, OuterStride<>(mat.outerStride()));
+  }
+
+  static ConstMapType as_const(const MapType& mat) {
+    return ConstMapType(mat.data(), mat.rows(), mat.cols(), OuterStride<>(mat.outerStride()));
+  }
+
+  static void run(const ConstMapType& A, const ConstMapType& B, MapType C, int levels, Scalar* workspace) {
+    if (levels == 0) {
+      C.noalias() = A * B;
+      return;
+    }
+
+    const Index m = A.rows(), k = A.cols(), n = B.cols();
+    const Index m2 = m / 2, k2 = k / 2, n2 = n / 2;
+    const ConstMapType A11 = block(A, 0, 0, m2, k2), A12 = block(A, 0, k2, m2, k2);
+    const ConstMapType A21 = block(A, m2, 0, m2, k2), A22 = block(A, m2, k2, m2, k2);
+    const ConstMapType B11 = block(B, 0, 0, k2, n2), B12 = block(B, 0, n2, k2, n2);
+    const ConstMapType B21 = block(B, k2, 0, k2, n2), B22 = block(B, k2, n2, k2, n2);
+    MapType C11 = block(C, 0, 0, m2, n2), C12 = block(C, 0, n2, m2, n2);
+    MapType C21 = block(C, m2, 0, m2, n2), C22 = block(C, m2, n2, m2, n2);
+
+    // X holds the sums of blocks of A, and then the product P1. Y holds the sums of blocks of B.
+    MapType X(workspace, m2, k2, OuterStride<>(m2));
+    MapType P1(workspace, m2, n2, OuterStride<>(m2));
+    MapType Y(workspace + m2 * numext::maxi(k2, n2), k2, n2, OuterStride<>(k2));
+    Scalar* next = Y.data() + k2 * n2;
+
+    X = A11 - A21;                                         // S3
+    Y = B22 - B12;                                         // T3
+    run(as_const(X), as_const(Y), C21, levels - 1, next);  // P7 = S3 * T3
+    X = A21 + A22;                                         // S1
+    Y = B12 - B11;                                         // T1
+    run(as_const(X), as_const(Y), C22, levels - 1, next);  // P5 = S1 * T1
+    Y = B22 - Y;                                           // T2 = B22 - T1
+    X -= A11;                                              // S2 = S1 - A11
+    run(as_const(X), as_const(Y), C12, levels - 1, next);  // P6 = S2 * T2
+    X = A12 - X;                                           // S4 = A12 - S2
+    run(as_const(X), B22, C11, levels - 1, next);          // P3 = S4 * B22
+    run(A11, B11, P1, levels - 1, next);                   // P1 = A11 * B11
+    C12 += P1;                                             // U2 = P1 + P6
+    C21 += C12;                                            // U3 = U2 + P7
+    C12 += C22;                                            // U4 = U2 + P5
+    C22 += C21;                                            // U7 = U3 + P5 = C22
+    C12 += C11;                                            // U5 = U4 + P3 = C12
+    Y -= B21;                                              // T4 = T2 - B21
+    run(A22, as_const(Y), C11, levels - 1, next);          // P4 = A22 * T4
+    C21 -= C11;                                            // U6 = U3 - P4 = C21
+    run(A12, B21, C11, levels - 1, next);                  // P2 = A12 * B21
+    C11 += P1;                                             // U1 = P1 + P2 = C11
+
+    // Peel off the odd depth, column and row.
+    if (k > 2 * k2) {
+      MapType Ceven = block(C, 0, 0, 2 * m2, 2 * n2);
+      Ceven.noalias() += block(A, 0, k - 1, 2 * m2, 1) * block(B, k - 1, 0, 1, 2 * n2);
+    }
+    if (n > 2 * n2) C.col(n - 1).head(2 * m2).noalias() = block(A, 0, 0, 2 * m2, k) * B.col(n - 1);
+    if (m > 2 * m2) C.row(m - 1).noalias() = A.row(m - 1) * B;
+  }
+};
+
+template <typename Scalar>
+void strassen_product_impl(const Ref<const Matrix<Scalar, Dynamic, Dynamic>, 0, OuterStride<> >& lhs,
+                           const Ref<const Matrix<Scalar, Dynamic, Dynamic>, 0, OuterStride<> >& rhs,
+                           Ref<Matrix<Scalar, Dynamic, Dynamic>, 0, OuterStride<> > dst, int maxLevels,
+                           Index minBlockSize) {
+  typedef strassen_matrix_matrix_product<Scalar> Strassen;
+  eigen_assert(lhs.cols() == rhs.rows() && dst.rows() == lhs.rows() && dst.cols() == rhs.cols());
+  eigen_assert(maxLevels >= 0 && minBlockSize > 0);
+  const int levels = Strassen::levels(lhs.rows(), lhs.cols(), rhs.cols(), maxLevels, minBlockSize);
+  ei_declare_aligned_stack_constructed_variable(
+      Scalar, workspace, Strassen::workspace_size(lhs.rows(), lhs.cols(), rhs.cols(), levels), 0);
+  Strassen::run(typename Strassen::ConstMapType(lhs.data(), lhs.rows(), lhs.cols(), OuterStride<>(lhs.outerStride())),
+                typename Strassen::ConstMapType(rhs.data(), rhs.rows(), rhs.cols(), OuterStride<>(rhs.outerStride())),
+                typename Strassen::MapType(dst.data(), dst.rows(), dst.cols(), OuterStride<>(dst.outerStride())),
+                levels, workspace);
+}
+
+// Computes directly into column-major destinations, and through a temporary otherwise.
+template <typename Dest, bool DestIsColMajor>
+struct strassen_product_dest {
+  template <typename Lhs, typename Rhs>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& dst, int maxLevels, Index minBlockSize) {
+    strassen_product_impl<typename Dest::Scalar>(lhs, rhs, dst, maxLevels, minBlockSize);
+  }
+};
+
+template <typename Dest>
+struct strassen_product_dest<Dest, false> {
+  template <typename Lhs, typename Rhs>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& dst, int maxLevels, Index minBlockSize) {
+    Matrix<typename Dest::Scalar, Dynamic, Dynamic> tmp(lhs.rows(), rhs.cols());
+    strassen_product_impl<typename Dest::Scalar>(lhs, rhs, tmp, maxLevels, minBlockSize);
+    dst = tmp;
+  }
+};
+
+}  // end namespace internal
+
+/** \ingroup Core_Module
+ *
+ * Computes \a dst = \a lhs * \a rhs with up to \a maxLevels levels of the Strassen-Winograd recursion on top of the
+ * general matrix-matrix product.
+ *
+ * Each level replaces one product by 7 products of half the size and 15 additions of blocks, which saves about 12%
+ * of the floating point operations with one level, and 23% with two. A level is only applied as long as the three
+ * dimensions of the resulting block products are at least \a minBlockSize, below which the additions and the
+ * smaller products outweigh the savings. This typically pays off for square products of a few thousands and above.
+ * The temporary blocks of all the levels live in a single workspace, allocated once per call, whose size is half of
+ * the size of one operand with one level, and less than 2/3 of it with more levels.
+ *
+ * The result is less accurate than with the classical product. With \f$ \ell \f$ levels, and \f$ n_0 = n / 2^\ell \f$
+ * for square matrices of size \f$ n \f$, the computed result satisfies the normwise bound
+ * \f[ \max_{ij} |\hat{C}_{ij} - C_{ij}| \le \left[ 18^\ell (n_0^2 + 6 n_0) - 6n \right] u
+ *     \max_{ij} |A_{ij}| \max_{ij} |B_{ij}| + O(u^2) \f]
+ * where \f$ u \f$ is the unit roundoff (Higham, Accuracy and Stability of Numerical Algorithms, Section 23.2.2),
+ * while the classical product satisfies the componentwise bound \f$ |\hat{C} - C| \le n u |A| |B| + O(u^2) \f$. In
+ * practice the error grows by a small factor per level, but it is only bounded relatively to the largest entries of
+ * the operands: small entries of the result of badly scaled matrices may lose their relative accuracy.
+ *
+ * The block products are multithreaded as usual, see setNbThreads(). \a dst is resized if needed and must not alias
+ * \a lhs or \a rhs.
+ */
+template <typename Lhs, typename Rhs, typename Dest>
+void strassenProduct(const MatrixBase<Lhs>& lhs, const MatrixBase<Rhs>& rhs, MatrixBase<Dest>& dst,
+                     int maxLevels = 2, Index minBlockSize = 1024) {
+  EIGEN_STATIC_ASSERT((internal::is_same<typename Lhs::Scalar, typename Dest::Scalar>::value &&
+                       internal::is_same<typename Rhs::Scalar, typename Dest::Scalar>::value),
+                      YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+  dst.derived().resize(lhs.rows(), rhs.cols());
+  enum {
+    DestIsColMajor = (int(Dest::Flags) & DirectAccessBit) && !(int(Dest::Flags) & RowMajorBit) &&
+                     int(internal::inner_stride_at_compile_time<Dest>::ret) == 1
+  };
+  internal::strassen_product_dest<Dest, bool(DestIsColMajor)>::run(lhs.derived(), rhs.derived(), dst.derived(),
+                                                                    maxLevels, minBlockSize);
+}
+
+}  // end namespace Eigen
+
+#endif  // EIGEN_STRASSEN_MATRIX_MATRIX_H
@@ -145,6 +145,67 @@ EIGEN_DONT_INLINE void triangular_matrix_vector_product<Index, Mode, LhsScalar,
   }
 }
 
+/* Multithreaded triangular matrix-vector product, for products large enough to be worth it. The rows of the result
+ * are split into blocks of about the same number of coefficients of the triangular matrix. Each block is made of a
+ * triangular product on the diagonal, and, for lower triangular matrices, of a general product on its left. */
+template <typename Index, int Mode, typename LhsScalar, bool ConjLhs, typename RhsScalar, bool ConjRhs,
+          int StorageOrder>
+struct parallel_triangular_matrix_vector_product {
+  typedef triangular_matrix_vector_product<Index, Mode, LhsScalar, ConjLhs, RhsScalar, ConjRhs, StorageOrder> Trmv;
+  typedef typename Trmv::ResScalar ResScalar;
+  typedef const_blas_data_mapper<LhsScalar, Index, StorageOrder> LhsMapper;
+  typedef const_blas_data_mapper<RhsScalar, Index, RowMajor> RhsMapper;
+  typedef general_matrix_vector_product<Index, LhsScalar, LhsMapper, StorageOrder, ConjLhs, RhsScalar, RhsMapper,
+                                        ConjRhs>
+      Gemv;
+  static constexpr bool IsLower = ((Mode & Lower) == Lower);
+
+  template <typename AlphaScalar>
+  static void run(Index _rows, Index _cols, const LhsScalar* lhs, Index lhsStride, const RhsScalar* rhs,
+                  Index rhsIncr, ResScalar* res, Index resIncr, const AlphaScalar& alpha) {
+    const double kMinTaskSize = 65536;
+    const Index kGranularity = 16;
+    const Index diagSize = (std::min)(_rows, _cols);
+    const Index rows = IsLower ? _rows : diagSize;
+    // Number of coefficients of the first r rows.
+    auto work = [=](Index r) -> double {
+      const double dr = static_cast<double>(r), dd = static_cast<double>(diagSize);
+      if (!IsLower) return dr * static_cast<double>(_cols) - dr * (dr - 1) / 2;
+      return r <= diagSize ? dr * (dr + 1) / 2 : dd * (dd + 1) / 2 + (dr - dd) * dd;
+    };
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+    // The blocks would change the order in which the products are accumulated.
+    const int threads = 1;
+    EIGEN_UNUSED_VARIABLE(kMinTaskSize)
+#else
+    const int threads = parallel_threads(work(rows), kMinTaskSize, rows / kGranularity);
+#endif
+    if (threads <= 1) return Trmv::run(_rows, _cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha);
+
+    ei_declare_aligned_stack_constructed_variable(Index, bounds, threads + 1, 0);
+    balanced_partition(rows, threads, kGranularity, work, bounds);
+    auto lhsAt = [=](Index i, Index j) {
+      return lhs + (StorageOrder == RowMajor ? i * lhsStride + j : i + j * lhsStride);
+    };
+    parallelize_tasks(threads, [&](int t) {
+      const Index r0 = bounds[t], r1 = bounds[t + 1];
+      if (r1 == r0) return;
+      if (IsLower) {
+        const Index gemvCols = (std::min)(r0, diagSize);
+        if (gemvCols > 0)
+          Gemv::run(r1 - r0, gemvCols, LhsMapper(lhsAt(r0, 0), lhsStride), RhsMapper(rhs, rhsIncr),
+                    res + r0 * resIncr, resIncr, alpha);
+        if (r0 < diagSize)
+          Trmv::run(r1 - r0, (std::min)(r1, diagSize) - r0, lhsAt(r0, r0), lhsStride, rhs + r0 * rhsIncr, rhsIncr,
+                    res + r0 * resIncr, resIncr, alpha);
+      } else {
+        Trmv::run(r1 - r0, _cols - r0, lhsAt(r0, r0), lhsStride, rhs + r0 * rhsIncr, rhsIncr, res + r0 * resIncr,
+                  resIncr, alpha);
+      }
+    });
+  }
+};
+
 /***************************************************************************
  * Wrapper to product_triangular_vector
  ***************************************************************************/
@@ -240,15 +301,12 @@ struct trmv_selector<Mode, ColMajor> {
         MappedDest(actualDestPtr, dest.size()) = dest;
     }
 
-    internal::triangular_matrix_vector_product<Index, Mode, LhsScalar, LhsBlasTraits::NeedToConjugate, RhsScalar,
-                                               RhsBlasTraits::NeedToConjugate, ColMajor>::run(actualLhs.rows(),
-                                                                                              actualLhs.cols(),
-                                                                                              actualLhs.data(),
-                                                                                              actualLhs.outerStride(),
-                                                                                              actualRhs.data(),
-                                                                                              actualRhs.innerStride(),
-                                                                                              actualDestPtr, 1,
-                                                                                              compatibleAlpha);
+    internal::parallel_triangular_matrix_vector_product<Index, Mode, LhsScalar, LhsBlasTraits::NeedToConjugate,
+                                                        RhsScalar, RhsBlasTraits::NeedToConjugate,
+                                                        ColMajor>::run(actualLhs.rows(), actualLhs.cols(),
+                                                                       actualLhs.data(), actualLhs.outerStride(),
+                                                                       actualRhs.data(), actualRhs.innerStride(),
+                                                                       actualDestPtr, 1, compatibleAlpha);
 
     if (!evalToDest) {
       if (!alphaIsCompatible)
@@ -321,15 +379,12 @@ struct trmv_selector<Mode, RowMajor> {
         buffer, actualRhs.size(),
         !DirectlyUseRhs && static_rhs.data() == nullptr && actualRhs.size() > EIGEN_STACK_ALLOCATION_LIMIT);
 
-    internal::triangular_matrix_vector_product<Index, Mode, LhsScalar, LhsBlasTraits::NeedToConjugate, RhsScalar,
-                                               RhsBlasTraits::NeedToConjugate, RowMajor>::run(actualLhs.rows(),
-                                                                                              actualLhs.cols(),
-                                                                                              actualLhs.data(),
-                                                                                              actualLhs.outerStride(),
-                                                                                              actualRhsPtr, 1,
-                                                                                              dest.data(),
-                                                                                              dest.innerStride(),
-                                                                                              actualAlpha);
+    internal::parallel_triangular_matrix_vector_product<Index, Mode, LhsScalar, LhsBlasTraits::NeedToConjugate,
+                                                        RhsScalar, RhsBlasTraits::NeedToConjugate,
+                                                        RowMajor>::run(actualLhs.rows(), actualLhs.cols(),
+                                                                       actualLhs.data(), actualLhs.outerStride(),
+                                                                       actualRhsPtr, 1, dest.data(), dest.innerStride(),
+                                                                       actualAlpha);
 
     if (((Mode & UnitDiag) == UnitDiag) && !numext::is_exactly_one(lhs_alpha)) {
       Index diagSize = (std::min)(lhs.rows(), lhs.cols());
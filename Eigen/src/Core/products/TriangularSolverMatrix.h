@@ -18,6 +18,8 @@ namespace Eigen {
 
 namespace internal {
 
+inline namespace EIGEN_KERNEL_NAMESPACE {
+
 template <typename Scalar, typename Index, int Mode, bool Conjugate, int TriStorageOrder, int OtherInnerStride,
           bool Specialized>
 struct trsmKernelL {
@@ -36,6 +38,8 @@ struct trsmKernelR {
                      Index otherStride);
 };
 
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
+
 template <typename Scalar, typename Index, int Mode, bool Conjugate, int TriStorageOrder, int OtherInnerStride,
           bool Specialized>
 EIGEN_STRONG_INLINE void trsmKernelL<Scalar, Index, Mode, Conjugate, TriStorageOrder, OtherInnerStride,
@@ -122,6 +126,30 @@ struct triangular_solve_matrix<Scalar, Index, Side, Mode, Conjugate, TriStorageO
   }
 };
 
+#if defined(EIGEN_DISPATCH_TO_VARIANTS)
+/* Forwards the triangular solve to the kernel variant registered for the host CPU, if any, see Eigen/DispatchVariant.
+ * Returns false if the solve has to be computed by the kernels of this translation unit. */
+template <typename Scalar, bool Dispatchable>
+struct trsm_variant_dispatch {
+  template <typename... Args>
+  static bool run(const Args&...) {
+    return false;
+  }
+};
+
+template <typename Scalar>
+struct trsm_variant_dispatch<Scalar, true> {
+  template <typename Index>
+  static bool run(int side, int mode, bool triRowMajor, Index size, Index otherSize, const Scalar* tri,
+                  Index triStride, Scalar* other, Index otherStride) {
+    const dispatch_kernels<Scalar>& kernels = dispatched_kernels<Scalar>();
+    if (!kernels.trsm) return false;
+    kernels.trsm(side, mode, triRowMajor, size, otherSize, tri, triStride, other, otherStride);
+    return true;
+  }
+};
+#endif  // defined(EIGEN_DISPATCH_TO_VARIANTS)
+
 /* Optimized triangular solver with multiple right hand side and the triangular matrix on the left
  */
 template <typename Scalar, typename Index, int Mode, bool Conjugate, int TriStorageOrder, int OtherInnerStride>
@@ -136,6 +164,12 @@ EIGEN_DONT_INLINE void triangular_solve_matrix<Scalar, Index, OnTheLeft, Mode, C
                                                                       Index triStride, Scalar* _other, Index otherIncr,
                                                                       Index otherStride,
                                                                       level3_blocking<Scalar, Scalar>& blocking) {
+#if defined(EIGEN_DISPATCH_TO_VARIANTS)
+  enum { Dispatchable = !Conjugate && OtherInnerStride == 1 && (Mode & ~(Lower | Upper | UnitDiag)) == 0 };
+  if (trsm_variant_dispatch<Scalar, bool(Dispatchable)>::run(int(OnTheLeft), Mode, TriStorageOrder == RowMajor, size,
+                                                             otherSize, _tri, triStride, _other, otherStride))
+    return;
+#endif
   Index cols = otherSize;
 
   std::ptrdiff_t l1, l2, l3;
@@ -271,6 +305,12 @@ EIGEN_DONT_INLINE void triangular_solve_matrix<Scalar, Index, OnTheRight, Mode,
                                                                       Index triStride, Scalar* _other, Index otherIncr,
                                                                       Index otherStride,
                                                                       level3_blocking<Scalar, Scalar>& blocking) {
+#if defined(EIGEN_DISPATCH_TO_VARIANTS)
+  enum { Dispatchable = !Conjugate && OtherInnerStride == 1 && (Mode & ~(Lower | Upper | UnitDiag)) == 0 };
+  if (trsm_variant_dispatch<Scalar, bool(Dispatchable)>::run(int(OnTheRight), Mode, TriStorageOrder == RowMajor, size,
+                                                             otherSize, _tri, triStride, _other, otherStride))
+    return;
+#endif
   Index rows = otherSize;
 
 #if defined(EIGEN_VECTORIZE_AVX512) && EIGEN_USE_AVX512_TRSM_R_KERNELS && EIGEN_ENABLE_AVX512_NOCOPY_TRSM_R_CUTOFFS
@@ -381,6 +421,46 @@ EIGEN_DONT_INLINE void triangular_solve_matrix<Scalar, Index, OnTheRight, Mode,
     }
   }
 }
+
+/* Multithreaded triangular solver with multiple right (resp. left) hand sides, for systems large enough to be worth
+ * it. The columns (resp. rows) of the other matrix are independent from each other, so that they are split into as
+ * many panels as threads, each one being solved by the sequential solver above with its own packing buffers. */
+template <typename Scalar, typename Index, int Side, int Mode, bool Conjugate, int TriStorageOrder,
+          int OtherStorageOrder, int OtherInnerStride>
+struct parallel_triangular_solve_matrix {
+  typedef triangular_solve_matrix<Scalar, Index, Side, Mode, Conjugate, TriStorageOrder, OtherStorageOrder,
+                                  OtherInnerStride>
+      Trsm;
+
+  static void run(Index size, Index otherSize, const Scalar* tri, Index triStride, Scalar* other, Index otherIncr,
+                  Index otherStride, level3_blocking<Scalar, Scalar>& blocking) {
+    // Same minimal work per thread as parallelize_gemm, and panels wide enough to amortize the packing of the
+    // triangular matrix, which is repeated by every thread.
+    const double kMinTaskSize = 50000;
+    const Index kMinPanelWidth = 64;
+    const double work = 0.5 * static_cast<double>(size) * static_cast<double>(size) * static_cast<double>(otherSize);
+    const int threads = parallel_threads(work, kMinTaskSize, otherSize / kMinPanelWidth);
+    if (threads <= 1) {
+      Trsm::run(size, otherSize, tri, triStride, other, otherIncr, otherStride, blocking);
+      return;
+    }
+
+    // The independent vectors are the columns of other when solving on the left, and its rows otherwise.
+    const Index panelIncr = (Side == OnTheLeft) == (OtherStorageOrder == ColMajor) ? otherStride : otherIncr;
+    ei_declare_aligned_stack_constructed_variable(Index, bounds, threads + 1, 0);
+    balanced_partition(otherSize, threads, Index(16), [](Index i) { return i; }, bounds);
+
+    parallelize_tasks(threads, [&](int t) {
+      const Index panelSize = bounds[t + 1] - bounds[t];
+      if (panelSize == 0) return;
+      gemm_blocking_space<OtherStorageOrder, Scalar, Scalar, Dynamic, Dynamic, Dynamic, 4> panelBlocking(
+          Side == OnTheLeft ? size : panelSize, Side == OnTheLeft ? panelSize : size, size, 1, false);
+      Trsm::run(size, panelSize, tri, triStride, other + bounds[t] * panelIncr, otherIncr, otherStride,
+                panelBlocking);
+    });
+  }
+};
+
 }  // end namespace internal
 
 }  // end namespace Eigen
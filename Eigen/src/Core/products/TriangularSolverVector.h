@@ -115,6 +115,59 @@ struct triangular_solve_vector<LhsScalar, RhsScalar, Index, OnTheLeft, Mode, Con
   }
 };
 
+template <typename LhsScalar, typename RhsScalar, typename Index, int Mode, bool Conjugate, int StorageOrder>
+struct parallel_triangular_solve_vector<LhsScalar, RhsScalar, Index, OnTheRight, Mode, Conjugate, StorageOrder> {
+  static void run(Index size, const LhsScalar* _lhs, Index lhsStride, RhsScalar* rhs) {
+    parallel_triangular_solve_vector<LhsScalar, RhsScalar, Index, OnTheLeft,
+                                     ((Mode & Upper) == Upper ? Lower : Upper) | (Mode & UnitDiag), Conjugate,
+                                     StorageOrder == RowMajor ? ColMajor : RowMajor>::run(size, _lhs, lhsStride, rhs);
+  }
+};
+
+/* Multithreaded forward and backward substitution, for systems large enough to be worth it. The substitution
+ * proceeds per large panel: the diagonal block of a panel is solved sequentially, and the remaining part of the rhs
+ * is then updated by a multithreaded general matrix-vector product with the panel. */
+template <typename LhsScalar, typename RhsScalar, typename Index, int Mode, bool Conjugate, int StorageOrder>
+struct parallel_triangular_solve_vector<LhsScalar, RhsScalar, Index, OnTheLeft, Mode, Conjugate, StorageOrder> {
+  enum { IsLower = ((Mode & Lower) == Lower) };
+  typedef triangular_solve_vector<LhsScalar, RhsScalar, Index, OnTheLeft, Mode, Conjugate, StorageOrder> Trsv;
+  typedef const_blas_data_mapper<LhsScalar, Index, StorageOrder> LhsMapper;
+  typedef const_blas_data_mapper<RhsScalar, Index, ColMajor> RhsMapper;
+  typedef parallel_matrix_vector_product<Index, LhsScalar, LhsMapper, StorageOrder, Conjugate, RhsScalar, RhsMapper,
+                                         false>
+      Gemv;
+
+  static void run(Index size, const LhsScalar* _lhs, Index lhsStride, RhsScalar* rhs) {
+    const double kMinTaskSize = 65536;
+    const Index kPanelWidth = 256;
+    const double work = static_cast<double>(size) * static_cast<double>(size) / 2;
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+    // The panels would change the order in which the products are accumulated.
+    const int threads = 1;
+    EIGEN_UNUSED_VARIABLE(kMinTaskSize)
+    EIGEN_UNUSED_VARIABLE(work)
+#else
+    const int threads = parallel_threads(work, kMinTaskSize, size / kPanelWidth);
+#endif
+    if (threads <= 1) return Trsv::run(size, _lhs, lhsStride, rhs);
+
+    auto lhsAt = [=](Index i, Index j) {
+      return _lhs + (StorageOrder == RowMajor ? i * lhsStride + j : i + j * lhsStride);
+    };
+    for (Index pi = IsLower ? 0 : size; IsLower ? pi < size : pi > 0; IsLower ? pi += kPanelWidth : pi -= kPanelWidth) {
+      const Index actualPanelWidth = (std::min)(IsLower ? size - pi : pi, kPanelWidth);
+      const Index startBlock = IsLower ? pi : pi - actualPanelWidth;
+      const Index endBlock = IsLower ? pi + actualPanelWidth : 0;
+      Trsv::run(actualPanelWidth, lhsAt(startBlock, startBlock), lhsStride, rhs + startBlock);
+
+      const Index r = IsLower ? size - endBlock : startBlock;  // remaining size
+      if (r > 0)
+        Gemv::run(r, actualPanelWidth, LhsMapper(lhsAt(endBlock, startBlock), lhsStride),
+                  RhsMapper(rhs + startBlock, 1), rhs + endBlock, 1, RhsScalar(-1));
+    }
+  }
+};
+
 }  // end namespace internal
 
 }  // end namespace Eigen
@@ -21,6 +21,8 @@ namespace Eigen {
 namespace internal {
 
 // forward declarations
+inline namespace EIGEN_KERNEL_NAMESPACE {
+
 template <typename LhsScalar, typename RhsScalar, typename Index, typename DataMapper, int mr, int nr,
           bool ConjugateLhs = false, bool ConjugateRhs = false>
 struct gebp_kernel;
@@ -41,6 +43,12 @@ template <typename Index, typename LhsScalar, typename LhsMapper, int LhsStorage
           typename RhsScalar, typename RhsMapper, bool ConjugateRhs, int Version = Specialized>
 struct general_matrix_vector_product;
 
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
+
+template <typename Index, typename LhsScalar, typename LhsMapper, int LhsStorageOrder, bool ConjugateLhs,
+          typename RhsScalar, typename RhsMapper, bool ConjugateRhs>
+struct parallel_matrix_vector_product;
+
 template <typename From, typename To>
 struct get_factor {
   EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE To run(const From& x) { return To(x); }
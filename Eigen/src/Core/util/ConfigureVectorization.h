@@ -477,6 +477,30 @@ extern "C" {
 #include <hip/hip_bfloat16.h>
 #endif
 
+// The matrix product and triangular solve kernels are declared in an inline namespace of Eigen::internal named after
+// the instruction set they are compiled for. The kernels of translation units compiled for different instruction sets,
+// like the variants of Eigen/DispatchVariant, thus have distinct symbols and never get merged at link time.
+#ifndef EIGEN_KERNEL_NAMESPACE
+#if defined(EIGEN_VECTORIZE_AVX512) && defined(EIGEN_VECTORIZE_AVX512DQ) && defined(EIGEN_VECTORIZE_AVX512VL) && \
+    defined(__AVX512BW__)
+#define EIGEN_KERNEL_NAMESPACE kernels_avx512
+#elif defined(EIGEN_VECTORIZE_AVX512)
+#define EIGEN_KERNEL_NAMESPACE kernels_avx512f
+#elif defined(EIGEN_VECTORIZE_AVX2) && defined(EIGEN_VECTORIZE_FMA)
+#define EIGEN_KERNEL_NAMESPACE kernels_avx2_fma
+#elif defined(EIGEN_VECTORIZE_AVX2)
+#define EIGEN_KERNEL_NAMESPACE kernels_avx2
+#elif defined(EIGEN_VECTORIZE_AVX)
+#define EIGEN_KERNEL_NAMESPACE kernels_avx
+#elif defined(EIGEN_VECTORIZE_SSE4_2)
+#define EIGEN_KERNEL_NAMESPACE kernels_sse4_2
+#elif defined(EIGEN_VECTORIZE_SSE)
+#define EIGEN_KERNEL_NAMESPACE kernels_sse
+#else
+#define EIGEN_KERNEL_NAMESPACE kernels
+#endif
+#endif
+
 /** \brief Namespace containing all symbols from the %Eigen library. */
 // IWYU pragma: private
 #include "../InternalHeaderCheck.h"
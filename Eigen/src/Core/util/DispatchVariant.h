@@ -0,0 +1,157 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_DISPATCH_VARIANT_H
+#define EIGEN_DISPATCH_VARIANT_H
+
+// IWYU pragma: private
+#include "../InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+namespace {
+
+/* Entry points of the dispatch_kernels table, implemented with the kernels compiled for the instruction set of the
+ * variant, see Eigen/DispatchVariant. */
+template <typename Scalar>
+struct dispatch_variant {
+  typedef Eigen::Index Index;
+  EIGEN_STATIC_ASSERT((std::is_same<Index, dispatch_index>::value), YOU_MADE_A_PROGRAMMING_MISTAKE)
+
+  template <int LhsStorageOrder, int RhsStorageOrder>
+  static void gemm(Index rows, Index cols, Index depth, const Scalar* lhs, Index lhsStride, const Scalar* rhs,
+                   Index rhsStride, Scalar* res, Index resStride, Scalar alpha, const dispatch_gemm_tiles* tiles) {
+    typedef general_matrix_matrix_product<Index, Scalar, LhsStorageOrder, false, Scalar, RhsStorageOrder, false,
+                                          ColMajor, 1>
+        Gemm;
+    typedef gemm_blocking_space<ColMajor, Scalar, Scalar, Dynamic, Dynamic, Dynamic> BlockingType;
+    if (!tiles) {
+      BlockingType blocking(rows, cols, depth, 1, true);
+      Gemm::run(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, 1, resStride, alpha, blocking);
+      return;
+    }
+
+    // Each claimed tile of the result is computed by the sequential product. The blocking and its buffers, sized for
+    // a full tile, are shared by all of them.
+    BlockingType blocking((std::min)(tiles->tile_rows, rows), (std::min)(tiles->tile_cols, cols), depth, 1, true);
+    blocking.allocateAll();
+    for (Index t = tiles->first_tile; t < tiles->num_tiles; t = tiles->claim(tiles->context)) {
+      const Index i2 = (t % tiles->num_row_tiles) * tiles->tile_rows;
+      const Index j2 = (t / tiles->num_row_tiles) * tiles->tile_cols;
+      const Index actual_mc = (std::min)(i2 + tiles->tile_rows, rows) - i2;
+      const Index actual_nc = (std::min)(j2 + tiles->tile_cols, cols) - j2;
+      const Scalar* tile_lhs = lhs + (LhsStorageOrder == RowMajor ? i2 * lhsStride : i2);
+      const Scalar* tile_rhs = rhs + (RhsStorageOrder == RowMajor ? j2 : j2 * rhsStride);
+      Gemm::run(actual_mc, actual_nc, depth, tile_lhs, lhsStride, tile_rhs, rhsStride, res + i2 + j2 * resStride, 1,
+                resStride, alpha, blocking);
+      tiles->finish(tiles->context);
+    }
+  }
+
+  static void gemm(Index rows, Index cols, Index depth, const Scalar* lhs, Index lhsStride, bool lhsRowMajor,
+                   const Scalar* rhs, Index rhsStride, bool rhsRowMajor, Scalar* res, Index resStride, Scalar alpha,
+                   const dispatch_gemm_tiles* tiles) {
+    if (lhsRowMajor) {
+      if (rhsRowMajor)
+        gemm<RowMajor, RowMajor>(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, tiles);
+      else
+        gemm<RowMajor, ColMajor>(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, tiles);
+    } else {
+      if (rhsRowMajor)
+        gemm<ColMajor, RowMajor>(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, tiles);
+      else
+        gemm<ColMajor, ColMajor>(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, tiles);
+    }
+  }
+
+  static void gemv(Index rows, Index cols, const Scalar* lhs, Index lhsStride, bool lhsRowMajor, const Scalar* rhs,
+                   Index rhsIncr, Scalar* res, Index resIncr, Scalar alpha) {
+    if (lhsRowMajor) {
+      typedef const_blas_data_mapper<Scalar, Index, RowMajor> LhsMapper;
+      typedef const_blas_data_mapper<Scalar, Index, ColMajor> RhsMapper;
+      general_matrix_vector_product<Index, Scalar, LhsMapper, RowMajor, false, Scalar, RhsMapper, false>::run(
+          rows, cols, LhsMapper(lhs, lhsStride), RhsMapper(rhs, rhsIncr), res, resIncr, alpha);
+    } else {
+      typedef const_blas_data_mapper<Scalar, Index, ColMajor> LhsMapper;
+      typedef const_blas_data_mapper<Scalar, Index, RowMajor> RhsMapper;
+      general_matrix_vector_product<Index, Scalar, LhsMapper, ColMajor, false, Scalar, RhsMapper, false>::run(
+          rows, cols, LhsMapper(lhs, lhsStride), RhsMapper(rhs, rhsIncr), res, resIncr, alpha);
+    }
+  }
+
+  template <int Side, int Mode, int TriStorageOrder>
+  static void trsm(Index size, Index otherSize, const Scalar* tri, Index triStride, Scalar* other, Index otherStride) {
+    typedef gemm_blocking_space<ColMajor, Scalar, Scalar, Dynamic, Dynamic, Dynamic, 4> BlockingType;
+    BlockingType blocking(Side == OnTheLeft ? size : otherSize, Side == OnTheLeft ? otherSize : size, size, 1, false);
+    triangular_solve_matrix<Scalar, Index, Side, Mode, false, TriStorageOrder, ColMajor, 1>::run(
+        size, otherSize, tri, triStride, other, 1, otherStride, blocking);
+  }
+
+  template <int Side, int Mode>
+  static void trsm(bool triRowMajor, Index size, Index otherSize, const Scalar* tri, Index triStride, Scalar* other,
+                   Index otherStride) {
+    if (triRowMajor)
+      trsm<Side, Mode, RowMajor>(size, otherSize, tri, triStride, other, otherStride);
+    else
+      trsm<Side, Mode, ColMajor>(size, otherSize, tri, triStride, other, otherStride);
+  }
+
+  template <int Side>
+  static void trsm(int mode, bool triRowMajor, Index size, Index otherSize, const Scalar* tri, Index triStride,
+                   Scalar* other, Index otherStride) {
+    switch (mode) {
+      case Lower:
+        trsm<Side, Lower>(triRowMajor, size, otherSize, tri, triStride, other, otherStride);
+        break;
+      case Upper:
+        trsm<Side, Upper>(triRowMajor, size, otherSize, tri, triStride, other, otherStride);
+        break;
+      case UnitLower:
+        trsm<Side, UnitLower>(triRowMajor, size, otherSize, tri, triStride, other, otherStride);
+        break;
+      case UnitUpper:
+        trsm<Side, UnitUpper>(triRowMajor, size, otherSize, tri, triStride, other, otherStride);
+        break;
+      default:
+        eigen_assert(false && "unsupported triangular mode");
+    }
+  }
+
+  static void trsm(int side, int mode, bool triRowMajor, Index size, Index otherSize, const Scalar* tri,
+                   Index triStride, Scalar* other, Index otherStride) {
+    if (side == OnTheLeft)
+      trsm<OnTheLeft>(mode, triRowMajor, size, otherSize, tri, triStride, other, otherStride);
+    else
+      trsm<OnTheRight>(mode, triRowMajor, size, otherSize, tri, triStride, other, otherStride);
+  }
+
+  static dispatch_kernels<Scalar> kernels() {
+    dispatch_kernels<Scalar> variant_kernels = {EIGEN_DISPATCH_VARIANT_ISA, &gemm, &gemv, &trsm};
+    return variant_kernels;
+  }
+};
+
+struct dispatch_variant_registration {
+  dispatch_variant_registration() {
+    register_dispatch_kernels(dispatch_variant<float>::kernels());
+    register_dispatch_kernels(dispatch_variant<double>::kernels());
+  }
+};
+
+const dispatch_variant_registration dispatch_variant_registration_instance;
+
+}  // end anonymous namespace
+
+}  // end namespace internal
+
+}  // end namespace Eigen
+
+#endif  // EIGEN_DISPATCH_VARIANT_H
@@ -177,6 +177,7 @@ template <typename ExpressionType>
 class WithFormat;
 template <typename MatrixType>
 struct CommaInitializer;
+class RandomStream;
 template <typename Derived>
 class ReturnByValue;
 template <typename ExpressionType>
@@ -305,6 +306,8 @@ template <typename Scalar, typename NewType>
 struct scalar_cast_op;
 template <typename Scalar>
 struct scalar_random_op;
+template <typename Scalar, bool Normal>
+struct counter_random_op;
 template <typename Scalar>
 struct scalar_constant_op;
 template <typename Scalar>
@@ -0,0 +1,307 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_INSTRUMENTATION_H
+#define EIGEN_INSTRUMENTATION_H
+
+#if defined(EIGEN_INSTRUMENTATION) && !defined(EIGEN_GPU_COMPILE_PHASE)
+#define EIGEN_INSTRUMENTATION_ENABLED
+#include <atomic>
+#include <chrono>
+#endif
+
+// IWYU pragma: private
+#include "../InternalHeaderCheck.h"
+
+namespace Eigen {
+
+#ifdef EIGEN_INSTRUMENTATION_ENABLED
+
+/** \ingroup Core_Module
+ * \brief A heap allocation, reallocation or deallocation made by %Eigen, as reported to the AllocationCallback
+ *
+ * \sa setAllocationCallback(), InstrumentedRegion
+ */
+struct AllocationEvent {
+  enum Kind { Allocation, Reallocation, Deallocation };
+  Kind kind;
+  /** The allocated or released memory. */
+  void* ptr;
+  /** The size in bytes of the allocation, zero for deallocations. */
+  std::size_t size;
+  /** The size in bytes of the memory before a reallocation, zero otherwise. */
+  std::size_t oldSize;
+  /** The name of the innermost InstrumentedRegion open on the calling thread, or null. */
+  const char* region;
+};
+
+/** \ingroup Core_Module
+ * \brief The closing of an InstrumentedRegion, as reported to the RegionCallback
+ *
+ * \sa setRegionCallback()
+ */
+struct RegionEvent {
+  /** The name of the region. */
+  const char* name;
+  /** The wall-clock time spent in the region. */
+  double seconds;
+  /** The number of heap allocations and reallocations made by the calling thread within the region. */
+  Index allocations;
+  /** The number of bytes requested by these allocations and reallocations. */
+  std::size_t allocatedBytes;
+};
+
+/** \ingroup Core_Module
+ * \brief The counters of the heap allocations made by %Eigen on all the threads
+ *
+ * \sa allocationStatistics(), resetAllocationStatistics()
+ */
+struct AllocationStatistics {
+  /** The number of calls to aligned_malloc() and to its unaligned counterpart reaching the heap. */
+  Index allocations;
+  /** The number of reallocations of non-null memory. */
+  Index reallocations;
+  /** The number of deallocations of non-null memory. */
+  Index deallocations;
+  /** The total number of bytes requested by the allocations and reallocations. */
+  std::size_t allocatedBytes;
+  /** The size in bytes of the largest allocation or reallocation. */
+  std::size_t largestAllocation;
+};
+
+/** The type of the functions receiving the heap allocations made by %Eigen. \sa setAllocationCallback() */
+typedef void (*AllocationCallback)(const AllocationEvent& event);
+
+/** The type of the functions receiving the timings of the instrumented regions. \sa setRegionCallback() */
+typedef void (*RegionCallback)(const RegionEvent& event);
+
+namespace internal {
+
+struct instrumentation_state {
+  std::atomic<Index> allocations{0};
+  std::atomic<Index> reallocations{0};
+  std::atomic<Index> deallocations{0};
+  std::atomic<std::size_t> allocatedBytes{0};
+  std::atomic<std::size_t> largestAllocation{0};
+  std::atomic<AllocationCallback> allocationCallback{nullptr};
+  std::atomic<RegionCallback> regionCallback{nullptr};
+};
+
+inline instrumentation_state& instrumentation() {
+  static instrumentation_state state;
+  return state;
+}
+
+// The innermost region and the counters of the calling thread. The callbacks are not invoked recursively, so that
+// they can allocate.
+struct instrumentation_thread_state {
+  const char* region = nullptr;
+  Index allocations = 0;
+  std::size_t allocatedBytes = 0;
+  bool inCallback = false;
+};
+
+inline instrumentation_thread_state& instrumentation_thread() {
+#ifndef EIGEN_AVOID_THREAD_LOCAL
+  thread_local instrumentation_thread_state state;
+#else
+  // Without thread_local storage, the regions and their counters are shared by all the threads.
+  static instrumentation_thread_state state;
+#endif
+  return state;
+}
+
+inline void record_allocation_event(AllocationEvent::Kind kind, void* ptr, std::size_t size, std::size_t oldSize) {
+  instrumentation_state& state = instrumentation();
+  instrumentation_thread_state& thread = instrumentation_thread();
+  if (kind == AllocationEvent::Deallocation) {
+    state.deallocations.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    (kind == AllocationEvent::Allocation ? state.allocations : state.reallocations)
+        .fetch_add(1, std::memory_order_relaxed);
+    state.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    std::size_t largest = state.largestAllocation.load(std::memory_order_relaxed);
+    while (size > largest &&
+           !state.largestAllocation.compare_exchange_weak(largest, size, std::memory_order_relaxed)) {
+    }
+    ++thread.allocations;
+    thread.allocatedBytes += size;
+  }
+  AllocationCallback callback = state.allocationCallback.load(std::memory_order_acquire);
+  if (callback && !thread.inCallback) {
+    const AllocationEvent event = {kind, ptr, size, oldSize, thread.region};
+    thread.inCallback = true;
+    callback(event);
+    thread.inCallback = false;
+  }
+}
+
+}  // end namespace internal
+
+/** \ingroup Core_Module
+ * \returns the counters of the heap allocations made by %Eigen since the start of the program or the last call to
+ * resetAllocationStatistics().
+ *
+ * Only available when EIGEN_INSTRUMENTATION is defined. The allocations served by a Workspace are not counted.
+ */
+inline AllocationStatistics allocationStatistics() {
+  const internal::instrumentation_state& state = internal::instrumentation();
+  AllocationStatistics statistics;
+  statistics.allocations = state.allocations.load(std::memory_order_relaxed);
+  statistics.reallocations = state.reallocations.load(std::memory_order_relaxed);
+  statistics.deallocations = state.deallocations.load(std::memory_order_relaxed);
+  statistics.allocatedBytes = state.allocatedBytes.load(std::memory_order_relaxed);
+  statistics.largestAllocation = state.largestAllocation.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+/** \ingroup Core_Module
+ * Resets the counters returned by allocationStatistics().
+ */
+inline void resetAllocationStatistics() {
+  internal::instrumentation_state& state = internal::instrumentation();
+  state.allocations.store(0, std::memory_order_relaxed);
+  state.reallocations.store(0, std::memory_order_relaxed);
+  state.deallocations.store(0, std::memory_order_relaxed);
+  state.allocatedBytes.store(0, std::memory_order_relaxed);
+  state.largestAllocation.store(0, std::memory_order_relaxed);
+}
+
+/** \ingroup Core_Module
+ * Installs \a callback to be invoked after each heap allocation and reallocation made by %Eigen, and before each
+ * deallocation, or uninstalls it if \a callback is null.
+ *
+ * The callback is invoked on the allocating thread, possibly concurrently, with the name of the innermost
+ * InstrumentedRegion as call site. It is not invoked for the allocations it makes itself.
+ *
+ * Only available when EIGEN_INSTRUMENTATION is defined.
+ *
+ * \returns the previous callback
+ */
+inline AllocationCallback setAllocationCallback(AllocationCallback callback) {
+  return internal::instrumentation().allocationCallback.exchange(callback, std::memory_order_acq_rel);
+}
+
+/** \ingroup Core_Module
+ * Installs \a callback to be invoked at the end of each InstrumentedRegion, with its duration and the allocations it
+ * made, or uninstalls it if \a callback is null. The regions are only timed while a callback is installed.
+ *
+ * Only available when EIGEN_INSTRUMENTATION is defined.
+ *
+ * \returns the previous callback
+ */
+inline RegionCallback setRegionCallback(RegionCallback callback) {
+  return internal::instrumentation().regionCallback.exchange(callback, std::memory_order_acq_rel);
+}
+
+/** \class InstrumentedRegion
+ * \ingroup Core_Module
+ *
+ * \brief Names the heap allocations made on the calling thread during its lifetime, and times them
+ *
+ * %Eigen opens such regions around the matrix-matrix products ("gemm"), the solvers ("solve") and the computation of
+ * the dense decompositions (e.g., "PartialPivLU::compute"). Users can open their own ones to locate the allocations
+ * of their expressions:
+ * \code
+ * void onAllocation(const Eigen::AllocationEvent& event) {
+ *   if (event.region && std::strcmp(event.region, "hot loop") == 0) report(event.size);
+ * }
+ * // ...
+ * Eigen::setAllocationCallback(onAllocation);
+ * {
+ *   Eigen::InstrumentedRegion region("hot loop");
+ *   y = A * x + b;
+ * }
+ * \endcode
+ *
+ * Only available when EIGEN_INSTRUMENTATION is defined. The name must outlive the region. When
+ * EIGEN_AVOID_THREAD_LOCAL is defined, the regions are tracked for all the threads together, and are thus only
+ * meaningful if a single thread uses %Eigen.
+ *
+ * \sa setRegionCallback(), setAllocationCallback()
+ */
+class InstrumentedRegion : internal::noncopyable {
+ public:
+  explicit InstrumentedRegion(const char* name)
+      : m_name(name), m_callback(internal::instrumentation().regionCallback.load(std::memory_order_acquire)) {
+    internal::instrumentation_thread_state& thread = internal::instrumentation_thread();
+    m_previous = thread.region;
+    m_allocations = thread.allocations;
+    m_allocatedBytes = thread.allocatedBytes;
+    thread.region = name;
+    if (m_callback) m_start = std::chrono::steady_clock::now();
+  }
+
+  ~InstrumentedRegion() {
+    internal::instrumentation_thread_state& thread = internal::instrumentation_thread();
+    thread.region = m_previous;
+    if (m_callback && !thread.inCallback) {
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+      const RegionEvent event = {m_name, elapsed.count(), thread.allocations - m_allocations,
+                                 thread.allocatedBytes - m_allocatedBytes};
+      thread.inCallback = true;
+      m_callback(event);
+      thread.inCallback = false;
+    }
+  }
+
+ private:
+  const char* m_name;
+  const char* m_previous;
+  RegionCallback m_callback;
+  Index m_allocations;
+  std::size_t m_allocatedBytes;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+#define EIGEN_INSTRUMENTED_REGION(NAME) ::Eigen::InstrumentedRegion eigen_instrumented_region(NAME)
+
+#else
+
+#define EIGEN_INSTRUMENTED_REGION(NAME)
+
+#endif  // EIGEN_INSTRUMENTATION_ENABLED
+
+namespace internal {
+
+/** \internal Reports the heap allocation of \a size bytes at \a ptr to the instrumentation. */
+EIGEN_DEVICE_FUNC inline void instrument_allocation(void* ptr, std::size_t size) {
+#ifdef EIGEN_INSTRUMENTATION_ENABLED
+  record_allocation_event(AllocationEvent::Allocation, ptr, size, 0);
+#else
+  EIGEN_UNUSED_VARIABLE(ptr);
+  EIGEN_UNUSED_VARIABLE(size);
+#endif
+}
+
+/** \internal Reports the reallocation to \a ptr of \a old_size bytes to \a new_size bytes to the instrumentation. */
+EIGEN_DEVICE_FUNC inline void instrument_reallocation(void* ptr, std::size_t new_size, std::size_t old_size) {
+#ifdef EIGEN_INSTRUMENTATION_ENABLED
+  record_allocation_event(AllocationEvent::Reallocation, ptr, new_size, old_size);
+#else
+  EIGEN_UNUSED_VARIABLE(ptr);
+  EIGEN_UNUSED_VARIABLE(new_size);
+  EIGEN_UNUSED_VARIABLE(old_size);
+#endif
+}
+
+/** \internal Reports the deallocation of \a ptr to the instrumentation. */
+EIGEN_DEVICE_FUNC inline void instrument_deallocation(void* ptr) {
+#ifdef EIGEN_INSTRUMENTATION_ENABLED
+  record_allocation_event(AllocationEvent::Deallocation, ptr, 0, 0);
+#else
+  EIGEN_UNUSED_VARIABLE(ptr);
+#endif
+}
+
+}  // end namespace internal
+
+}  // end namespace Eigen
+
+#endif  // EIGEN_INSTRUMENTATION_H
@@ -76,6 +76,12 @@
 
 #endif
 
+// The workspaces are installed per thread, see ScopedWorkspace, hence only when thread_local is available.
+#if !defined(EIGEN_AVOID_THREAD_LOCAL) && !defined(EIGEN_GPU_COMPILE_PHASE) && \
+    ((EIGEN_COMP_GNUC) || __has_feature(cxx_thread_local) || EIGEN_COMP_MSVC >= 1900)
+#define EIGEN_WORKSPACE_THREAD_LOCAL thread_local
+#endif
+
 // IWYU pragma: private
 #include "../InternalHeaderCheck.h"
 
@@ -193,6 +199,486 @@ EIGEN_DEVICE_FUNC inline void* handmade_aligned_realloc(void* ptr, std::size_t n
   return aligned;
 }
 
+}  // end namespace internal
+
+/*****************************************************************************
+*** Workspaces serving the temporaries                                     ***
+*****************************************************************************/
+
+class Workspace;
+
+namespace internal {
+/** \internal \returns the innermost workspace installed on the calling thread by a ScopedWorkspace. */
+inline Workspace*& current_workspace() {
+#ifdef EIGEN_WORKSPACE_THREAD_LOCAL
+  EIGEN_WORKSPACE_THREAD_LOCAL static Workspace* workspace = nullptr;
+#else
+  // Never set, as ScopedWorkspace does not install workspaces without thread_local storage.
+  static Workspace* workspace = nullptr;
+#endif
+  return workspace;
+}
+struct workspace_access;
+}  // end namespace internal
+
+/** \class Workspace
+ * \ingroup Core_Module
+ *
+ * \brief A memory arena serving the heap allocations of Eigen's temporaries
+ *
+ * While a ScopedWorkspace is alive, the aligned heap allocations made by Eigen on the calling thread, such as the
+ * temporaries of the decompositions and the blocking buffers of the matrix products, as well as the stack temporaries
+ * above EIGEN_STACK_ALLOCATION_LIMIT, are carved from the workspace instead of calling malloc. The allocations which do
+ * not fit fall back to the heap and are counted by overflowCount().
+ *
+ * All the allocations made in the scope must be released before its end, on the same thread. Therefore, the objects
+ * outliving the scope must be allocated beforehand, and must not be resized within the scope:
+ * \code
+ * PartialPivLU<MatrixXd> lu(A);                       // allocates the members of the decomposition
+ * Workspace workspace(Workspace::sizeFor<PartialPivLU<MatrixXd>>(A));
+ * MatrixXd x(A.rows(), b.cols());
+ * // ...
+ * {
+ *   ScopedWorkspace scope(workspace);
+ *   lu.compute(A);                                    // no call to malloc
+ *   x = lu.solve(b);
+ * }
+ * \endcode
+ *
+ * The released blocks are reclaimed in last-in first-out order, which is the order of the temporaries. A workspace
+ * must only be used by one thread at a time.
+ *
+ * The workspaces require thread_local storage. When it is unavailable, e.g. if EIGEN_AVOID_THREAD_LOCAL is defined,
+ * ScopedWorkspace asserts and does not install the workspace, such that the allocations are served by the heap.
+ *
+ * \sa ScopedWorkspace, sizeFor(), measure()
+ */
+class Workspace : internal::noncopyable {
+ public:
+  /** Constructs a workspace owning a buffer of \a bytes bytes. */
+  explicit Workspace(std::size_t bytes = 0) : m_owned(nullptr) {
+    if (bytes > 0) {
+      m_owned = internal::handmade_aligned_malloc(bytes, Alignment);
+      if (!m_owned) internal::throw_std_bad_alloc();
+    }
+    init(m_owned, m_owned ? bytes : 0);
+  }
+
+  /** Constructs a workspace carving its blocks from the \a bytes bytes at \a buffer, which must outlive it. */
+  Workspace(void* buffer, std::size_t bytes) : m_owned(nullptr) { init(buffer, bytes); }
+
+  ~Workspace() {
+    eigen_plain_assert(m_last == nullptr && "A workspace cannot be destroyed before the release of its blocks");
+    internal::handmade_aligned_free(m_owned);
+  }
+
+  /** \returns the size in bytes of the buffer of the workspace. */
+  std::size_t capacity() const { return m_capacity; }
+
+  /** \returns the number of bytes of the buffer currently in use, including the headers of the blocks. */
+  std::size_t used() const { return m_top; }
+
+  /** \returns the largest number of bytes of the buffer which was in use. */
+  std::size_t peakUsed() const { return m_peakUsed; }
+
+  /** \returns the smallest capacity which would have served all the allocations without falling back to the heap. */
+  std::size_t requiredSize() const { return m_requiredSize; }
+
+  /** \returns the number of allocations which fell back to the heap. */
+  Index overflowCount() const { return m_overflowCount; }
+
+  /** Resets peakUsed(), requiredSize() and overflowCount(). */
+  void resetStatistics() {
+    m_peakUsed = m_top;
+    m_requiredSize = m_last ? m_last->end : 0;
+    m_overflowCount = 0;
+  }
+
+  /** Runs \a func under a ScopedWorkspace of capacity zero.
+   *
+   * \returns the capacity of a workspace which would serve all the allocations of \a func
+   */
+  template <typename Func>
+  static std::size_t measure(Func&& func);
+
+  /** \returns the capacity of a workspace which serves all the temporaries of Decomposition::compute() for matrices
+   * of the shape of \a matrix.
+   *
+   * The members of the decomposition are allocated for the shape of \a matrix beforehand, such that the decomposition
+   * is computed once, under a ScopedWorkspace measuring its temporaries. These only depend on the shape of the matrix
+   * for Eigen's dense decompositions.
+   *
+   * \sa measure()
+   */
+  template <typename Decomposition, typename MatrixType>
+  static std::size_t sizeFor(const MatrixType& matrix);
+
+ private:
+  friend class ScopedWorkspace;
+  friend struct internal::workspace_access;
+
+  // The blocks are aligned for every instruction set, as the kernels of Eigen/DispatchVariant allocate in the
+  // workspaces of the application.
+  static constexpr std::size_t Alignment = 64;
+
+  // The blocks form a stack, in the buffer or on the heap, whose offsets are those of a buffer large enough to hold
+  // all of them.
+  struct Block {
+    Block* previous;
+    std::size_t begin;
+    std::size_t end;
+    bool onHeap;
+    bool released;
+  };
+  static constexpr std::size_t HeaderSize = (sizeof(Block) + Alignment - 1) / Alignment * Alignment;
+
+  void init(void* buffer, std::size_t bytes) {
+    const std::size_t address = reinterpret_cast<std::size_t>(buffer);
+    const std::size_t padding = (Alignment - (address & (Alignment - 1))) & (Alignment - 1);
+    m_buffer = static_cast<uint8_t*>(buffer) + (bytes > padding ? padding : 0);
+    m_capacity = bytes > padding ? bytes - padding : 0;
+    m_top = 0;
+    m_last = nullptr;
+    m_previous = nullptr;
+    m_active = false;
+    m_peakUsed = 0;
+    m_requiredSize = 0;
+    m_overflowCount = 0;
+  }
+
+  static void* data(Block* block) { return reinterpret_cast<uint8_t*>(block) + HeaderSize; }
+
+  void* allocate(std::size_t size) {
+    const std::size_t bytes = HeaderSize + (size + Alignment - 1) / Alignment * Alignment;
+    Block* block;
+    if (bytes <= m_capacity - m_top) {
+      block = reinterpret_cast<Block*>(m_buffer + m_top);
+      block->onHeap = false;
+      m_top += bytes;
+      m_peakUsed = (std::max)(m_peakUsed, m_top);
+    } else {
+      internal::check_that_malloc_is_allowed();
+      block = static_cast<Block*>(internal::handmade_aligned_malloc(bytes, Alignment));
+      if (!block) return nullptr;
+      block->onHeap = true;
+      ++m_overflowCount;
+      internal::instrument_allocation(data(block), size);
+    }
+    block->previous = m_last;
+    block->begin = m_last ? m_last->end : 0;
+    block->end = block->begin + bytes;
+    block->released = false;
+    m_last = block;
+    m_requiredSize = (std::max)(m_requiredSize, block->end);
+    return data(block);
+  }
+
+  // \returns the block holding ptr, or null if it was not allocated by this workspace.
+  Block* find(void* ptr) const {
+    const std::size_t address = reinterpret_cast<std::size_t>(ptr);
+    const std::size_t buffer = reinterpret_cast<std::size_t>(m_buffer);
+    if (address >= buffer + HeaderSize && address < buffer + m_capacity)
+      return reinterpret_cast<Block*>(static_cast<uint8_t*>(ptr) - HeaderSize);
+    for (Block* block = m_last; block; block = block->previous)
+      if (block->onHeap && data(block) == ptr) return block;
+    return nullptr;
+  }
+
+  void release(Block* block) {
+    block->released = true;
+    while (m_last && m_last->released) {
+      Block* top = m_last;
+      m_last = top->previous;
+      if (top->onHeap) {
+        internal::instrument_deallocation(data(top));
+        internal::handmade_aligned_free(top);
+      } else {
+        m_top = static_cast<std::size_t>(reinterpret_cast<uint8_t*>(top) - m_buffer);
+      }
+    }
+  }
+
+  void* m_owned;
+  uint8_t* m_buffer;
+  std::size_t m_capacity;
+  std::size_t m_top;
+  Block* m_last;
+  Workspace* m_previous;
+  bool m_active;
+  std::size_t m_peakUsed;
+  std::size_t m_requiredSize;
+  Index m_overflowCount;
+};
+
+/** \class ScopedWorkspace
+ * \ingroup Core_Module
+ *
+ * \brief Installs a Workspace for the heap allocations made by Eigen on the calling thread during its lifetime
+ *
+ * The scopes can be nested, with distinct workspaces.
+ *
+ * \sa class Workspace
+ */
+class ScopedWorkspace : internal::noncopyable {
+ public:
+  explicit ScopedWorkspace(Workspace& workspace) : m_workspace(workspace) {
+    eigen_assert(!workspace.m_active && "A workspace can only be installed by one ScopedWorkspace at a time");
+#ifdef EIGEN_WORKSPACE_THREAD_LOCAL
+    workspace.m_active = true;
+    workspace.m_previous = internal::current_workspace();
+    internal::current_workspace() = &workspace;
+#else
+    // A global workspace would be shared by all the threads.
+    eigen_assert(false && "ScopedWorkspace requires thread_local storage");
+#endif
+  }
+
+  ~ScopedWorkspace() {
+#ifdef EIGEN_WORKSPACE_THREAD_LOCAL
+    eigen_plain_assert(internal::current_workspace() == &m_workspace && "ScopedWorkspace objects must be nested");
+    eigen_plain_assert(m_workspace.m_last == nullptr &&
+                       "The allocations made in a ScopedWorkspace must be released before its end");
+    internal::current_workspace() = m_workspace.m_previous;
+    m_workspace.m_previous = nullptr;
+    m_workspace.m_active = false;
+#endif
+  }
+
+ private:
+  Workspace& m_workspace;
+};
+
+template <typename Func>
+std::size_t Workspace::measure(Func&& func) {
+  Workspace probe;
+  {
+    ScopedWorkspace scope(probe);
+    func();
+  }
+  return probe.requiredSize();
+}
+
+namespace internal {
+// Constructs a decomposition with its members allocated for rows x cols matrices, with the preallocating constructor
+// taking either both dimensions or the size of a square matrix.
+template <typename Decomposition>
+std::enable_if_t<std::is_constructible<Decomposition, Index, Index>::value, Decomposition>
+preallocated_decomposition(Index rows, Index cols) {
+  return Decomposition(rows, cols);
+}
+template <typename Decomposition>
+std::enable_if_t<!std::is_constructible<Decomposition, Index, Index>::value, Decomposition>
+preallocated_decomposition(Index rows, Index cols) {
+  eigen_assert(rows == cols && "The decomposition requires a square matrix");
+  EIGEN_UNUSED_VARIABLE(cols);
+  return Decomposition(rows);
+}
+}  // end namespace internal
+
+template <typename Decomposition, typename MatrixType>
+std::size_t Workspace::sizeFor(const MatrixType& matrix) {
+  Decomposition decomposition = internal::preallocated_decomposition<Decomposition>(matrix.rows(), matrix.cols());
+  return measure([&]() { decomposition.compute(matrix); });
+}
+
+/*****************************************************************************
+*** Large buffers mapped on huge pages                                     ***
+*****************************************************************************/
+
+#if defined(EIGEN_USE_HUGE_PAGES) && EIGEN_OS_UNIX && !defined(EIGEN_GPU_COMPILE_PHASE)
+#define EIGEN_HUGE_PAGES_ENABLED
+
+/** \ingroup Core_Module
+ * \brief The policy of the allocation of the large heap buffers
+ *
+ * When EIGEN_USE_HUGE_PAGES is defined, on Unix systems, the aligned heap allocations of at least \c threshold bytes
+ * are mapped directly from the system instead of calling malloc. They are aligned on \c alignment bytes and rounded
+ * up to a multiple of it, such that the system can back them with huge pages, which reduces the TLB misses of the
+ * matrix products on large matrices.
+ *
+ * \sa setLargeAllocationPolicy()
+ */
+struct LargeAllocationPolicy {
+  /** The size in bytes from which the allocations follow the policy, or 0 to disable it. Defaults to 32 MB. */
+  std::size_t threshold = std::size_t(32) << 20;
+  /** The alignment in bytes of the buffers, a power of 2. Defaults to 2 MB, the size of the huge pages of x86-64 and
+   * ARM64 processors. */
+  std::size_t alignment = std::size_t(2) << 20;
+  /** Whether to advise the system to back the buffers with transparent huge pages, on Linux. Defaults to true. */
+  bool hugePages = true;
+  /** Whether to touch the pages on allocation from the threads of the matrix products, each one a contiguous part of
+   * the buffer. With the first-touch NUMA policy of the system, the memory is placed close to the threads which
+   * compute on it when OpenMP binds its threads (e.g., \c OMP_PROC_BIND=close). Defaults to false. */
+  bool firstTouch = false;
+};
+
+namespace internal {
+
+inline LargeAllocationPolicy& large_allocation_policy() {
+  static LargeAllocationPolicy policy;
+  return policy;
+}
+
+// Touches the pages of the \a size bytes at \a ptr from the threads of the products, see Parallelizer.h.
+inline void first_touch(void* ptr, std::size_t size, std::size_t granularity);
+
+// The buffers currently mapped by large_aligned_malloc(). Each one is preceded by a page holding its mapping.
+struct large_allocation_registry {
+  static constexpr int Capacity = 256;
+  std::atomic<void*> buffers[Capacity] = {};
+  std::atomic<int> count{0};
+};
+
+inline large_allocation_registry& large_allocations() {
+  static large_allocation_registry registry;
+  return registry;
+}
+
+struct large_allocation_header {
+  void* begin;
+  std::size_t length;
+};
+
+inline std::size_t system_page_size() {
+  static const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return page;
+}
+
+/** \internal \returns the slot of the registry holding \a ptr, or null if it was not allocated by
+ * large_aligned_malloc(). */
+inline std::atomic<void*>* find_large_allocation(void* ptr) {
+  large_allocation_registry& registry = large_allocations();
+  if (registry.count.load(std::memory_order_relaxed) == 0 || (reinterpret_cast<std::size_t>(ptr) & 4095) != 0)
+    return nullptr;
+  for (std::atomic<void*>& buffer : registry.buffers)
+    if (buffer.load(std::memory_order_relaxed) == ptr) return &buffer;
+  return nullptr;
+}
+
+/** \internal Maps \a size bytes following the LargeAllocationPolicy.
+ * \returns null if the mapping failed or if too many buffers are mapped, in which case the caller falls back to
+ * malloc. */
+inline void* large_aligned_malloc(std::size_t size) {
+  const LargeAllocationPolicy& policy = large_allocation_policy();
+  const std::size_t page = system_page_size();
+  const std::size_t alignment = (std::max)(policy.alignment, page);
+  const std::size_t bytes = (size + alignment - 1) / alignment * alignment;
+  // The aligned buffer and the page of its header fit in alignment + bytes bytes, wherever the mapping starts.
+  const std::size_t length = alignment + bytes;
+  if (bytes < size || length < bytes) return nullptr;
+
+  check_that_malloc_is_allowed();
+  void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) return nullptr;
+  uint8_t* begin = static_cast<uint8_t*>(mapping);
+  uint8_t* data = reinterpret_cast<uint8_t*>((reinterpret_cast<std::size_t>(begin) + page + alignment - 1) &
+                                             ~(alignment - 1));
+  uint8_t* header = data - page;
+  uint8_t* end = begin + length;
+  // Give the unused parts of the mapping back to the system.
+  if (header > begin) munmap(begin, static_cast<std::size_t>(header - begin));
+  if (end > data + bytes) munmap(data + bytes, static_cast<std::size_t>(end - (data + bytes)));
+#ifdef MADV_HUGEPAGE
+  if (policy.hugePages) madvise(data, bytes, MADV_HUGEPAGE);
+#endif
+  large_allocation_header* info = reinterpret_cast<large_allocation_header*>(header);
+  info->begin = header;
+  info->length = page + bytes;
+
+  large_allocation_registry& registry = large_allocations();
+  for (std::atomic<void*>& buffer : registry.buffers) {
+    void* expected = nullptr;
+    if (buffer.compare_exchange_strong(expected, data, std::memory_order_relaxed)) {
+      registry.count.fetch_add(1, std::memory_order_relaxed);
+      if (policy.firstTouch) first_touch(data, bytes, alignment);
+      return data;
+    }
+  }
+  munmap(header, page + bytes);
+  return nullptr;
+}
+
+/** \internal Unmaps \a ptr if it was allocated by large_aligned_malloc().
+ * \returns whether it was */
+inline bool large_aligned_free(void* ptr) {
+  std::atomic<void*>* buffer = find_large_allocation(ptr);
+  if (!buffer) return false;
+  buffer->store(nullptr, std::memory_order_relaxed);
+  large_allocations().count.fetch_sub(1, std::memory_order_relaxed);
+  const large_allocation_header* info =
+      reinterpret_cast<const large_allocation_header*>(static_cast<uint8_t*>(ptr) - system_page_size());
+  check_that_malloc_is_allowed();
+  munmap(info->begin, info->length);
+  return true;
+}
+
+}  // end namespace internal
+
+/** \ingroup Core_Module
+ * Sets the policy of the allocation of the large heap buffers. It only affects the later allocations, and should not
+ * be called while another thread allocates.
+ *
+ * Only available when EIGEN_USE_HUGE_PAGES is defined, on Unix systems.
+ *
+ * \sa largeAllocationPolicy(), LargeAllocationPolicy
+ */
+inline void setLargeAllocationPolicy(const LargeAllocationPolicy& policy) {
+  eigen_assert((policy.alignment & (policy.alignment - 1)) == 0 && "The alignment must be a power of 2");
+  internal::large_allocation_policy() = policy;
+}
+
+/** \ingroup Core_Module
+ * \returns the policy of the allocation of the large heap buffers
+ * \sa setLargeAllocationPolicy()
+ */
+inline LargeAllocationPolicy largeAllocationPolicy() { return internal::large_allocation_policy(); }
+
+#endif  // EIGEN_HUGE_PAGES_ENABLED
+
+namespace internal {
+
+// The hooks of aligned_malloc(), aligned_free() and aligned_realloc() into the installed workspaces.
+struct workspace_access {
+  static void* allocate(std::size_t size) {
+    Workspace* workspace = current_workspace();
+    if (!workspace) return nullptr;
+    void* result = workspace->allocate(size);
+    if (!result) throw_std_bad_alloc();
+    return result;
+  }
+
+  static bool release(void* ptr) {
+    for (Workspace* workspace = current_workspace(); workspace; workspace = workspace->m_previous) {
+      if (Workspace::Block* block = workspace->find(ptr)) {
+        workspace->release(block);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // The blocks of the workspaces are moved, to keep them in last-in first-out order.
+  static bool reallocate(void*& ptr, std::size_t new_size, std::size_t old_size) {
+    for (Workspace* workspace = current_workspace(); workspace; workspace = workspace->m_previous) {
+      if (Workspace::Block* block = workspace->find(ptr)) {
+        void* result = current_workspace()->allocate(new_size);
+        if (!result) throw_std_bad_alloc();
+        std::memcpy(result, ptr, (std::min)(new_size, old_size));
+        workspace->release(block);
+        ptr = result;
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+// In the variants of Eigen/DispatchVariant, the aligned allocations follow the alignment of the instruction set of the
+// variant, whichever copies of the inline functions of the application the linker keeps.
+#ifdef EIGEN_DISPATCH_VARIANT
+inline namespace EIGEN_KERNEL_NAMESPACE {
+#endif
+
 /** \internal Allocates \a size bytes. The returned pointer is guaranteed to have 16 or 32 bytes alignment depending on
  * the requirements. On allocation error, the returned pointer is null, and std::bad_alloc is thrown.
  */
@@ -200,6 +686,17 @@ EIGEN_DEVICE_FUNC inline void* aligned_malloc(std::size_t size) {
   if (size == 0) return nullptr;
 
   void* result;
+#ifndef EIGEN_GPU_COMPILE_PHASE
+  result = workspace_access::allocate(size);
+  if (result) return result;
+#endif
+#ifdef EIGEN_HUGE_PAGES_ENABLED
+  const std::size_t threshold = large_allocation_policy().threshold;
+  if (threshold > 0 && size >= threshold && (result = large_aligned_malloc(size)) != nullptr) {
+    instrument_allocation(result, size);
+    return result;
+  }
+#endif
 #if (EIGEN_DEFAULT_ALIGN_BYTES == 0) || EIGEN_MALLOC_ALREADY_ALIGNED
 
   check_that_malloc_is_allowed();
@@ -216,12 +713,20 @@ EIGEN_DEVICE_FUNC inline void* aligned_malloc(std::size_t size) {
 #endif
 
   if (!result && size) throw_std_bad_alloc();
+  instrument_allocation(result, size);
 
   return result;
 }
 
 /** \internal Frees memory allocated with aligned_malloc. */
 EIGEN_DEVICE_FUNC inline void aligned_free(void* ptr) {
+#ifndef EIGEN_GPU_COMPILE_PHASE
+  if (ptr != nullptr && workspace_access::release(ptr)) return;
+#endif
+  if (ptr != nullptr) instrument_deallocation(ptr);
+#ifdef EIGEN_HUGE_PAGES_ENABLED
+  if (ptr != nullptr && large_aligned_free(ptr)) return;
+#endif
 #if (EIGEN_DEFAULT_ALIGN_BYTES == 0) || EIGEN_MALLOC_ALREADY_ALIGNED
 
   if (ptr != nullptr) {
@@ -249,6 +754,19 @@ EIGEN_DEVICE_FUNC inline void* aligned_realloc(void* ptr, std::size_t new_size,
   }
 
   void* result;
+#ifndef EIGEN_GPU_COMPILE_PHASE
+  if (workspace_access::reallocate(ptr, new_size, old_size)) return ptr;
+#endif
+#ifdef EIGEN_HUGE_PAGES_ENABLED
+  // The buffers are moved to and from the mappings of the large allocations.
+  const std::size_t threshold = large_allocation_policy().threshold;
+  if (find_large_allocation(ptr) || (threshold > 0 && new_size >= threshold)) {
+    result = aligned_malloc(new_size);
+    std::memcpy(result, ptr, (std::min)(new_size, old_size));
+    aligned_free(ptr);
+    return result;
+  }
+#endif
 #if (EIGEN_DEFAULT_ALIGN_BYTES == 0) || EIGEN_MALLOC_ALREADY_ALIGNED
   EIGEN_UNUSED_VARIABLE(old_size)
 
@@ -260,6 +778,7 @@ EIGEN_DEVICE_FUNC inline void* aligned_realloc(void* ptr, std::size_t new_size,
 #endif
 
   if (!result && new_size) throw_std_bad_alloc();
+  instrument_reallocation(result, new_size, old_size);
 
   return result;
 }
@@ -285,6 +804,7 @@ EIGEN_DEVICE_FUNC inline void* conditional_aligned_malloc<false>(std::size_t siz
   void* result = malloc(size);
 
   if (!result && size) throw_std_bad_alloc();
+  instrument_allocation(result, size);
   return result;
 }
 
@@ -297,6 +817,7 @@ EIGEN_DEVICE_FUNC inline void conditional_aligned_free(void* ptr) {
 template <>
 EIGEN_DEVICE_FUNC inline void conditional_aligned_free<false>(void* ptr) {
   if (ptr != nullptr) {
+    instrument_deallocation(ptr);
     check_that_malloc_is_allowed();
     EIGEN_USING_STD(free)
     free(ptr);
@@ -320,7 +841,9 @@ EIGEN_DEVICE_FUNC inline void* conditional_aligned_realloc<false>(void* ptr, std
 
   check_that_malloc_is_allowed();
   EIGEN_USING_STD(realloc)
-  return realloc(ptr, new_size);
+  void* result = realloc(ptr, new_size);
+  if (result) instrument_reallocation(result, new_size, old_size);
+  return result;
 }
 
 /*****************************************************************************
@@ -504,6 +1027,10 @@ EIGEN_DEVICE_FUNC inline void conditional_aligned_delete_auto(T* ptr, std::size_
   conditional_aligned_free<Align>(ptr);
 }
 
+#ifdef EIGEN_DISPATCH_VARIANT
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
+#endif
+
 /****************************************************************************/
 
 /** \internal Returns the index of the first element of the array that is well aligned with respect to the requested \a
@@ -644,6 +1171,10 @@ EIGEN_DEVICE_FUNC T* smart_move(T* start, T* end, T* target) {
 #undef EIGEN_ALLOCA
 #endif
 
+#ifdef EIGEN_DISPATCH_VARIANT
+inline namespace EIGEN_KERNEL_NAMESPACE {
+#endif
+
 // This helper class construct the allocated memory, and takes care of destructing and freeing the handled data
 // at destruction time. In practice this helper class is mainly useful to avoid memory leak in case of exceptions.
 template <typename T>
@@ -670,6 +1201,10 @@ class aligned_stack_memory_handler : noncopyable {
   bool m_deallocate;
 };
 
+#ifdef EIGEN_DISPATCH_VARIANT
+}  // end inline namespace EIGEN_KERNEL_NAMESPACE
+#endif
+
 #ifdef EIGEN_ALLOCA
 
 template <typename Xpr, int NbEvaluations,
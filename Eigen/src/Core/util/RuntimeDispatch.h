@@ -0,0 +1,132 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_RUNTIME_DISPATCH_H
+#define EIGEN_RUNTIME_DISPATCH_H
+
+// Note that this header is also included by Eigen/DispatchVariant before Eigen/Core, in the real Eigen namespace,
+// so it must only depend on the standard library.
+#include <cstddef>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// The heavy kernels are forwarded to the variants registered at runtime only in the translation units of the
+// application, and never from within a variant itself.
+#if defined(EIGEN_RUNTIME_DISPATCH) && !defined(EIGEN_DISPATCH_VARIANT) && !defined(__CUDACC__) && \
+    !defined(__HIPCC__) && !defined(__SYCL_DEVICE_ONLY__)
+#define EIGEN_DISPATCH_TO_VARIANTS
+#endif
+
+namespace Eigen {
+
+namespace internal {
+
+#ifdef EIGEN_DEFAULT_DENSE_INDEX_TYPE
+typedef EIGEN_DEFAULT_DENSE_INDEX_TYPE dispatch_index;
+#else
+typedef std::ptrdiff_t dispatch_index;
+#endif
+
+/* Instruction set levels of the kernel variants, in increasing order:
+ *  - DispatchSSE4_2: SSE up to SSE4.2,
+ *  - DispatchAVX2:   AVX, AVX2 and FMA,
+ *  - DispatchAVX512: AVX512 F, DQ, BW and VL. */
+enum dispatch_isa { DispatchGeneric = 0, DispatchSSE4_2 = 1, DispatchAVX2 = 2, DispatchAVX512 = 3 };
+
+// Returns the highest instruction set level supported by the host CPU and operating system.
+inline int detect_dispatch_isa() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+      __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+    return DispatchAVX512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return DispatchAVX2;
+  if (__builtin_cpu_supports("sse4.2")) return DispatchSSE4_2;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+  if (max_leaf < 1) return DispatchGeneric;
+  __cpuid(info, 1);
+  const bool sse4_2 = (info[2] & (1 << 20)) != 0;
+  const bool fma = (info[2] & (1 << 12)) != 0;
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  // The operating system must save the AVX (and AVX512) registers on context switches.
+  const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+  const bool os_avx = (xcr0 & 0x6) == 0x6;
+  const bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+  if (max_leaf >= 7) {
+    __cpuidex(info, 7, 0);
+    const unsigned ebx = static_cast<unsigned>(info[1]);
+    const bool avx2 = (ebx & (1u << 5)) != 0;
+    // AVX512 F, DQ, BW and VL.
+    const unsigned avx512_bits = (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31);
+    const bool avx512 = (ebx & avx512_bits) == avx512_bits;
+    if (os_avx512 && avx512 && avx2 && fma) return DispatchAVX512;
+    if (os_avx && avx2 && fma) return DispatchAVX2;
+  }
+  if (sse4_2) return DispatchSSE4_2;
+#endif
+  return DispatchGeneric;
+}
+
+/* Thread pool tiles of a general matrix-matrix product, see GemmParallelTileInfo. A variant computes the tile
+ * first_tile, and then repeatedly claims the next one until all of them are taken, calling finish on each tile it
+ * completes. */
+struct dispatch_gemm_tiles {
+  dispatch_index tile_rows;
+  dispatch_index tile_cols;
+  dispatch_index num_row_tiles;
+  dispatch_index num_tiles;
+  dispatch_index first_tile;
+  void* context;
+  dispatch_index (*claim)(void* context);
+  void (*finish)(void* context);
+};
+
+/* Kernels compiled for a given instruction set level. All of them operate on unconjugated real operands.
+ *  - gemm: res += alpha * lhs * rhs, for a column-major res of unit inner stride, optionally split into tiles.
+ *  - gemv: res += alpha * lhs * rhs, for a vector rhs of increment rhsIncr and a vector res of increment resIncr.
+ *  - trsm: solves tri * X = other (side == OnTheLeft) or X * tri = other (side == OnTheRight) in place, for a
+ *          triangular matrix tri of the given Mode and a column-major other of unit inner stride. */
+template <typename Scalar>
+struct dispatch_kernels {
+  int isa;
+  void (*gemm)(dispatch_index rows, dispatch_index cols, dispatch_index depth, const Scalar* lhs,
+               dispatch_index lhsStride, bool lhsRowMajor, const Scalar* rhs, dispatch_index rhsStride,
+               bool rhsRowMajor, Scalar* res, dispatch_index resStride, Scalar alpha, const dispatch_gemm_tiles* tiles);
+  void (*gemv)(dispatch_index rows, dispatch_index cols, const Scalar* lhs, dispatch_index lhsStride, bool lhsRowMajor,
+               const Scalar* rhs, dispatch_index rhsIncr, Scalar* res, dispatch_index resIncr, Scalar alpha);
+  void (*trsm)(int side, int mode, bool triRowMajor, dispatch_index size, dispatch_index otherSize, const Scalar* tri,
+               dispatch_index triStride, Scalar* other, dispatch_index otherStride);
+};
+
+// Kernels of the best variant registered so far for the host, or null pointers. Being zero-initialized, the table
+// is available before any dynamic initialization takes place.
+template <typename Scalar>
+inline dispatch_kernels<Scalar>& dispatched_kernels() {
+  static dispatch_kernels<Scalar> kernels;
+  return kernels;
+}
+
+// Called at static initialization time by every variant, see Eigen/DispatchVariant.
+template <typename Scalar>
+inline void register_dispatch_kernels(const dispatch_kernels<Scalar>& variant) {
+  dispatch_kernels<Scalar>& current = dispatched_kernels<Scalar>();
+  if (variant.isa > detect_dispatch_isa()) return;
+  if (current.isa == DispatchGeneric || variant.isa > current.isa) current = variant;
+}
+
+}  // end namespace internal
+
+}  // end namespace Eigen
+
+#endif  // EIGEN_RUNTIME_DISPATCH_H
@@ -243,6 +243,7 @@ template <typename MatrixType>
 template <typename InputType>
 ComplexEigenSolver<MatrixType>& ComplexEigenSolver<MatrixType>::compute(const EigenBase<InputType>& matrix,
                                                                         bool computeEigenvectors) {
+  EIGEN_INSTRUMENTED_REGION("ComplexEigenSolver::compute");
   // this code is inspired from Jampack
   eigen_assert(matrix.cols() == matrix.rows());
 
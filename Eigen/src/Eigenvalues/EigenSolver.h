@@ -364,6 +364,7 @@ template <typename MatrixType>
 template <typename InputType>
 EigenSolver<MatrixType>& EigenSolver<MatrixType>::compute(const EigenBase<InputType>& matrix,
                                                           bool computeEigenvectors) {
+  EIGEN_INSTRUMENTED_REGION("EigenSolver::compute");
   check_template_parameters();
 
   using numext::isfinite;
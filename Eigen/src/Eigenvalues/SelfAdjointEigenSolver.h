@@ -408,6 +408,7 @@ template <typename MatrixType>
 template <typename InputType>
 EIGEN_DEVICE_FUNC SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>::compute(
     const EigenBase<InputType>& a_matrix, int options) {
+  EIGEN_INSTRUMENTED_REGION("SelfAdjointEigenSolver::compute");
   const InputType& matrix(a_matrix.derived());
 
   EIGEN_USING_STD(abs);
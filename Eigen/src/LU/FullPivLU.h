@@ -457,6 +457,7 @@ FullPivLU<MatrixType, PermutationIndex>::FullPivLU(EigenBase<InputType>& matrix)
 
 template <typename MatrixType, typename PermutationIndex>
 void FullPivLU<MatrixType, PermutationIndex>::computeInPlace() {
+  EIGEN_INSTRUMENTED_REGION("FullPivLU::compute");
   eigen_assert(m_lu.rows() <= NumTraits<PermutationIndex>::highest() &&
                m_lu.cols() <= NumTraits<PermutationIndex>::highest());
 
@@ -479,6 +479,7 @@ void partial_lu_inplace(MatrixType& lu, TranspositionType& row_transpositions,
 
 template <typename MatrixType, typename PermutationIndex>
 void PartialPivLU<MatrixType, PermutationIndex>::compute() {
+  EIGEN_INSTRUMENTED_REGION("PartialPivLU::compute");
   eigen_assert(m_lu.rows() < NumTraits<PermutationIndex>::highest());
 
   if (m_lu.cols() > 0)
@@ -483,6 +483,7 @@ FullPivHouseholderQR<MatrixType, PermutationIndex>& FullPivHouseholderQR<MatrixT
 
 template <typename MatrixType, typename PermutationIndex>
 void FullPivHouseholderQR<MatrixType, PermutationIndex>::computeInPlace() {
+  EIGEN_INSTRUMENTED_REGION("FullPivHouseholderQR::compute");
   eigen_assert(m_qr.cols() <= NumTraits<PermutationIndex>::highest());
   using std::abs;
   Index rows = m_qr.rows();
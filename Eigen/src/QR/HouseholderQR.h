@@ -505,6 +505,7 @@ void HouseholderQR<MatrixType_>::_solve_impl_transposed(const RhsType& rhs, DstT
  */
 template <typename MatrixType>
 void HouseholderQR<MatrixType>::computeInPlace() {
+  EIGEN_INSTRUMENTED_REGION("HouseholderQR::compute");
   Index rows = m_qr.rows();
   Index cols = m_qr.cols();
   Index size = (std::min)(rows, cols);
@@ -327,6 +327,7 @@ void BDCSVD<MatrixType, Options>::allocate(Index rows, Index cols, unsigned int
 template <typename MatrixType, int Options>
 BDCSVD<MatrixType, Options>& BDCSVD<MatrixType, Options>::compute_impl(const MatrixType& matrix,
                                                                        unsigned int computationOptions) {
+  EIGEN_INSTRUMENTED_REGION("BDCSVD::compute");
 #ifdef EIGEN_BDCSVD_DEBUG_VERBOSE
   std::cout << "\n\n\n================================================================================================="
                "=====================\n\n\n";
@@ -664,6 +664,7 @@ class JacobiSVD : public SVDBase<JacobiSVD<MatrixType_, Options_> > {
 template <typename MatrixType, int Options>
 JacobiSVD<MatrixType, Options>& JacobiSVD<MatrixType, Options>::compute_impl(const MatrixType& matrix,
                                                                              unsigned int computationOptions) {
+  EIGEN_INSTRUMENTED_REGION("JacobiSVD::compute");
   using std::abs;
 
   allocate(matrix.rows(), matrix.cols(), computationOptions);
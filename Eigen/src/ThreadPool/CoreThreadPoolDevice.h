@@ -13,31 +13,10 @@
 namespace Eigen {
 
 // CoreThreadPoolDevice provides an easy-to-understand Device for parallelizing Eigen Core expressions with
-// Threadpool. Expressions are recursively split evenly until the evaluation cost is less than the threshold for
-// delegating the task to a thread.
-/*
-                 a
-                / \
-               /   \
-              /     \
-             /       \
-            /         \
-           /           \
-          /             \
-         a               e
-        / \             / \
-       /   \           /   \
-      /     \         /     \
-     a       c       e       g
-    / \     / \     / \     / \
-   /   \   /   \   /   \   /   \
-  a     b c     d e     f g     h
-*/
-// Each task descends the binary tree to the left, delegates the right task to a new thread, and continues to the
-// left. This ensures that work is evenly distributed to the thread pool as quickly as possible and minimizes the number
-// of tasks created during the evaluation. Consider an expression that is divided into 8 chunks. The
-// primary task 'a' creates tasks 'e' 'c' and 'b', and executes its portion of the expression at the bottom of the
-// tree. Likewise, task 'e' creates tasks 'g' and 'f', and executes its portion of the expression.
+// Threadpool. Expressions are split evenly into 2^l chunks of consecutive packets, such that the evaluation cost of a
+// chunk is about the threshold for delegating the task to a thread. The threads of the pool, and the calling thread
+// while it waits, claim the chunks of a single batch (see TaskGroup::RunBatch) rather than tasks of their own. So
+// evaluating an expression enqueues at most one task per thread, whatever the number of chunks.
 
 struct CoreThreadPoolDevice {
   using Task = std::function<void()>;
@@ -62,70 +41,14 @@ struct CoreThreadPoolDevice {
     return maxLevel;
   }
 
-// MSVC does not like inlining parallelForImpl
-#if EIGEN_COMP_MSVC && !EIGEN_COMP_CLANG
-#define EIGEN_PARALLEL_FOR_INLINE
-#else
-#define EIGEN_PARALLEL_FOR_INLINE EIGEN_STRONG_INLINE
-#endif
-
-  template <typename UnaryFunctor, int PacketSize>
-  EIGEN_DEVICE_FUNC EIGEN_PARALLEL_FOR_INLINE void parallelForImpl(Index begin, Index end, UnaryFunctor& f,
-                                                                   Barrier& barrier, int level) {
-    while (level > 0) {
-      level--;
-      Index size = end - begin;
-      eigen_assert(size % PacketSize == 0 && "this function assumes size is a multiple of PacketSize");
-      Index mid = begin + numext::round_down(size >> 1, PacketSize);
-      Task right = [this, mid, end, &f, &barrier, level]() {
-        parallelForImpl<UnaryFunctor, PacketSize>(mid, end, f, barrier, level);
-      };
-      m_pool.Schedule(std::move(right));
-      end = mid;
-    }
-    for (Index i = begin; i < end; i += PacketSize) f(i);
-    barrier.Notify();
-  }
-
-  template <typename BinaryFunctor, int PacketSize>
-  EIGEN_DEVICE_FUNC EIGEN_PARALLEL_FOR_INLINE void parallelForImpl(Index outerBegin, Index outerEnd, Index innerBegin,
-                                                                   Index innerEnd, BinaryFunctor& f, Barrier& barrier,
-                                                                   int level) {
-    while (level > 0) {
-      level--;
-      Index outerSize = outerEnd - outerBegin;
-      if (outerSize > 1) {
-        Index outerMid = outerBegin + (outerSize >> 1);
-        Task right = [this, &f, &barrier, outerMid, outerEnd, innerBegin, innerEnd, level]() {
-          parallelForImpl<BinaryFunctor, PacketSize>(outerMid, outerEnd, innerBegin, innerEnd, f, barrier, level);
-        };
-        m_pool.Schedule(std::move(right));
-        outerEnd = outerMid;
-      } else {
-        Index innerSize = innerEnd - innerBegin;
-        eigen_assert(innerSize % PacketSize == 0 && "this function assumes innerSize is a multiple of PacketSize");
-        Index innerMid = innerBegin + numext::round_down(innerSize >> 1, PacketSize);
-        Task right = [this, &f, &barrier, outerBegin, outerEnd, innerMid, innerEnd, level]() {
-          parallelForImpl<BinaryFunctor, PacketSize>(outerBegin, outerEnd, innerMid, innerEnd, f, barrier, level);
-        };
-        m_pool.Schedule(std::move(right));
-        innerEnd = innerMid;
-      }
-    }
-    for (Index outer = outerBegin; outer < outerEnd; outer++)
-      for (Index inner = innerBegin; inner < innerEnd; inner += PacketSize) f(outer, inner);
-    barrier.Notify();
-  }
-
-#undef EIGEN_PARALLEL_FOR_INLINE
-
   template <typename UnaryFunctor, int PacketSize>
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void parallelFor(Index begin, Index end, UnaryFunctor& f, float cost) {
     Index size = end - begin;
+    eigen_assert(size % PacketSize == 0 && "this function assumes size is a multiple of PacketSize");
     int maxLevel = calculateLevels<PacketSize>(size, cost);
-    Barrier barrier(1 << maxLevel);
-    parallelForImpl<UnaryFunctor, PacketSize>(begin, end, f, barrier, maxLevel);
-    barrier.Wait();
+    parallelForPackets(size / PacketSize, maxLevel, [&](Index firstPacket, Index lastPacket) {
+      for (Index i = begin + firstPacket * PacketSize; i < begin + lastPacket * PacketSize; i += PacketSize) f(i);
+    });
   }
 
   template <typename BinaryFunctor, int PacketSize>
@@ -133,11 +56,35 @@ struct CoreThreadPoolDevice {
                                                          Index innerEnd, BinaryFunctor& f, float cost) {
     Index outerSize = outerEnd - outerBegin;
     Index innerSize = innerEnd - innerBegin;
+    eigen_assert(innerSize % PacketSize == 0 && "this function assumes innerSize is a multiple of PacketSize");
     Index size = outerSize * innerSize;
     int maxLevel = calculateLevels<PacketSize>(size, cost);
-    Barrier barrier(1 << maxLevel);
-    parallelForImpl<BinaryFunctor, PacketSize>(outerBegin, outerEnd, innerBegin, innerEnd, f, barrier, maxLevel);
-    barrier.Wait();
+    // The packets are numbered along the inner dimension first.
+    const Index innerPackets = innerSize / PacketSize;
+    parallelForPackets(outerSize * innerPackets, maxLevel, [&](Index firstPacket, Index lastPacket) {
+      for (Index packet = firstPacket; packet < lastPacket;) {
+        const Index outer = packet / innerPackets;
+        const Index stop = numext::mini(lastPacket, (outer + 1) * innerPackets);
+        for (Index inner = innerBegin + (packet - outer * innerPackets) * PacketSize; packet < stop;
+             ++packet, inner += PacketSize)
+          f(outerBegin + outer, inner);
+      }
+    });
+  }
+
+  // Calls body(firstPacket, lastPacket) on the 2^maxLevel chunks of [0, numPackets).
+  template <typename Body>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void parallelForPackets(Index numPackets, int maxLevel, const Body& body) {
+    const Index chunks = Index(1) << maxLevel;
+    if (chunks == 1 || numPackets == 0) {
+      body(0, numPackets);
+      return;
+    }
+    TaskGroup group(m_pool);
+    group.RunBatch(chunks, [&](Index first, Index last) {
+      body(first * numPackets / chunks, last * numPackets / chunks);
+    });
+    group.Wait();
   }
 
   ThreadPool& m_pool;
@@ -272,6 +219,30 @@ struct dense_assignment_loop_with_device<Kernel, CoreThreadPoolDevice, SliceVect
   };
 };
 
+#if EIGEN_UNALIGNED_VECTORIZE
+template <typename Kernel>
+struct dense_assignment_loop_with_device<Kernel, CoreThreadPoolDevice, SliceVectorizedTraversal, InnerUnrolling> {
+  using PacketType = typename Kernel::PacketType;
+  using DstXprType = typename Kernel::DstEvaluatorType::XprType;
+  static constexpr Index XprEvaluationCost = cost_helper<Kernel>::Cost, PacketSize = unpacket_traits<PacketType>::size,
+                         InnerSize = DstXprType::InnerSizeAtCompileTime,
+                         VectorizableSize = numext::round_down(InnerSize, PacketSize);
+  struct AssignmentFunctor : public Kernel {
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE AssignmentFunctor(Kernel& kernel) : Kernel(kernel) {}
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void operator()(Index outer) {
+      copy_using_evaluator_innervec_InnerUnrolling<Kernel, 0, VectorizableSize, 0, 0>::run(*this, outer);
+      copy_using_evaluator_DefaultTraversal_InnerUnrolling<Kernel, VectorizableSize, InnerSize>::run(*this, outer);
+    }
+  };
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void run(Kernel& kernel, CoreThreadPoolDevice& device) {
+    const Index outerSize = kernel.outerSize();
+    constexpr float cost = static_cast<float>(XprEvaluationCost) * static_cast<float>(InnerSize);
+    AssignmentFunctor functor(kernel);
+    device.template parallelFor<AssignmentFunctor, 1>(0, outerSize, functor, cost);
+  }
+};
+#endif
+
 template <typename Kernel>
 struct dense_assignment_loop_with_device<Kernel, CoreThreadPoolDevice, LinearTraversal, NoUnrolling> {
   static constexpr Index XprEvaluationCost = cost_helper<Kernel>::Cost;
@@ -295,8 +266,9 @@ struct dense_assignment_loop_with_device<Kernel, CoreThreadPoolDevice, LinearVec
                          RequestedAlignment = Kernel::AssignmentTraits::LinearRequiredAlignment,
                          PacketSize = unpacket_traits<PacketType>::size,
                          DstIsAligned = Kernel::AssignmentTraits::DstAlignment >= RequestedAlignment,
-                         DstAlignment = packet_traits<Scalar>::AlignedOnScalar ? RequestedAlignment
-                                                                               : Kernel::AssignmentTraits::DstAlignment,
+                         DstAlignment = packet_traits<Scalar>::AlignedOnScalar
+                                            ? int(RequestedAlignment)
+                                            : int(Kernel::AssignmentTraits::DstAlignment),
                          SrcAlignment = Kernel::AssignmentTraits::JointAlignment;
   struct AssignmentFunctor : public Kernel {
     EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE AssignmentFunctor(Kernel& kernel) : Kernel(kernel) {}
@@ -320,6 +292,217 @@ struct dense_assignment_loop_with_device<Kernel, CoreThreadPoolDevice, LinearVec
   }
 };
 
+// specialization of full reductions for CoreThreadPoolDevice
+// The expression is split into chunks of consecutive outer vectors, or into chunks of consecutive inner coefficients of
+// all the outer vectors if there are too few of them. Each chunk is reduced by the usual vectorized reducers.
+// If EIGEN_DETERMINISTIC_REDUCTIONS is defined, the chunks are rather aligned ranges of 2^l leaves of the fixed-shape
+// tree, such that the result is the same as the one of the sequential reduction.
+template <typename Xpr, typename Func>
+struct redux_with_device<Xpr, Func, CoreThreadPoolDevice> {
+  using Scalar = typename Xpr::Scalar;
+  // products and other expensive expressions are evaluated once beforehand
+  using XprNested = typename nested_eval<Xpr, 1>::type;
+  using XprNestedCleaned = remove_all_t<XprNested>;
+  using BlockType = Block<const XprNestedCleaned>;
+  static constexpr bool IsRowMajor = XprNestedCleaned::IsRowMajor;
+  static constexpr float Cost = static_cast<float>(evaluator<XprNestedCleaned>::CoeffReadCost) +
+                                static_cast<float>(functor_traits<Func>::Cost);
+  struct ChunkFunctor {
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void operator()(Index chunk) {
+      const Index begin = chunk * splitSize / chunks, end = (chunk + 1) * splitSize / chunks;
+      const Index outerBegin = splitOuter ? begin : 0, outerLength = splitOuter ? end - begin : xpr.outerSize();
+      const Index innerBegin = splitOuter ? 0 : begin, innerLength = splitOuter ? xpr.innerSize() : end - begin;
+      BlockType block(xpr, IsRowMajor ? outerBegin : innerBegin, IsRowMajor ? innerBegin : outerBegin,
+                      IsRowMajor ? outerLength : innerLength, IsRowMajor ? innerLength : outerLength);
+      results[chunk] = block.redux(func);
+    }
+    const XprNestedCleaned& xpr;
+    const Func& func;
+    Scalar* results;
+    Index chunks, splitSize;
+    bool splitOuter;
+  };
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+  using ThisEvaluator = redux_evaluator<XprNestedCleaned>;
+  struct DeterministicChunkFunctor {
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void operator()(Index chunk) {
+      const Index begin = chunk * leavesPerChunk, end = numext::mini(begin + leavesPerChunk, leaves);
+      results[chunk] = deterministic_redux_impl<Func, ThisEvaluator>::run(eval, func, xpr, begin, end);
+    }
+    const ThisEvaluator& eval;
+    const XprNestedCleaned& xpr;
+    const Func& func;
+    Scalar* results;
+    Index leaves, leavesPerChunk;
+  };
+#endif
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar run(const Xpr& xpr, const Func& func,
+                                                          CoreThreadPoolDevice& device) {
+    XprNested nested(xpr);
+    const XprNestedCleaned& actualXpr = nested;
+    Index chunks = Index(1) << device.template calculateLevels<1>(actualXpr.size(), Cost);
+    if (chunks == 1) return actualXpr.redux(func);
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+    const Index leaves = deterministic_redux_shape::leaves(actualXpr.size());
+    Index leavesPerChunk = 1;
+    while (leavesPerChunk * chunks < leaves) leavesPerChunk *= 2;
+    chunks = numext::div_ceil(leaves, leavesPerChunk);
+    if (chunks == 1) return actualXpr.redux(func);
+    ei_declare_aligned_stack_constructed_variable(Scalar, results, chunks, 0);
+    ThisEvaluator eval(actualXpr);
+    DeterministicChunkFunctor functor{eval, actualXpr, func, results, leaves, leavesPerChunk};
+    const float chunkCost = static_cast<float>(actualXpr.size()) * Cost / static_cast<float>(chunks);
+    device.template parallelFor<DeterministicChunkFunctor, 1>(0, chunks, functor, chunkCost);
+#else
+    const Index outerSize = actualXpr.outerSize(), innerSize = actualXpr.innerSize();
+    const bool splitOuter = outerSize >= numext::mini(chunks, innerSize);
+    const Index splitSize = splitOuter ? outerSize : innerSize;
+    chunks = numext::mini(chunks, splitSize);
+    ei_declare_aligned_stack_constructed_variable(Scalar, results, chunks, 0);
+    ChunkFunctor functor{actualXpr, func, results, chunks, splitSize, splitOuter};
+    const float chunkCost = static_cast<float>(actualXpr.size()) * Cost / static_cast<float>(chunks);
+    device.template parallelFor<ChunkFunctor, 1>(0, chunks, functor, chunkCost);
+#endif
+    return pairwise_redux(func, results, chunks);
+  }
+};
+
+// The ThreadPool module is included by Core before VectorwiseOp.h when EIGEN_GEMM_THREADPOOL is defined.
+template <typename ResultType, typename Scalar>
+struct member_sum;
+template <typename ResultType, typename Scalar>
+struct member_prod;
+template <typename ResultType, typename Scalar>
+struct member_minCoeff;
+template <typename ResultType, typename Scalar>
+struct member_maxCoeff;
+template <typename BinaryOp, typename Scalar>
+struct member_redux;
+
+// whether the reductions of a partial reduction can be split and their partial results combined with binaryFunc()
+template <typename MemberOp>
+struct partial_redux_is_splittable : std::false_type {};
+template <typename ResultType, typename Scalar>
+struct partial_redux_is_splittable<member_sum<ResultType, Scalar>> : std::true_type {};
+template <typename ResultType, typename Scalar>
+struct partial_redux_is_splittable<member_prod<ResultType, Scalar>> : std::true_type {};
+template <typename ResultType, typename Scalar>
+struct partial_redux_is_splittable<member_minCoeff<ResultType, Scalar>> : std::true_type {};
+template <typename ResultType, typename Scalar>
+struct partial_redux_is_splittable<member_maxCoeff<ResultType, Scalar>> : std::true_type {};
+template <typename BinaryOp, typename Scalar>
+struct partial_redux_is_splittable<member_redux<BinaryOp, Scalar>> : std::true_type {};
+
+// specialization of partial reductions for CoreThreadPoolDevice
+// The reductions are split into chunks of consecutive reductions. If there are too few of them, and if the member
+// operation allows it, each reduction is rather split into chunks of consecutive coefficients, whose partial results
+// are combined pairwise. Each chunk is evaluated by the usual vectorized partial reduction.
+template <typename DstXprType, typename ArgType, typename MemberOp, int Direction, typename Functor, typename Weak>
+struct AssignmentWithDevice<DstXprType, PartialReduxExpr<ArgType, MemberOp, Direction>, Functor, CoreThreadPoolDevice,
+                            Dense2Dense, Weak> {
+  using SrcXprType = PartialReduxExpr<ArgType, MemberOp, Direction>;
+  using Scalar = typename SrcXprType::Scalar;
+  using ArgNested = typename nested_eval<ArgType, 1>::type;
+  using ArgNestedCleaned = remove_all_t<ArgNested>;
+  using ChunkXprType = PartialReduxExpr<Block<const ArgNestedCleaned>, MemberOp, Direction>;
+  // partial results of the reductions, stored as the destination
+  using PartialsType = Matrix<Scalar, Dynamic, Dynamic, Direction == Vertical ? RowMajor : ColMajor>;
+#ifdef EIGEN_DETERMINISTIC_REDUCTIONS
+  // splitting the reductions along their coefficients would change the shape of their trees
+  static constexpr bool SplitCoefficients = false;
+#else
+  static constexpr bool SplitCoefficients = partial_redux_is_splittable<MemberOp>::value;
+#endif
+  // cost of reducing one more coefficient
+  static constexpr float Cost =
+      static_cast<float>(evaluator<ArgNestedCleaned>::CoeffReadCost) +
+      static_cast<float>(int(MemberOp::template Cost<2>::value) - int(MemberOp::template Cost<1>::value));
+
+  // Returns the block of the reductions [begin, begin + count) over their coefficients [start, start + length).
+  template <typename XprType>
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Block<XprType> reductions(XprType& xpr, Index begin, Index count,
+                                                                         Index start, Index length) {
+    return Direction == Vertical ? Block<XprType>(xpr, start, begin, length, count)
+                                 : Block<XprType>(xpr, begin, start, count, length);
+  }
+
+  struct ReductionsFunctor {
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void operator()(Index chunk) {
+      const Index begin = chunk * size / chunks, end = (chunk + 1) * size / chunks;
+      Block<DstXprType> dstBlock = reductions(dst, begin, end - begin, 0, 1);
+      call_assignment_no_alias(dstBlock, ChunkXprType(reductions(arg, begin, end - begin, 0, length), op), func);
+    }
+    DstXprType& dst;
+    const ArgNestedCleaned& arg;
+    const MemberOp& op;
+    const Functor& func;
+    Index chunks, size, length;
+  };
+
+  struct CoefficientsFunctor {
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void operator()(Index chunk) {
+      const Index start = chunk * length / chunks, end = (chunk + 1) * length / chunks;
+      Block<PartialsType> partialsBlock = reductions(partials, 0, size, chunk, 1);
+      call_assignment_no_alias(partialsBlock, ChunkXprType(reductions(arg, 0, size, start, end - start), op),
+                               assign_op<Scalar, Scalar>());
+    }
+    PartialsType& partials;
+    const ArgNestedCleaned& arg;
+    const MemberOp& op;
+    Index chunks, size, length;
+  };
+
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void run_split_coefficients(DstXprType& dst, const ArgNestedCleaned& arg,
+                                                                           const MemberOp& op, const Functor& func,
+                                                                           CoreThreadPoolDevice& device, Index chunks,
+                                                                           Index size, Index length, std::true_type) {
+    PartialsType partials(Direction == Vertical ? chunks : size, Direction == Vertical ? size : chunks);
+    CoefficientsFunctor functor{partials, arg, op, chunks, size, length};
+    const float chunkCost = static_cast<float>(size * length) * Cost / static_cast<float>(chunks);
+    device.template parallelFor<CoefficientsFunctor, 1>(0, chunks, functor, chunkCost);
+    for (Index stride = 1; stride < chunks; stride *= 2)
+      for (Index i = 0; i + stride < chunks; i += 2 * stride) {
+        Block<PartialsType> lhs = reductions(partials, 0, size, i, 1);
+        lhs = lhs.binaryExpr(reductions(partials, 0, size, i + stride, 1), op.binaryFunc());
+      }
+    Block<PartialsType> result = reductions(partials, 0, size, 0, 1);
+    call_assignment_no_alias(dst, result, func);
+  }
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void run_split_coefficients(DstXprType&, const ArgNestedCleaned&,
+                                                                           const MemberOp&, const Functor&,
+                                                                           CoreThreadPoolDevice&, Index, Index, Index,
+                                                                           std::false_type) {}
+
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void run(DstXprType& dst, const SrcXprType& src, const Functor& func,
+                                                        CoreThreadPoolDevice& device) {
+#ifndef EIGEN_NO_DEBUG
+    internal::check_for_aliasing(dst, src);
+#endif
+    resize_if_allowed(dst, src, func);
+    const Index size = Direction == Vertical ? src.cols() : src.rows();
+    const Index length = Direction == Vertical ? src.nestedExpression().rows() : src.nestedExpression().cols();
+    Index chunks = size == 0 || length == 0 ? 1 : Index(1) << device.template calculateLevels<1>(size * length, Cost);
+    if (chunks == 1) {
+      call_dense_assignment_loop(dst, src, func);
+      return;
+    }
+
+    ArgNested nested(src.nestedExpression());
+    const ArgNestedCleaned& arg = nested;
+    const MemberOp& op = src.functor();
+    if (size >= chunks || !SplitCoefficients) {
+      chunks = numext::mini(chunks, size);
+      ReductionsFunctor functor{dst, arg, op, func, chunks, size, length};
+      const float chunkCost = static_cast<float>(size * length) * Cost / static_cast<float>(chunks);
+      device.template parallelFor<ReductionsFunctor, 1>(0, chunks, functor, chunkCost);
+    } else {
+      chunks = numext::mini(chunks, length);
+      run_split_coefficients(dst, arg, op, func, device, chunks, size, length,
+                             std::integral_constant<bool, SplitCoefficients>());
+    }
+  }
+};
+
 }  // namespace internal
 
 }  // namespace Eigen
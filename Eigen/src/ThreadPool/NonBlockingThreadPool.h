@@ -31,10 +31,14 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
         all_coprimes_(num_threads),
         waiters_(num_threads),
         global_steal_partition_(EncodePartition(0, num_threads_)),
+        pending_high_priority_(0),
         blocked_(0),
         spinning_(0),
         done_(false),
         cancelled_(false),
+        idle_threads_(0),
+        idle_nanoseconds_(kMaxSpinNanoseconds / 4),
+        statistics_baseline_(num_threads),
         ec_(waiters_) {
     waiters_.resize(num_threads_);
     // Calculate coprimes of all numbers [1, num_threads].
@@ -54,7 +58,9 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
 #endif
     thread_data_.resize(num_threads_);
     for (int i = 0; i < num_threads_; i++) {
-      SetStealPartition(i, EncodePartition(0, num_threads_));
+      const std::pair<unsigned, unsigned> partition = InitialStealPartition(env_, i, 0);
+      AssertBounds(partition.first, partition.second);
+      SetStealPartition(i, EncodePartition(partition.first, partition.second));
       thread_data_[i].thread.reset(env_.CreateThread([this, i]() { WorkerLoop(i); }));
     }
 #ifndef EIGEN_THREAD_LOCAL
@@ -76,7 +82,7 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
       // Since we were cancelled, there might be entries in the queues.
       // Empty them to prevent their destructor from asserting.
       for (size_t i = 0; i < thread_data_.size(); i++) {
-        thread_data_[i].queue.Flush();
+        for (Queue& q : thread_data_[i].queues) q.Flush();
       }
     }
     // Join threads explicitly (by destroying) to avoid destruction order within
@@ -97,14 +103,33 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     }
   }
 
-  void Schedule(std::function<void()> fn) EIGEN_OVERRIDE { ScheduleWithHint(std::move(fn), 0, num_threads_); }
+  void Schedule(std::function<void()> fn) EIGEN_OVERRIDE {
+    ScheduleWithHintAndPriority(std::move(fn), 0, num_threads_, kNormalPriority);
+  }
 
   void ScheduleWithHint(std::function<void()> fn, int start, int limit) override {
+    ScheduleWithHintAndPriority(std::move(fn), start, limit, kNormalPriority);
+  }
+
+  void ScheduleWithPriority(std::function<void()> fn, Priority priority) override {
+    ScheduleWithHintAndPriority(std::move(fn), 0, num_threads_, priority);
+  }
+
+  // Each thread has a queue per priority. The threads take the high priority
+  // tasks first, from their own queue or from the other threads, and then the
+  // normal priority ones. So that normal priority tasks are not starved by a
+  // steady stream of high priority ones, a thread which ran
+  // kHighPriorityStreak high priority tasks in a row looks for a normal
+  // priority task first.
+  void ScheduleWithHintAndPriority(std::function<void()> fn, int start, int limit, Priority priority) override {
+    eigen_plain_assert(priority >= 0 && priority < kNumPriorities);
     Task t = env_.CreateTask(std::move(fn));
     PerThread* pt = GetPerThread();
+    // Count the high priority task before it can be popped.
+    if (priority == kHighPriority) pending_high_priority_.fetch_add(1, std::memory_order_relaxed);
     if (pt->pool == this) {
       // Worker thread of this pool, push onto the thread's queue.
-      Queue& q = thread_data_[pt->thread_id].queue;
+      Queue& q = thread_data_[pt->thread_id].queues[priority];
       t = q.PushFront(std::move(t));
     } else {
       // A free-standing thread (or worker of another pool), push onto a random
@@ -114,7 +139,7 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
       int num_queues = limit - start;
       int rnd = Rand(&pt->rand) % num_queues;
       eigen_plain_assert(start + rnd < limit);
-      Queue& q = thread_data_[start + rnd].queue;
+      Queue& q = thread_data_[start + rnd].queues[priority];
       t = q.PushBack(std::move(t));
     }
     // Note: below we touch this after making w available to worker threads.
@@ -127,6 +152,7 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     if (!t.f) {
       ec_.Notify(false);
     } else {
+      if (priority == kHighPriority) pending_high_priority_.fetch_sub(1, std::memory_order_relaxed);
       env_.ExecuteTask(t);  // Push failed, execute directly.
     }
   }
@@ -146,6 +172,19 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     ec_.Notify(true);
   }
 
+  // Runs a task of the calling worker thread, or steals one from the pool,
+  // the high priority tasks first.
+  bool TryRunTask() override {
+    if (num_threads_ == 0 || cancelled_) return false;
+    PerThread* pt = GetPerThread();
+    unsigned high_priority_streak = 0;
+    Task t = pt->pool == this ? NextTask(thread_data_[pt->thread_id].queues, &high_priority_streak) : GlobalSteal();
+    if (!t.f) return false;
+    if (pt->pool == this) CountTask(thread_data_[pt->thread_id]);
+    env_.ExecuteTask(t);
+    return true;
+  }
+
   int NumThreads() const EIGEN_FINAL { return num_threads_; }
 
   int CurrentThreadId() const EIGEN_FINAL {
@@ -157,6 +196,60 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     }
   }
 
+  // Number of buckets of the queue depth histograms: bucket 0 counts the
+  // empty queues, and bucket b > 0 the depths in [2^(b-1), 2^b).
+  static const int kQueueDepthBuckets = 13;
+  // The threads sample the depth of their queues once every
+  // kQueueDepthSamplingPeriod tasks, starting with the first one.
+  static const int kQueueDepthSamplingPeriod = 8;
+
+  // Statistics of a worker thread.
+  struct WorkerStatistics {
+    uint64_t tasks = 0;          // Tasks executed.
+    uint64_t steals = 0;         // Tasks taken from the queues of other threads.
+    uint64_t failed_steals = 0;  // Attempts to steal which found no task.
+    uint64_t parks = 0;          // Times the thread blocked waiting for work.
+    uint64_t unparks = 0;        // Times it was woken up.
+    // Sampled depths of the queues of the thread when it runs a task.
+    uint64_t queue_depth[kQueueDepthBuckets] = {};
+  };
+
+  struct Statistics {
+    std::vector<WorkerStatistics> workers;
+    // Moving average of the time between the tasks found by the idle threads.
+    int64_t idle_nanoseconds = 0;
+    // Time an idle thread currently spins before blocking.
+    int64_t spin_nanoseconds = 0;
+  };
+
+  // Returns the statistics of the workers since the creation of the pool, or
+  // the last call to ResetStatistics(). They are updated without
+  // synchronization, so a snapshot of a busy pool is only approximate.
+  Statistics GetStatistics() const {
+    Statistics stats;
+    stats.workers.resize(num_threads_);
+    EIGEN_MUTEX_LOCK lock(statistics_mutex_);
+    for (int i = 0; i < num_threads_; ++i) {
+      const WorkerStatistics counters = thread_data_[i].counters.Load();
+      const WorkerStatistics& base = statistics_baseline_[i];
+      WorkerStatistics& w = stats.workers[i];
+      w.tasks = counters.tasks - base.tasks;
+      w.steals = counters.steals - base.steals;
+      w.failed_steals = counters.failed_steals - base.failed_steals;
+      w.parks = counters.parks - base.parks;
+      w.unparks = counters.unparks - base.unparks;
+      for (int b = 0; b < kQueueDepthBuckets; ++b) w.queue_depth[b] = counters.queue_depth[b] - base.queue_depth[b];
+    }
+    stats.idle_nanoseconds = idle_nanoseconds_.load(std::memory_order_relaxed);
+    stats.spin_nanoseconds = allow_spinning_ ? SpinNanoseconds() : 0;
+    return stats;
+  }
+
+  void ResetStatistics() {
+    EIGEN_MUTEX_LOCK lock(statistics_mutex_);
+    for (int i = 0; i < num_threads_; ++i) statistics_baseline_[i] = thread_data_[i].counters.Load();
+  }
+
  private:
   // Create a single atomic<int> that encodes start and limit information for
   // each thread.
@@ -186,6 +279,18 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     thread_data_[i].steal_partition.store(val, std::memory_order_relaxed);
   }
 
+  // The environments which place the threads by locality, e.g.
+  // TopologyThreadEnvironment, provide the partitions in which the threads
+  // steal first. The threads of the other ones steal from the whole pool.
+  template <typename Env>
+  auto InitialStealPartition(const Env& env, int i, int) -> decltype(env.StealPartition(i, 0)) {
+    return env.StealPartition(i, num_threads_);
+  }
+  template <typename Env>
+  std::pair<unsigned, unsigned> InitialStealPartition(const Env&, int, long) {
+    return std::make_pair(0u, static_cast<unsigned>(num_threads_));
+  }
+
   inline unsigned GetStealPartition(int i) { return thread_data_[i].steal_partition.load(std::memory_order_relaxed); }
 
   void ComputeCoprimes(int N, MaxSizeVector<unsigned>* coprimes) {
@@ -217,13 +322,49 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
 #endif
   };
 
+  // Statistics counters of a worker thread. Only the thread itself updates
+  // them, so the increments need no read-modify-write operations.
+  struct Counters {
+    std::atomic<uint64_t> tasks{0}, steals{0}, failed_steals{0}, parks{0}, unparks{0};
+    std::atomic<uint64_t> queue_depth[kQueueDepthBuckets] = {};
+
+    static EIGEN_STRONG_INLINE void Increment(std::atomic<uint64_t>& c) {
+      c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    EIGEN_STRONG_INLINE void AddQueueDepth(unsigned depth) {
+      int bucket = 0;
+      for (; depth != 0 && bucket < kQueueDepthBuckets - 1; depth >>= 1) ++bucket;
+      Increment(queue_depth[bucket]);
+    }
+
+    WorkerStatistics Load() const {
+      WorkerStatistics w;
+      w.tasks = tasks.load(std::memory_order_relaxed);
+      w.steals = steals.load(std::memory_order_relaxed);
+      w.failed_steals = failed_steals.load(std::memory_order_relaxed);
+      w.parks = parks.load(std::memory_order_relaxed);
+      w.unparks = unparks.load(std::memory_order_relaxed);
+      for (int b = 0; b < kQueueDepthBuckets; ++b) w.queue_depth[b] = queue_depth[b].load(std::memory_order_relaxed);
+      return w;
+    }
+  };
+
   struct ThreadData {
-    constexpr ThreadData() : thread(), steal_partition(0), queue() {}
+    constexpr ThreadData() : thread(), steal_partition(0), queues(), counters() {}
     std::unique_ptr<Thread> thread;
     std::atomic<unsigned> steal_partition;
-    Queue queue;
+    Queue queues[kNumPriorities];
+    Counters counters;
   };
 
+  // Number of high priority tasks a thread runs in a row before it looks for
+  // normal priority tasks first.
+  static const unsigned kHighPriorityStreak = 16;
+
+  // Longest time an idle thread spins before blocking.
+  static constexpr int64_t kMaxSpinNanoseconds = 50000;
+
   Environment env_;
   const int num_threads_;
   const bool allow_spinning_;
@@ -231,10 +372,19 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
   MaxSizeVector<MaxSizeVector<unsigned>> all_coprimes_;
   MaxSizeVector<EventCount::Waiter> waiters_;
   unsigned global_steal_partition_;
+  // Upper bound of the number of queued high priority tasks, which allows to
+  // skip the scan of the high priority queues when there is none.
+  std::atomic<int> pending_high_priority_;
   std::atomic<unsigned> blocked_;
   std::atomic<bool> spinning_;
   std::atomic<bool> done_;
   std::atomic<bool> cancelled_;
+  // Number of worker threads looking for a task, spinning or blocked.
+  std::atomic<int> idle_threads_;
+  // Moving average of the time between the tasks found by the idle threads.
+  std::atomic<int64_t> idle_nanoseconds_;
+  mutable EIGEN_MUTEX statistics_mutex_;  // Protects statistics_baseline_.
+  std::vector<WorkerStatistics> statistics_baseline_;
   EventCount ec_;
 #ifndef EIGEN_THREAD_LOCAL
   std::unique_ptr<Barrier> init_barrier_;
@@ -258,13 +408,13 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     pt->pool = this;
     pt->rand = GlobalThreadIdHash();
     pt->thread_id = thread_id;
-    Queue& q = thread_data_[thread_id].queue;
+    Queue* queues = thread_data_[thread_id].queues;
     EventCount::Waiter* waiter = &waiters_[thread_id];
-    // TODO(dvyukov,rmlarsen): The time spent in NonEmptyQueueIndex() is
-    // proportional to num_threads_ and we assume that new work is scheduled at
-    // a constant rate, so we set spin_count to 5000 / num_threads_. The
-    // constant was picked based on a fair dice roll, tune it.
-    const int spin_count = allow_spinning_ && num_threads_ > 0 ? 5000 / num_threads_ : 0;
+    // Number of high priority tasks run in a row by this thread.
+    unsigned high_priority_streak = 0;
+    ThreadData& data = thread_data_[thread_id];
+    // Start of the idle period of the thread, if it has no task.
+    int64_t idle_since = -1;
     if (num_threads_ == 1) {
       // For num_threads_ == 1 there is no point in going through the expensive
       // steal loop. Moreover, since NonEmptyQueueIndex() calls PopBack() on the
@@ -273,10 +423,15 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
       // counter-productive for the types of I/O workloads the single thread
       // pools tend to be used for.
       while (!cancelled_) {
-        Task t = q.PopFront();
-        for (int i = 0; i < spin_count && !t.f; i++) {
-          if (!cancelled_.load(std::memory_order_relaxed)) {
-            t = q.PopFront();
+        Task t = PopLocal(queues, &high_priority_streak);
+        if (!t.f) {
+          if (idle_since < 0) idle_since = StartIdling();
+          if (allow_spinning_) {
+            const int64_t spin_until = idle_since + SpinNanoseconds();
+            for (unsigned i = 1; !t.f && !cancelled_.load(std::memory_order_relaxed); i++) {
+              t = PopLocal(queues, &high_priority_streak);
+              if (i % kSpinsPerClockRead == 0 && NowNanoseconds() >= spin_until) break;
+            }
           }
         }
         if (!t.f) {
@@ -285,46 +440,141 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
           }
         }
         if (t.f) {
-          env_.ExecuteTask(t);
+          RunTask(t, data, &idle_since);
         }
       }
     } else {
       while (!cancelled_) {
-        Task t = q.PopFront();
+        Task t = NextTask(queues, &high_priority_streak);
         if (!t.f) {
-          t = LocalSteal();
-          if (!t.f) {
-            t = GlobalSteal();
-            if (!t.f) {
-              // Leave one thread spinning. This reduces latency.
-              if (allow_spinning_ && !spinning_ && !spinning_.exchange(true)) {
-                for (int i = 0; i < spin_count && !t.f; i++) {
-                  if (!cancelled_.load(std::memory_order_relaxed)) {
-                    t = GlobalSteal();
-                  } else {
-                    return;
-                  }
-                }
-                spinning_ = false;
-              }
-              if (!t.f) {
-                if (!WaitForWork(waiter, &t)) {
-                  return;
-                }
+          if (idle_since < 0) idle_since = StartIdling();
+          // Leave one thread spinning. This reduces latency.
+          if (allow_spinning_ && !spinning_ && !spinning_.exchange(true)) {
+            const int64_t spin_until = idle_since + SpinNanoseconds();
+            for (unsigned i = 1; !t.f; i++) {
+              if (!cancelled_.load(std::memory_order_relaxed)) {
+                t = GlobalSteal();
+              } else {
+                return;
               }
+              if (i % kSpinsPerClockRead == 0 && NowNanoseconds() >= spin_until) break;
+            }
+            spinning_ = false;
+          }
+          if (!t.f) {
+            if (!WaitForWork(waiter, &t)) {
+              return;
             }
           }
         }
         if (t.f) {
-          env_.ExecuteTask(t);
+          RunTask(t, data, &idle_since);
         }
       }
     }
   }
 
+  // Number of attempts to find a task between the clock reads of a spinning
+  // thread.
+  static const unsigned kSpinsPerClockRead = 16;
+
+  static EIGEN_STRONG_INLINE int64_t NowNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // Idle threads spin for about twice the recent time between the tasks,
+  // at most kMaxSpinNanoseconds, so that they catch the tasks arriving in
+  // bursts without blocking. They do not spin when the tasks arrive further
+  // apart than kMaxSpinNanoseconds, and leave the cores to other processes
+  // instead.
+  int64_t SpinNanoseconds() const {
+    const int64_t average = idle_nanoseconds_.load(std::memory_order_relaxed);
+    return average <= kMaxSpinNanoseconds ? numext::mini(2 * average, kMaxSpinNanoseconds) : 0;
+  }
+
+  // Starts an idle period of the worker, and returns its start time.
+  EIGEN_STRONG_INLINE int64_t StartIdling() {
+    idle_threads_.fetch_add(1, std::memory_order_relaxed);
+    return NowNanoseconds();
+  }
+
+  // Runs a task found by the worker, and accounts for the time it was idle.
+  EIGEN_STRONG_INLINE void RunTask(const Task& t, ThreadData& data, int64_t* idle_since) {
+    if (*idle_since >= 0) {
+      // The idle threads take turns on the incoming tasks, so each one waits
+      // for about as many tasks as there are idle threads, this one included.
+      const int idle_threads = idle_threads_.fetch_sub(1, std::memory_order_relaxed);
+      // Longer waits all mean that spinning does not pay off, do not let them
+      // dominate the average.
+      const int64_t idle =
+          numext::mini((NowNanoseconds() - *idle_since) / numext::maxi(idle_threads, 1), 4 * kMaxSpinNanoseconds);
+      const int64_t average = idle_nanoseconds_.load(std::memory_order_relaxed);
+      idle_nanoseconds_.store(average + (idle - average) / 8, std::memory_order_relaxed);
+      *idle_since = -1;
+    }
+    CountTask(data);
+    env_.ExecuteTask(t);
+  }
+
+  // Accounts for a task run by the worker.
+  EIGEN_STRONG_INLINE void CountTask(ThreadData& data) {
+    const uint64_t tasks = data.counters.tasks.load(std::memory_order_relaxed);
+    data.counters.tasks.store(tasks + 1, std::memory_order_relaxed);
+    if (tasks % kQueueDepthSamplingPeriod == 0) {
+      unsigned depth = 0;
+      for (const Queue& q : data.queues) depth += q.Size();
+      data.counters.AddQueueDepth(depth);
+    }
+  }
+
+  // Returns the order in which a thread looks at the priorities: the high
+  // priority first, unless it ran kHighPriorityStreak high priority tasks in
+  // a row.
+  static EIGEN_STRONG_INLINE int PriorityOrder(int i, unsigned high_priority_streak) {
+    return high_priority_streak < kHighPriorityStreak ? i : kNumPriorities - 1 - i;
+  }
+
+  // Accounts for a task of the given priority taken by the thread.
+  EIGEN_STRONG_INLINE Task Taken(Task t, int priority, unsigned* high_priority_streak) {
+    if (t.f) {
+      if (priority == kHighPriority) {
+        pending_high_priority_.fetch_sub(1, std::memory_order_relaxed);
+        ++*high_priority_streak;
+      } else {
+        *high_priority_streak = 0;
+      }
+    }
+    return t;
+  }
+
+  // Pops a task from the queues of the calling worker thread.
+  Task PopLocal(Queue* queues, unsigned* high_priority_streak) {
+    for (int i = 0; i < kNumPriorities; ++i) {
+      const int priority = PriorityOrder(i, *high_priority_streak);
+      Task t = Taken(queues[priority].PopFront(), priority, high_priority_streak);
+      if (t.f) return t;
+    }
+    return Task();
+  }
+
+  // Pops a task from the queues of the calling worker thread, or steals one
+  // from its partition or from the whole pool, the high priority tasks first.
+  Task NextTask(Queue* queues, unsigned* high_priority_streak) {
+    for (int i = 0; i < kNumPriorities; ++i) {
+      const int priority = PriorityOrder(i, *high_priority_streak);
+      if (priority == kHighPriority && pending_high_priority_.load(std::memory_order_relaxed) <= 0) continue;
+      Task t = queues[priority].PopFront();
+      if (!t.f) t = LocalSteal(priority);
+      if (!t.f) t = GlobalSteal(priority);
+      if (t.f) return Taken(std::move(t), priority, high_priority_streak);
+    }
+    return Task();
+  }
+
   // Steal tries to steal work from other worker threads in the range [start,
   // limit) in best-effort manner.
-  Task Steal(unsigned start, unsigned limit) {
+  Task Steal(unsigned start, unsigned limit, int priority) {
     PerThread* pt = GetPerThread();
     const size_t size = limit - start;
     unsigned r = Rand(&pt->rand);
@@ -337,8 +587,9 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
 
     for (unsigned i = 0; i < size; i++) {
       eigen_plain_assert(start + victim < limit);
-      Task t = thread_data_[start + victim].queue.PopBack();
+      Task t = thread_data_[start + victim].queues[priority].PopBack();
       if (t.f) {
+        if (pt->pool == this) Counters::Increment(thread_data_[pt->thread_id].counters.steals);
         return t;
       }
       victim += inc;
@@ -346,11 +597,12 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
         victim -= static_cast<unsigned int>(size);
       }
     }
+    if (pt->pool == this) Counters::Increment(thread_data_[pt->thread_id].counters.failed_steals);
     return Task();
   }
 
   // Steals work within threads belonging to the partition.
-  Task LocalSteal() {
+  Task LocalSteal(int priority) {
     PerThread* pt = GetPerThread();
     unsigned partition = GetStealPartition(pt->thread_id);
     // If thread steal partition is the same as global partition, there is no
@@ -360,11 +612,23 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     DecodePartition(partition, &start, &limit);
     AssertBounds(start, limit);
 
-    return Steal(start, limit);
+    return Steal(start, limit, priority);
   }
 
   // Steals work from any other thread in the pool.
-  Task GlobalSteal() { return Steal(0, num_threads_); }
+  Task GlobalSteal(int priority) { return Steal(0, num_threads_, priority); }
+
+  // Steals work from any other thread in the pool, the high priority tasks
+  // first.
+  Task GlobalSteal() {
+    unsigned high_priority_streak = 0;
+    for (int priority = 0; priority < kNumPriorities; ++priority) {
+      if (priority == kHighPriority && pending_high_priority_.load(std::memory_order_relaxed) <= 0) continue;
+      Task t = GlobalSteal(priority);
+      if (t.f) return Taken(std::move(t), priority, &high_priority_streak);
+    }
+    return Task();
+  }
 
   // WaitForWork blocks until new work is available (returns true), or if it is
   // time to exit (returns false). Can optionally return a task to execute in t
@@ -375,13 +639,17 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     // blocking.
     ec_.Prewait();
     // Now do a reliable emptiness check.
-    int victim = NonEmptyQueueIndex();
+    int priority = kHighPriority;
+    int victim = NonEmptyQueueIndex(&priority);
     if (victim != -1) {
       ec_.CancelWait();
       if (cancelled_) {
         return false;
       } else {
-        *t = thread_data_[victim].queue.PopBack();
+        unsigned high_priority_streak = 0;
+        *t = Taken(thread_data_[victim].queues[priority].PopBack(), priority, &high_priority_streak);
+        Counters& counters = thread_data_[GetPerThread()->thread_id].counters;
+        Counters::Increment(t->f ? counters.steals : counters.failed_steals);
         return true;
       }
     }
@@ -397,7 +665,7 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
       // right after incrementing blocked_ above. Now a free-standing thread
       // submits work and calls destructor (which sets done_). If we don't
       // re-check queues, we will exit leaving the work unexecuted.
-      if (NonEmptyQueueIndex() != -1) {
+      if (NonEmptyQueueIndex(&priority) != -1) {
         // Note: we must not pop from queues before we decrement blocked_,
         // otherwise the following scenario is possible. Consider that instead
         // of checking for emptiness we popped the only element from queues.
@@ -411,12 +679,18 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
       ec_.Notify(true);
       return false;
     }
+    Counters& counters = thread_data_[GetPerThread()->thread_id].counters;
+    Counters::Increment(counters.parks);
     ec_.CommitWait(waiter);
+    Counters::Increment(counters.unparks);
     blocked_--;
     return true;
   }
 
-  int NonEmptyQueueIndex() {
+  // Returns the index of a thread with a non-empty queue, the high priority
+  // queues first, and stores the priority of the queue in *priority. Returns
+  // -1 if all the queues are empty.
+  int NonEmptyQueueIndex(int* priority) {
     PerThread* pt = GetPerThread();
     // We intentionally design NonEmptyQueueIndex to steal work from
     // anywhere in the queue so threads don't block in WaitForWork() forever
@@ -424,14 +698,17 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     const size_t size = thread_data_.size();
     unsigned r = Rand(&pt->rand);
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
-    unsigned victim = r % size;
-    for (unsigned i = 0; i < size; i++) {
-      if (!thread_data_[victim].queue.Empty()) {
-        return victim;
-      }
-      victim += inc;
-      if (victim >= size) {
-        victim -= static_cast<unsigned int>(size);
+    for (int p = 0; p < kNumPriorities; ++p) {
+      unsigned victim = r % size;
+      for (unsigned i = 0; i < size; i++) {
+        if (!thread_data_[victim].queues[p].Empty()) {
+          *priority = p;
+          return victim;
+        }
+        victim += inc;
+        if (victim >= size) {
+          victim -= static_cast<unsigned int>(size);
+        }
       }
     }
     return -1;
@@ -466,6 +743,12 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
   }
 };
 
+#if EIGEN_COMP_CXXVER < 17
+// Before C++17, the constants bound to references need a definition.
+template <typename Environment>
+constexpr int64_t ThreadPoolTempl<Environment>::kMaxSpinNanoseconds;
+#endif
+
 typedef ThreadPoolTempl<StlThreadEnvironment> ThreadPool;
 
 }  // namespace Eigen
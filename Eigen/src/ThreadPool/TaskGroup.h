@@ -0,0 +1,179 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_THREADPOOL_TASK_GROUP_H
+#define EIGEN_CXX11_THREADPOOL_TASK_GROUP_H
+
+// IWYU pragma: private
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+// TaskGroup runs closures on a thread pool and joins them.
+//
+//   TaskGroup group(pool);
+//   for (int i = 0; i < n; ++i) group.Run([i]() { Work(i); });
+//   group.Wait();
+//
+// While the closures of the group are pending, Wait() runs the closures
+// enqueued in the pool on the calling thread instead of blocking it. So the
+// closures can themselves fork and join groups on the same pool without
+// exhausting its threads. Wait() must not be called from a closure of the same
+// group. Loops of many small iterations are cheaper to run with RunBatch:
+//
+//   group.RunBatch(n, [](Index first, Index last) {
+//     for (Index i = first; i < last; ++i) Work(i);
+//   });
+//
+// Cancel() skips the closures of the group that have not started yet, and the
+// closures which run for a long time can poll IsCancelled(). The first
+// exception thrown by a closure cancels the group, and is rethrown by Wait().
+// The group can be reused once Wait() returns.
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPoolInterface& pool) : pool_(pool), state_(std::make_shared<State>()) {}
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  // Waits for the closures of the group, dropping their exception if any.
+  ~TaskGroup() { Join(); }
+
+  // Schedules the copy-constructible closure f in the group.
+  template <typename Function>
+  void Run(Function&& f, ThreadPoolInterface::Priority priority = ThreadPoolInterface::kNormalPriority) {
+    if (state_->cancelled.load(std::memory_order_relaxed)) return;
+    state_->pending.fetch_add(1, std::memory_order_relaxed);
+    pool_.ScheduleWithPriority(
+        [state = state_, f = std::forward<Function>(f)]() mutable {
+          if (!state->cancelled.load(std::memory_order_relaxed)) state->Execute(f);
+          state->Done();
+        },
+        priority);
+    Scheduled();
+  }
+
+  // Schedules in the group the calls f(first, last) on disjoint ranges which
+  // cover [0, n), with ThreadPoolInterface::ScheduleBatch. Cancel() skips the
+  // ranges which did not start.
+  template <typename Function>
+  void RunBatch(Index n, Function&& f) {
+    if (n <= 0 || state_->cancelled.load(std::memory_order_relaxed)) return;
+    state_->pending.fetch_add(1, std::memory_order_relaxed);
+    typedef Batch<typename std::decay<Function>::type> BatchType;
+    std::shared_ptr<BatchType> batch = std::make_shared<BatchType>(state_, n, std::forward<Function>(f));
+    pool_.ScheduleBatch(n, [batch](Index first, Index last) {
+      State& state = *batch->state;
+      if (!state.cancelled.load(std::memory_order_relaxed)) {
+        auto range = [&]() { batch->f(first, last); };
+        state.Execute(range);
+      }
+      // The batch is complete once all its indices are.
+      if (batch->remaining.fetch_sub(last - first, std::memory_order_acq_rel) == last - first) state.Done();
+    });
+    Scheduled();
+  }
+
+  // Returns once all the closures of the group are complete, and rethrows the
+  // first exception they threw.
+  void Wait() {
+    Join();
+#ifdef EIGEN_EXCEPTIONS
+    std::exception_ptr exception = std::move(state_->exception);
+    state_->exception = nullptr;
+    if (exception) std::rethrow_exception(exception);
+#endif
+  }
+
+  // Skips the closures of the group which did not start, until Wait() returns.
+  void Cancel() { state_->cancelled.store(true, std::memory_order_relaxed); }
+
+  bool IsCancelled() const { return state_->cancelled.load(std::memory_order_relaxed); }
+
+ private:
+  // The closures share the state with the group, so that it outlives the
+  // notification of the waiting threads by the last one.
+  struct State {
+    std::atomic<int> pending{0};
+    // Number of calls to Run, which the waiting threads watch for new work.
+    std::atomic<unsigned> runs{0};
+    std::atomic<int> waiters{0};
+    std::atomic<bool> cancelled{false};
+    EIGEN_MUTEX mu;
+    EIGEN_CONDVAR cv;
+#ifdef EIGEN_EXCEPTIONS
+    std::exception_ptr exception;
+#endif
+
+    template <typename Function>
+    void Execute(Function& f) {
+#ifdef EIGEN_EXCEPTIONS
+      try {
+        f();
+      } catch (...) {
+        EIGEN_MUTEX_LOCK l(mu);
+        if (!exception) exception = std::current_exception();
+        cancelled.store(true, std::memory_order_relaxed);
+      }
+#else
+      f();
+#endif
+    }
+
+    void Done() {
+      if (pending.fetch_sub(1, std::memory_order_seq_cst) == 1 && waiters.load(std::memory_order_seq_cst) != 0)
+        NotifyAll();
+    }
+
+    void NotifyAll() {
+      EIGEN_MUTEX_LOCK l(mu);
+      cv.notify_all();
+    }
+  };
+
+  template <typename Function>
+  struct Batch {
+    template <typename F>
+    Batch(std::shared_ptr<State> s, Index n, F&& function)
+        : state(std::move(s)), remaining(n), f(std::forward<F>(function)) {}
+    std::shared_ptr<State> state;
+    std::atomic<Index> remaining;
+    Function f;
+  };
+
+  // Wakes up the waiting threads, so that they help with the new closures.
+  void Scheduled() {
+    state_->runs.fetch_add(1, std::memory_order_seq_cst);
+    if (state_->waiters.load(std::memory_order_seq_cst) != 0) state_->NotifyAll();
+  }
+
+  void Join() {
+    State& state = *state_;
+    state.waiters.fetch_add(1, std::memory_order_seq_cst);
+    for (;;) {
+      const unsigned runs = state.runs.load(std::memory_order_seq_cst);
+      if (state.pending.load(std::memory_order_seq_cst) == 0) break;
+      if (pool_.TryRunTask()) continue;
+      // The closures of the group are running on other threads. Block until
+      // they complete, or schedule new closures to help with.
+      EIGEN_MUTEX_LOCK l(state.mu);
+      while (state.pending.load(std::memory_order_seq_cst) != 0 && state.runs.load(std::memory_order_seq_cst) == runs)
+        state.cv.wait(l);
+    }
+    state.waiters.fetch_sub(1, std::memory_order_relaxed);
+    state.cancelled.store(false, std::memory_order_relaxed);
+  }
+
+  ThreadPoolInterface& pool_;
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace Eigen
+
+#endif  // EIGEN_CXX11_THREADPOOL_TASK_GROUP_H
@@ -30,6 +30,50 @@ class ThreadPoolInterface {
     Schedule(fn);
   }
 
+  // Priority classes of the closures. Idle threads run the high priority
+  // closures, e.g. latency-critical requests, before the normal priority ones,
+  // e.g. batch work. Schedule() and ScheduleWithHint() use kNormalPriority.
+  enum Priority { kHighPriority = 0, kNormalPriority = 1, kNumPriorities = 2 };
+
+  // Submits a closure with the given priority.
+  virtual void ScheduleWithPriority(std::function<void()> fn, Priority /*priority*/) {
+    // Defer to Schedule in case sub-classes do not support priorities.
+    Schedule(std::move(fn));
+  }
+
+  // Submits a closure with the given priority, to be run by threads in the
+  // range [start, end) in the pool.
+  virtual void ScheduleWithHintAndPriority(std::function<void()> fn, int start, int end, Priority /*priority*/) {
+    ScheduleWithHint(std::move(fn), start, end);
+  }
+
+  // Submits calls fn(first, last) on disjoint ranges which together cover
+  // [0, n). Rather than a closure per index, a closure per thread claims
+  // ranges from the shared one until it is exhausted, the large ranges first
+  // and the smaller ones as it runs out. So a loop of many small iterations
+  // costs a single allocation and at most NumThreads() enqueued closures.
+  virtual void ScheduleBatch(Index n, std::function<void(Index, Index)> fn) {
+    if (n <= 0) return;
+    const int threads = NumThreads();
+    const int closures = static_cast<int>(numext::mini<Index>(n, numext::maxi(threads, 1)));
+    // The closures share the ownership of the range, which is thus freed even
+    // if some of them are destroyed without running, e.g. by Cancel().
+    std::shared_ptr<BatchRange> range = std::make_shared<BatchRange>(n, closures, std::move(fn));
+    for (int i = 0; i < closures; ++i) {
+      std::function<void()> closure = [range]() { range->Run(); };
+      if (threads > 0) {
+        ScheduleWithHint(std::move(closure), i, i + 1);
+      } else {
+        Schedule(std::move(closure));
+      }
+    }
+  }
+
+  // If implemented, runs one of the enqueued closures on the calling thread and
+  // returns true. Returns false if there is none, or if not implemented. This
+  // lets threads waiting for closures help with them instead of blocking.
+  virtual bool TryRunTask() { return false; }
+
   // If implemented, stop processing the closures that have been enqueued.
   // Currently running closures may still be processed.
   // If not implemented, does nothing.
@@ -43,6 +87,31 @@ class ThreadPoolInterface {
   virtual int CurrentThreadId() const = 0;
 
   virtual ~ThreadPoolInterface() {}
+
+ private:
+  // The range shared by the closures of ScheduleBatch. Each claim takes half of
+  // the share of a closure in what remains, which balances the load without
+  // splitting the range into single indices up front.
+  struct BatchRange {
+    BatchRange(Index size, int closures, std::function<void(Index, Index)> function)
+        : n(size), num_closures(closures), next(0), fn(std::move(function)) {}
+
+    void Run() {
+      for (;;) {
+        const Index remaining = n - next.load(std::memory_order_relaxed);
+        if (remaining <= 0) break;
+        const Index chunk = numext::maxi<Index>(1, remaining / (2 * num_closures));
+        const Index first = next.fetch_add(chunk, std::memory_order_relaxed);
+        if (first >= n) break;
+        fn(first, numext::mini(first + chunk, n));
+      }
+    }
+
+    const Index n;
+    const int num_closures;
+    std::atomic<Index> next;
+    std::function<void(Index, Index)> fn;
+  };
 };
 
 }  // namespace Eigen
@@ -0,0 +1,231 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_THREADPOOL_TOPOLOGY_THREAD_ENVIRONMENT_H
+#define EIGEN_CXX11_THREADPOOL_TOPOLOGY_THREAD_ENVIRONMENT_H
+
+// IWYU pragma: private
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+// Parses a list of cpus in the format of the kernel, e.g. "0-3,8,10-11".
+inline std::vector<int> parse_cpu_list(const std::string& list) {
+  std::vector<int> cpus;
+  const char* s = list.c_str();
+  while (*s != '\0' && *s != '\n') {
+    char* end;
+    const long first = std::strtol(s, &end, 10);
+    if (end == s) break;
+    long last = first;
+    s = end;
+    if (*s == '-') {
+      last = std::strtol(s + 1, &end, 10);
+      s = end;
+    }
+    for (long cpu = first; cpu <= last; ++cpu) cpus.push_back(static_cast<int>(cpu));
+    if (*s == ',') ++s;
+  }
+  return cpus;
+}
+
+// Reads the first line of a file of sysfs, returns false if there is none.
+inline bool read_sysfs(const std::string& path, std::string* line) {
+  std::ifstream file(path.c_str());
+  return static_cast<bool>(std::getline(file, *line));
+}
+
+}  // namespace internal
+
+// CpuTopology groups the cpus which the process may run on into locality
+// domains: the cpus of a domain belong to the same NUMA node and share their
+// last level cache.
+struct CpuTopology {
+  struct Domain {
+    int node;   // NUMA node.
+    int cache;  // Lowest cpu sharing the last level cache.
+    std::vector<int> cpus;
+  };
+  // Sorted by node and cache.
+  std::vector<Domain> domains;
+
+  int NumCpus() const {
+    int n = 0;
+    for (const Domain& domain : domains) n += static_cast<int>(domain.cpus.size());
+    return n;
+  }
+
+  // Reads the topology from /sys/devices/system/{cpu,node} on Linux. Elsewhere,
+  // or if sysfs is not available, all the cpus form a single domain.
+  static CpuTopology Detect() {
+    CpuTopology topology;
+#if EIGEN_OS_LINUX
+    std::string online, line;
+    cpu_set_t allowed;
+    const bool restricted = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    const std::string cpu_dir = "/sys/devices/system/cpu/", node_dir = "/sys/devices/system/node/";
+    if (internal::read_sysfs(cpu_dir + "online", &online)) {
+      std::vector<std::pair<int, std::vector<int>>> nodes;
+      if (internal::read_sysfs(node_dir + "online", &line)) {
+        for (int node : internal::parse_cpu_list(line))
+          if (internal::read_sysfs(node_dir + "node" + std::to_string(node) + "/cpulist", &line))
+            nodes.push_back(std::make_pair(node, internal::parse_cpu_list(line)));
+      }
+      for (int cpu : internal::parse_cpu_list(online)) {
+        if (restricted && (cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed))) continue;
+        int node = 0;
+        for (const auto& n : nodes)
+          if (std::find(n.second.begin(), n.second.end(), cpu) != n.second.end()) node = n.first;
+        // The last level cache is the unified or data cache of highest level.
+        int cache = cpu, cache_level = 0;
+        const std::string cache_dir = cpu_dir + "cpu" + std::to_string(cpu) + "/cache/index";
+        for (int index = 0; internal::read_sysfs(cache_dir + std::to_string(index) + "/level", &line); ++index) {
+          const int level = std::atoi(line.c_str());
+          std::string type, shared;
+          if (level <= cache_level || !internal::read_sysfs(cache_dir + std::to_string(index) + "/type", &type) ||
+              type == "Instruction" ||
+              !internal::read_sysfs(cache_dir + std::to_string(index) + "/shared_cpu_list", &shared))
+            continue;
+          const std::vector<int> shared_cpus = internal::parse_cpu_list(shared);
+          if (shared_cpus.empty()) continue;
+          cache_level = level;
+          cache = shared_cpus.front();
+        }
+        topology.Add(node, cache, cpu);
+      }
+    }
+#endif
+    if (topology.domains.empty()) {
+      const int n = numext::maxi(1, static_cast<int>(std::thread::hardware_concurrency()));
+      for (int cpu = 0; cpu < n; ++cpu) topology.Add(0, 0, cpu);
+    }
+    return topology;
+  }
+
+  // Adds the cpu to its domain.
+  void Add(int node, int cache, int cpu) {
+    std::size_t i = 0;
+    while (i < domains.size() && (domains[i].node < node || (domains[i].node == node && domains[i].cache < cache))) ++i;
+    if (i == domains.size() || domains[i].node != node || domains[i].cache != cache)
+      domains.insert(domains.begin() + i, Domain{node, cache, std::vector<int>()});
+    domains[i].cpus.push_back(cpu);
+  }
+};
+
+// TopologyThreadEnvironment places the threads of a pool according to the
+// topology of the machine. The workers fill the domains one after the other,
+// so the workers of a domain have consecutive ids, and each worker is pinned
+// to its own cpu. Each worker steals inside its domain before stealing from
+// the whole pool, and the tasks can query the domain of the worker running
+// them, e.g. to allocate and first touch their memory on the local node.
+//
+//   ThreadPoolTempl<TopologyThreadEnvironment> pool(num_threads);
+//
+// In pools with more threads than cpus, the extra threads are neither pinned
+// nor in a domain, and the workers steal from the whole pool.
+class TopologyThreadEnvironment {
+ public:
+  struct Task {
+    std::function<void()> f;
+  };
+
+  class EnvThread {
+   public:
+    EnvThread(std::function<void()> f, int cpu, int domain)
+        : thr_([f, cpu, domain]() {
+#if EIGEN_OS_LINUX
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+              cpu_set_t set;
+              CPU_ZERO(&set);
+              CPU_SET(cpu, &set);
+              // Pinning is best effort, e.g. the cpu may have gone offline.
+              sched_setaffinity(0, sizeof(set), &set);
+            }
+#else
+            EIGEN_UNUSED_VARIABLE(cpu);
+#endif
+#ifdef EIGEN_THREAD_LOCAL
+            ThisThreadDomain() = domain;
+#else
+            EIGEN_UNUSED_VARIABLE(domain);
+#endif
+            f();
+          }) {
+    }
+    ~EnvThread() { thr_.join(); }
+    void OnCancel() {}
+
+   private:
+    std::thread thr_;
+  };
+
+  explicit TopologyThreadEnvironment(CpuTopology topology = CpuTopology::Detect(), bool pin = true)
+      : topology_(std::move(topology)), pin_(pin), num_created_(0) {
+    for (std::size_t d = 0; d < topology_.domains.size(); ++d)
+      for (int cpu : topology_.domains[d].cpus) placement_.push_back(std::make_pair(cpu, static_cast<int>(d)));
+  }
+
+  // The k-th created thread is the worker k of the pool.
+  EnvThread* CreateThread(std::function<void()> f) {
+    const int k = num_created_++;
+    const int n = static_cast<int>(placement_.size());
+    if (k >= n) return new EnvThread(std::move(f), -1, -1);
+    return new EnvThread(std::move(f), pin_ ? placement_[k].first : -1, placement_[k].second);
+  }
+  Task CreateTask(std::function<void()> f) { return Task{std::move(f)}; }
+  void ExecuteTask(const Task& t) { t.f(); }
+
+  const CpuTopology& Topology() const { return topology_; }
+  int NumDomains() const { return static_cast<int>(topology_.domains.size()); }
+
+  // Range [start, limit) of the workers of the domain in a pool of num_threads
+  // threads, e.g. for ScheduleWithHint. Empty if the pool does not span it.
+  std::pair<unsigned, unsigned> DomainThreads(int domain, int num_threads) const {
+    eigen_plain_assert(domain >= 0 && domain < NumDomains());
+    unsigned start = 0;
+    for (int d = 0; d < domain; ++d) start += static_cast<unsigned>(topology_.domains[d].cpus.size());
+    const unsigned limit = start + static_cast<unsigned>(topology_.domains[domain].cpus.size());
+    const unsigned n = static_cast<unsigned>(num_threads);
+    return std::make_pair(numext::mini(start, n), numext::mini(limit, n));
+  }
+
+  // The partition in which the worker steals first.
+  std::pair<unsigned, unsigned> StealPartition(int thread_id, int num_threads) const {
+    if (num_threads > static_cast<int>(placement_.size())) return std::make_pair(0u, static_cast<unsigned>(num_threads));
+    return DomainThreads(placement_[thread_id].second, num_threads);
+  }
+
+  // Returns the domain of the calling worker thread, or -1 if it is not a
+  // worker of a pool using this environment (or without thread locals).
+#ifdef EIGEN_THREAD_LOCAL
+  static int CurrentDomain() { return ThisThreadDomain(); }
+
+ private:
+  static int& ThisThreadDomain() {
+    EIGEN_THREAD_LOCAL int domain = -1;
+    return domain;
+  }
+#else
+  static int CurrentDomain() { return -1; }
+
+ private:
+#endif
+
+  CpuTopology topology_;
+  bool pin_;
+  int num_created_;
+  // Cpu and domain of the workers, in the order of their ids.
+  std::vector<std::pair<int, int>> placement_;
+};
+
+}  // namespace Eigen
+
+#endif  // EIGEN_CXX11_THREADPOOL_TOPOLOGY_THREAD_ENVIRONMENT_H
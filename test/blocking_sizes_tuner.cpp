@@ -0,0 +1,129 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <Eigen/BlockingSizesTuner>
+#include <cstdio>
+
+template <typename Scalar>
+void tuned_blocking_sizes() {
+  typedef Matrix<Scalar, Dynamic, Dynamic> MatrixType;
+  clearTunedBlockingSizes();
+
+  // The tuned sizes apply to the whole shape class, reduced to the dimensions of the product.
+  setTunedBlockingSizes<Scalar>(100, 200, 300, 24, 160, 56);
+  Index k = 127, m = 129, n = 257;
+  internal::computeProductBlockingSizes<Scalar, Scalar>(k, m, n);
+  VERIFY_IS_EQUAL(k, 24);
+  VERIFY_IS_EQUAL(m, 129);
+  VERIFY_IS_EQUAL(n, 56);
+  k = 64, m = 255, n = 511;
+  internal::computeProductBlockingSizes<Scalar, Scalar>(k, m, n);
+  VERIFY_IS_EQUAL(k, 24);
+  VERIFY_IS_EQUAL(m, 160);
+  VERIFY_IS_EQUAL(n, 56);
+
+  // Other shape classes, multi-threaded products and triangular solves keep the heuristic.
+  Index hk = 300, hm = 200, hn = 300;
+  internal::evaluateProductBlockingSizesHeuristic<Scalar, Scalar, 1>(hk, hm, hn, Index(1));
+  k = 300, m = 200, n = 300;
+  internal::computeProductBlockingSizes<Scalar, Scalar>(k, m, n);
+  VERIFY(k == hk && m == hm && n == hn);
+  hk = 100, hm = 200, hn = 300;
+  internal::evaluateProductBlockingSizesHeuristic<Scalar, Scalar, 1>(hk, hm, hn, Index(2));
+  k = 100, m = 200, n = 300;
+  internal::computeProductBlockingSizes<Scalar, Scalar>(k, m, n, Index(2));
+  VERIFY(k == hk && m == hm && n == hn);
+  hk = 100, hm = 200, hn = 300;
+  internal::evaluateProductBlockingSizesHeuristic<Scalar, Scalar, 4>(hk, hm, hn, Index(1));
+  k = 100, m = 200, n = 300;
+  internal::computeProductBlockingSizes<Scalar, Scalar, 4>(k, m, n);
+  VERIFY(k == hk && m == hm && n == hn);
+
+  Index kc = 0, mc = 0, nc = 0;
+  VERIFY(tunedBlockingSizes<Scalar>(64, 128, 256, kc, mc, nc));
+  VERIFY(kc == 24 && mc == 160 && nc == 56);
+  VERIFY(!tunedBlockingSizes<Scalar>(64, 128, 512, kc, mc, nc));
+
+  // Products with unusual tuned sizes.
+  MatrixType lhs = MatrixType::Random(200, 100);
+  MatrixType rhs = MatrixType::Random(100, 300);
+  MatrixType res = lhs * rhs;
+  VERIFY_IS_APPROX(res, lhs.lazyProduct(rhs));
+  setTunedBlockingSizes<Scalar>(100, 200, 300, 17, 3, 5);
+  res = lhs * rhs;
+  VERIFY_IS_APPROX(res, lhs.lazyProduct(rhs));
+
+  clearTunedBlockingSizes();
+  VERIFY(!tunedBlockingSizes<Scalar>(100, 200, 300, kc, mc, nc));
+}
+
+template <typename Scalar>
+void tuner() {
+  typedef Matrix<Scalar, Dynamic, Dynamic> MatrixType;
+  clearTunedBlockingSizes();
+  BlockingSizesTuner tuner;
+  tuner.setMinTime(1e-4).setRepetitions(1);
+  const double speedup = tuner.tune<Scalar>(48, 96, 40);
+  VERIFY(speedup >= 1);
+  Index kc = 0, mc = 0, nc = 0;
+  VERIFY(tunedBlockingSizes<Scalar>(48, 96, 40, kc, mc, nc));
+  VERIFY(kc > 0 && kc <= 48 && mc > 0 && mc <= 96 && nc > 0 && nc <= 40);
+
+  MatrixType lhs = MatrixType::Random(96, 48);
+  MatrixType rhs = MatrixType::Random(48, 40);
+  MatrixType res = lhs * rhs;
+  VERIFY_IS_APPROX(res, lhs.lazyProduct(rhs));
+  clearTunedBlockingSizes();
+}
+
+void tuning_file() {
+  const std::string filename = "blocking_sizes_tuner.txt";
+  clearTunedBlockingSizes();
+  setTunedBlockingSizes<float>(64, 64, 64, 32, 48, 64);
+  setTunedBlockingSizes<std::complex<double> >(2048, 16, 512, 256, 16, 128);
+  VERIFY(saveTunedBlockingSizes(filename.c_str()));
+
+  clearTunedBlockingSizes();
+  VERIFY(loadTunedBlockingSizes(filename.c_str()));
+  Index kc = 0, mc = 0, nc = 0;
+  VERIFY(tunedBlockingSizes<float>(127, 100, 64, kc, mc, nc));
+  VERIFY(kc == 32 && mc == 48 && nc == 64);
+  VERIFY(tunedBlockingSizes<std::complex<double> >(5000, 31, 1000, kc, mc, nc));
+  VERIFY(kc == 256 && mc == 16 && nc == 128);
+  VERIFY(!tunedBlockingSizes<double>(64, 64, 64, kc, mc, nc));
+
+  // Files measured with other cache sizes, or corrupted, are ignored.
+  {
+    std::ofstream file(filename.c_str());
+    file << "eigen_blocking_sizes 1\ncache " << l1CacheSize() + 1 << " " << l2CacheSize() << " " << l3CacheSize()
+         << "\nfloat 16 16 16 8 8 8\n";
+  }
+  clearTunedBlockingSizes();
+  VERIFY(!loadTunedBlockingSizes(filename.c_str()));
+  {
+    std::ofstream file(filename.c_str());
+    file << "eigen_blocking_sizes 1\ncache " << l1CacheSize() << " " << l2CacheSize() << " " << l3CacheSize()
+         << "\nfloat 16 16 16 8 8 8\nhalf 16 16 16 8 8 8\n";
+  }
+  VERIFY(!loadTunedBlockingSizes(filename.c_str()));
+  VERIFY(!tunedBlockingSizes<float>(16, 16, 16, kc, mc, nc));
+  std::remove(filename.c_str());
+  VERIFY(!loadTunedBlockingSizes(filename.c_str()));
+}
+
+EIGEN_DECLARE_TEST(blocking_sizes_tuner) {
+  CALL_SUBTEST_1(tuned_blocking_sizes<float>());
+  CALL_SUBTEST_1(tuned_blocking_sizes<double>());
+  CALL_SUBTEST_2(tuned_blocking_sizes<std::complex<float> >());
+  CALL_SUBTEST_2(tuned_blocking_sizes<std::complex<double> >());
+  CALL_SUBTEST_3(tuner<float>());
+  CALL_SUBTEST_3(tuner<double>());
+  CALL_SUBTEST_4(tuning_file());
+}
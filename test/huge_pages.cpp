@@ -0,0 +1,79 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_HUGE_PAGES
+
+#include "main.h"
+
+#ifdef EIGEN_HUGE_PAGES_ENABLED
+
+static const std::size_t kAlignment = std::size_t(2) << 20;
+
+static bool is_large(const void* ptr) {
+  return internal::find_large_allocation(const_cast<void*>(ptr)) != nullptr &&
+         reinterpret_cast<std::size_t>(ptr) % kAlignment == 0;
+}
+
+static int large_count() { return internal::large_allocations().count.load(); }
+
+void huge_pages_allocation(bool firstTouch) {
+  LargeAllocationPolicy policy;
+  policy.threshold = std::size_t(1) << 20;
+  policy.firstTouch = firstTouch;
+  setLargeAllocationPolicy(policy);
+  VERIFY_IS_EQUAL(largeAllocationPolicy().threshold, policy.threshold);
+
+  // At least threshold / sizeof(double) coefficients.
+  const Index rows = internal::random<Index>(512, 600), cols = internal::random<Index>(256, 500);
+  {
+    MatrixXd a = MatrixXd::Random(rows, cols);
+    const MatrixXd b = a;
+    VERIFY(is_large(a.data()) && is_large(b.data()));
+    VERIFY_IS_EQUAL(large_count(), 2);
+    VERIFY(a == b);
+
+    // Small buffers are still allocated with malloc.
+    VectorXd small(100);
+    VERIFY(!is_large(small.data()));
+
+    // Reallocations move the buffers to and from the mappings.
+    a.conservativeResize(rows + 100, cols);
+    VERIFY(is_large(a.data()));
+    VERIFY(a.topRows(rows) == b);
+    a.conservativeResize(10, 10);
+    VERIFY(!is_large(a.data()));
+    VERIFY(a == b.topLeftCorner(10, 10));
+    small.conservativeResize(rows * cols);
+    VERIFY(is_large(small.data()));
+    VERIFY_IS_EQUAL(large_count(), 2);
+
+    // The temporaries of the products use them as well.
+    const MatrixXd c = b * b.transpose();
+    VERIFY_IS_APPROX(c, b.lazyProduct(b.transpose()));
+  }
+  VERIFY_IS_EQUAL(large_count(), 0);
+
+  // A threshold of zero disables the policy.
+  policy.threshold = 0;
+  setLargeAllocationPolicy(policy);
+  MatrixXd d(rows, cols);
+  VERIFY(!is_large(d.data()));
+  setLargeAllocationPolicy(LargeAllocationPolicy());
+}
+
+#endif
+
+EIGEN_DECLARE_TEST(huge_pages) {
+#ifdef EIGEN_HUGE_PAGES_ENABLED
+  for (int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(huge_pages_allocation(false));
+    CALL_SUBTEST_2(huge_pages_allocation(true));
+  }
+#endif
+}
@@ -0,0 +1,165 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// route the stack temporaries to the heap
+#define EIGEN_STACK_ALLOCATION_LIMIT 0
+#define EIGEN_INSTRUMENTATION
+
+#include "main.h"
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+#include <Eigen/QR>
+#include <Eigen/SVD>
+#include <cstring>
+#include <thread>
+
+static std::vector<AllocationEvent> g_allocation_events;
+static std::vector<RegionEvent> g_region_events;
+
+static void record_allocation(const AllocationEvent& event) {
+  // The callback is not invoked recursively for the allocations it makes.
+  VectorXd unreported(100);
+  EIGEN_UNUSED_VARIABLE(unreported);
+  g_allocation_events.push_back(event);
+}
+
+static void record_region(const RegionEvent& event) { g_region_events.push_back(event); }
+
+static bool in_region(const AllocationEvent& event, const char* name) {
+  return event.region != nullptr && std::strcmp(event.region, name) == 0;
+}
+
+static const RegionEvent* find_region(const char* name) {
+  for (const RegionEvent& event : g_region_events)
+    if (std::strcmp(event.name, name) == 0) return &event;
+  return nullptr;
+}
+
+void instrumentation_statistics() {
+  resetAllocationStatistics();
+  {
+    VectorXd v(100);
+    MatrixXf m(10, 20);
+    v.conservativeResize(200);
+    AllocationStatistics statistics = allocationStatistics();
+    VERIFY_IS_EQUAL(statistics.allocations, Index(2));
+    VERIFY_IS_EQUAL(statistics.reallocations, Index(1));
+    VERIFY_IS_EQUAL(statistics.deallocations, Index(0));
+    VERIFY_IS_EQUAL(statistics.allocatedBytes, (100 + 200) * sizeof(double) + 200 * sizeof(float));
+    VERIFY_IS_EQUAL(statistics.largestAllocation, 200 * sizeof(double));
+  }
+  VERIFY_IS_EQUAL(allocationStatistics().deallocations, Index(2));
+
+  // The unaligned allocations are reported as well.
+  resetAllocationStatistics();
+  void* ptr = internal::conditional_aligned_malloc<false>(10);
+  ptr = internal::conditional_aligned_realloc<false>(ptr, 20, 10);
+  internal::conditional_aligned_free<false>(ptr);
+  VERIFY_IS_EQUAL(allocationStatistics().allocations, Index(1));
+  VERIFY_IS_EQUAL(allocationStatistics().reallocations, Index(1));
+  VERIFY_IS_EQUAL(allocationStatistics().deallocations, Index(1));
+
+  // Only the allocations of a workspace falling back to the heap are counted.
+  Workspace workspace(1024);
+  resetAllocationStatistics();
+  {
+    ScopedWorkspace scope(workspace);
+    VectorXd a(10);
+    VectorXd b(1000);
+  }
+  VERIFY_IS_EQUAL(allocationStatistics().allocations, Index(1));
+  VERIFY_IS_EQUAL(allocationStatistics().allocatedBytes, 1000 * sizeof(double));
+  VERIFY_IS_EQUAL(allocationStatistics().deallocations, Index(1));
+
+  // The counters are shared by the threads.
+  resetAllocationStatistics();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([]() {
+      for (int k = 0; k < 100; ++k) VectorXf v(k + 1);
+    });
+  for (std::thread& thread : threads) thread.join();
+  VERIFY_IS_EQUAL(allocationStatistics().allocations, Index(400));
+  VERIFY_IS_EQUAL(allocationStatistics().deallocations, Index(400));
+}
+
+void instrumentation_callbacks() {
+  g_allocation_events.clear();
+  VERIFY(setAllocationCallback(record_allocation) == nullptr);
+  {
+    InstrumentedRegion outer("outer");
+    VectorXd a(10);
+    {
+      InstrumentedRegion inner("inner");
+      a.resize(20);
+    }
+    VectorXd b(30);
+  }
+  VERIFY(setAllocationCallback(nullptr) == record_allocation);
+  VERIFY_IS_EQUAL(g_allocation_events.size(), std::size_t(6));
+  VERIFY(g_allocation_events[0].kind == AllocationEvent::Allocation && in_region(g_allocation_events[0], "outer"));
+  VERIFY_IS_EQUAL(g_allocation_events[0].size, 10 * sizeof(double));
+  VERIFY(g_allocation_events[1].kind == AllocationEvent::Deallocation && in_region(g_allocation_events[1], "inner"));
+  VERIFY(g_allocation_events[1].ptr == g_allocation_events[0].ptr);
+  VERIFY(g_allocation_events[2].kind == AllocationEvent::Allocation && in_region(g_allocation_events[2], "inner"));
+  VERIFY(g_allocation_events[3].kind == AllocationEvent::Allocation && in_region(g_allocation_events[3], "outer"));
+  VERIFY(g_allocation_events[4].kind == AllocationEvent::Deallocation && in_region(g_allocation_events[4], "outer"));
+  VERIFY(g_allocation_events[5].kind == AllocationEvent::Deallocation && in_region(g_allocation_events[5], "outer"));
+
+  // Allocations outside of any region have no call site.
+  setAllocationCallback(record_allocation);
+  { VectorXd c(10); }
+  setAllocationCallback(nullptr);
+  VERIFY(g_allocation_events.back().region == nullptr);
+}
+
+// The products, decompositions and solvers are timed, with the allocations they make.
+void instrumentation_regions() {
+  const Index size = internal::random<Index>(50, 200);
+  const MatrixXd a = MatrixXd::Random(size, size), b = MatrixXd::Random(size, 3);
+  MatrixXd c(size, size), x(size, 3);
+
+  g_region_events.clear();
+  VERIFY(setRegionCallback(record_region) == nullptr);
+  {
+    InstrumentedRegion region("user");
+    c.noalias() = a * a.transpose();
+  }
+  PartialPivLU<MatrixXd> lu(a);
+  x = lu.solve(b);
+  HouseholderQR<MatrixXd> qr(a);
+  LLT<MatrixXd> llt(c);
+  BDCSVD<MatrixXd> svd(a);
+  VERIFY(setRegionCallback(nullptr) == record_region);
+
+  for (const char* name : {"gemm", "user", "PartialPivLU::compute", "solve", "HouseholderQR::compute", "LLT::compute",
+                           "BDCSVD::compute"}) {
+    const RegionEvent* event = find_region(name);
+    VERIFY(event != nullptr);
+    if (event) VERIFY(event->seconds >= 0);
+  }
+  // The product allocates its blocking buffers, counted in the enclosing regions.
+  VERIFY(find_region("gemm")->allocations > 0);
+  VERIFY(find_region("user")->allocations >= find_region("gemm")->allocations);
+  VERIFY(find_region("user")->allocatedBytes >= find_region("gemm")->allocatedBytes);
+
+  // Regions are not timed without a callback.
+  g_region_events.clear();
+  lu.compute(a);
+  VERIFY(g_region_events.empty());
+  VERIFY_IS_APPROX(a * x, b);
+}
+
+EIGEN_DECLARE_TEST(instrumentation) {
+  CALL_SUBTEST_1(instrumentation_statistics());
+  CALL_SUBTEST_2(instrumentation_callbacks());
+  for (int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_3(instrumentation_regions());
+  }
+}
@@ -0,0 +1,69 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS 1
+
+#include "main.h"
+#include <Eigen/ThreadPool>
+
+template <typename LhsType, typename RhsType, typename DstType>
+void batched_product() {
+  typedef typename DstType::Scalar Scalar;
+  const Index batch = internal::random<Index>(1, 200);
+  const Index lhsSize = LhsType::SizeAtCompileTime, rhsSize = RhsType::SizeAtCompileTime,
+              dstSize = DstType::SizeAtCompileTime;
+
+  // Strided batch, with some padding between consecutive matrices.
+  const Index lhsStride = lhsSize + 3, rhsStride = rhsSize, dstStride = dstSize + 1;
+  Matrix<Scalar, Dynamic, 1> lhs = Matrix<Scalar, Dynamic, 1>::Random(batch * lhsStride);
+  Matrix<Scalar, Dynamic, 1> rhs = Matrix<Scalar, Dynamic, 1>::Random(batch * rhsStride);
+  Matrix<Scalar, Dynamic, 1> dst = Matrix<Scalar, Dynamic, 1>::Random(batch * dstStride);
+  Matrix<Scalar, Dynamic, 1> dst_threaded = dst;
+
+  batchedProduct<LhsType, RhsType, DstType>(batch, lhs.data(), lhsStride, rhs.data(), rhsStride, dst.data(),
+                                            dstStride);
+  for (Index k = 0; k < batch; ++k) {
+    DstType ref = Map<const LhsType>(lhs.data() + k * lhsStride) * Map<const RhsType>(rhs.data() + k * rhsStride);
+    VERIFY_IS_APPROX(Map<const DstType>(dst.data() + k * dstStride), ref);
+  }
+
+  ThreadPool pool(4);
+  CoreThreadPoolDevice device(pool);
+  batchedProduct<LhsType, RhsType, DstType>(batch, lhs.data(), lhsStride, rhs.data(), rhsStride,
+                                            dst_threaded.data(), dstStride, device);
+  VERIFY_IS_CWISE_EQUAL(dst, dst_threaded);
+
+  // Pointer-array batch, in reverse order.
+  std::vector<const Scalar*> lhsPtrs(batch), rhsPtrs(batch);
+  std::vector<Scalar*> dstPtrs(batch), dstThreadedPtrs(batch);
+  std::vector<DstType, aligned_allocator<DstType> > res(batch), res_threaded(batch);
+  for (Index k = 0; k < batch; ++k) {
+    lhsPtrs[k] = lhs.data() + (batch - 1 - k) * lhsStride;
+    rhsPtrs[k] = rhs.data() + (batch - 1 - k) * rhsStride;
+    dstPtrs[k] = res[k].data();
+    dstThreadedPtrs[k] = res_threaded[k].data();
+  }
+  batchedProduct<LhsType, RhsType, DstType>(batch, lhsPtrs.data(), rhsPtrs.data(), dstPtrs.data());
+  batchedProduct<LhsType, RhsType, DstType>(batch, lhsPtrs.data(), rhsPtrs.data(), dstThreadedPtrs.data(), device);
+  for (Index k = 0; k < batch; ++k) {
+    VERIFY_IS_APPROX(res[k], Map<const DstType>(dst.data() + (batch - 1 - k) * dstStride));
+    VERIFY_IS_CWISE_EQUAL(res[k], res_threaded[k]);
+  }
+}
+
+EIGEN_DECLARE_TEST(product_batched) {
+  for (int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1((batched_product<Matrix4f, Matrix4f, Matrix4f>()));
+    CALL_SUBTEST_1((batched_product<Matrix<float, 3, 5>, Matrix<float, 5, 2>, Matrix<float, 3, 2> >()));
+    CALL_SUBTEST_2((batched_product<Matrix<double, 8, 8, RowMajor>, Matrix<double, 8, 8>, Matrix<double, 8, 8> >()));
+    CALL_SUBTEST_2((batched_product<Matrix<double, 16, 16>, Matrix<double, 16, 16>, Matrix<double, 16, 16> >()));
+    CALL_SUBTEST_3((batched_product<Matrix<float, 32, 32>, Matrix<float, 32, 32>, Matrix<float, 32, 32, RowMajor> >()));
+    CALL_SUBTEST_4((batched_product<Matrix2cd, Matrix2cd, Matrix2cd>()));
+  }
+}
@@ -0,0 +1,139 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+
+typedef Matrix<double, Dynamic, Dynamic, RowMajor> RowMatrixXd;
+
+// Adds a per-row bias and clamps negative values to zero.
+template <typename Vector>
+struct bias_relu_epilogue {
+  explicit bias_relu_epilogue(const Vector& bias) : m_bias(bias) {}
+  template <typename Block>
+  void operator()(Block& block, Index row, Index) const {
+    typedef typename Block::RealScalar RealScalar;
+    block = (block.colwise() + m_bias.segment(row, block.rows())).cwiseMax(RealScalar(0));
+  }
+  const Vector& m_bias;
+};
+
+// Records how many times each coefficient has been passed to the epilogue. Blocks are disjoint, so concurrent calls
+// never touch the same counters.
+struct counting_epilogue {
+  explicit counting_epilogue(MatrixXi& counts) : m_counts(counts) {}
+  template <typename Block>
+  void operator()(Block& block, Index row, Index col) const {
+    m_counts.block(row, col, block.rows(), block.cols()).array() += 1;
+  }
+  MatrixXi& m_counts;
+};
+
+template <typename Scalar>
+struct scaling_epilogue {
+  explicit scaling_epilogue(const Scalar& s) : m_s(s) {}
+  template <typename Block>
+  void operator()(Block& block, Index, Index) const {
+    block *= m_s;
+  }
+  Scalar m_s;
+};
+
+template <typename DestType>
+void fused_product_counts(Index rows, Index cols, Index depth) {
+  typedef typename DestType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic> ColMatrix;
+  ColMatrix lhs = ColMatrix::Random(rows, depth);
+  ColMatrix rhs = ColMatrix::Random(depth, cols);
+  DestType res;
+  MatrixXi counts = MatrixXi::Zero(rows, cols);
+  fusedProduct(lhs, rhs, res, counting_epilogue(counts));
+  VERIFY_IS_APPROX(res, lhs * rhs);
+  VERIFY((counts.array() == 1).all());
+}
+
+template <typename DestType>
+void fused_product_bias_relu(Index rows, Index cols, Index depth) {
+  typedef typename DestType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic> ColMatrix;
+  typedef Matrix<Scalar, Dynamic, 1> Vector;
+  ColMatrix lhs = ColMatrix::Random(rows, depth);
+  Matrix<Scalar, Dynamic, Dynamic, RowMajor> rhs = ColMatrix::Random(depth, cols);
+  Vector bias = Vector::Random(rows);
+
+  DestType ref = lhs * rhs;
+  ref = (ref.colwise() + bias).cwiseMax(Scalar(0));
+  DestType res;
+  fusedProduct(lhs, rhs, res, bias_relu_epilogue<Vector>(bias));
+  VERIFY_IS_APPROX(res, ref);
+
+  // Expressions as operands, and a destination block.
+  ColMatrix big = ColMatrix::Zero(rows + 3, cols + 2);
+  Block<ColMatrix> blk = big.block(3, 2, rows, cols);
+  fusedProduct(lhs.transpose().transpose(), Scalar(2) * rhs, blk, bias_relu_epilogue<Vector>(bias));
+  ref = Scalar(2) * lhs * rhs;
+  ref = (ref.colwise() + bias).cwiseMax(Scalar(0));
+  VERIFY_IS_APPROX(big.block(3, 2, rows, cols), ref);
+  VERIFY_IS_EQUAL(big.topRows(3).norm(), Scalar(0));
+  VERIFY_IS_EQUAL(big.leftCols(2).norm(), Scalar(0));
+}
+
+template <typename Scalar>
+void fused_product_scaling(Index rows, Index cols, Index depth) {
+  typedef Matrix<Scalar, Dynamic, Dynamic> ColMatrix;
+  ColMatrix lhs = ColMatrix::Random(rows, depth);
+  ColMatrix rhs = ColMatrix::Random(depth, cols);
+  Scalar s = internal::random<Scalar>();
+  ColMatrix res;
+  fusedProduct(lhs, rhs, res, scaling_epilogue<Scalar>(s));
+  VERIFY_IS_APPROX(res, s * (lhs * rhs));
+  fusedProduct(lhs.adjoint(), lhs, res, scaling_epilogue<Scalar>(s));
+  VERIFY_IS_APPROX(res, s * (lhs.adjoint() * lhs));
+}
+
+// Runs the fused products on the tile-based multithreaded product, where the epilogue is called concurrently.
+template <typename DestType>
+void fused_product_threaded(Index rows, Index cols, Index depth) {
+  setNbThreads(getGemmThreadPool()->NumThreads());
+  fused_product_counts<DestType>(rows, cols, depth);
+  fused_product_bias_relu<DestType>(rows, cols, depth);
+  setNbThreads(1);
+}
+
+EIGEN_DECLARE_TEST(product_fused) {
+  ThreadPool pool(4);
+  setGemmThreadPool(&pool);
+  setNbThreads(1);
+  for (int i = 0; i < g_repeat; i++) {
+    const Index rows = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    const Index cols = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    const Index depth = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    TEST_SET_BUT_UNUSED_VARIABLE(rows);
+    TEST_SET_BUT_UNUSED_VARIABLE(cols);
+    TEST_SET_BUT_UNUSED_VARIABLE(depth);
+    CALL_SUBTEST_1(fused_product_counts<MatrixXf>(rows, cols, depth));
+    CALL_SUBTEST_1(fused_product_counts<MatrixXf>(rows, 1, depth));
+    CALL_SUBTEST_1(fused_product_counts<MatrixXf>(1, cols, depth));
+    CALL_SUBTEST_1(fused_product_counts<MatrixXf>(rows, cols, 0));
+    CALL_SUBTEST_1(fused_product_counts<MatrixXf>(3, 4, 5));
+    CALL_SUBTEST_2(fused_product_counts<RowMatrixXd>(rows, cols, depth));
+    CALL_SUBTEST_2(fused_product_counts<RowMatrixXd>(rows, 1, depth));
+    CALL_SUBTEST_2(fused_product_counts<RowMatrixXd>(rows, cols, 0));
+    CALL_SUBTEST_2(fused_product_counts<RowMatrixXd>(3, 4, 5));
+    CALL_SUBTEST_3(fused_product_bias_relu<MatrixXf>(rows, cols, depth));
+    CALL_SUBTEST_3(fused_product_bias_relu<MatrixXf>(4, 3, 2));
+    CALL_SUBTEST_4(fused_product_bias_relu<RowMatrixXd>(rows, cols, depth));
+    CALL_SUBTEST_5(fused_product_scaling<std::complex<float> >(rows, cols, depth));
+  }
+  // Large enough to span several cache blocks in every dimension.
+  CALL_SUBTEST_1(fused_product_counts<MatrixXf>(1000, 700, 600));
+  CALL_SUBTEST_2(fused_product_counts<RowMatrixXd>(700, 1000, 600));
+  CALL_SUBTEST_6(fused_product_threaded<MatrixXd>(517, 389, 301));
+  CALL_SUBTEST_6(fused_product_threaded<RowMatrixXd>(389, 301, 517));
+}
@@ -0,0 +1,108 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template <typename MatrixType>
+void packed_product(const MatrixType& m) {
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic, ColMajor> ColMatrix;
+  typedef Matrix<Scalar, Dynamic, Dynamic, RowMajor> RowMatrix;
+
+  const Index rows = m.rows();
+  const Index depth = m.cols();
+  const Index cols = internal::random<Index>(1, 300);
+
+  MatrixType lhs = MatrixType::Random(rows, depth);
+  PackedMatrix<Scalar> packed = prepack(lhs);
+  VERIFY_IS_EQUAL(packed.rows(), rows);
+  VERIFY_IS_EQUAL(packed.cols(), depth);
+
+  // The same packed lhs is reused for several right-hand sides.
+  for (int i = 0; i < 3; ++i) {
+    ColMatrix rhs = ColMatrix::Random(depth, cols);
+    ColMatrix ref = lhs * rhs;
+    ColMatrix res = packed * rhs;
+    VERIFY_IS_APPROX(res, ref);
+  }
+
+  ColMatrix rhs = ColMatrix::Random(depth, cols);
+  RowMatrix rowRhs = rhs;
+  ColMatrix ref = lhs * rhs;
+  ColMatrix res;
+  Scalar s = internal::random<Scalar>();
+
+  // Row-major, scaled and conjugated right-hand sides.
+  res = packed * rowRhs;
+  VERIFY_IS_APPROX(res, ref);
+  res = packed * (s * rhs);
+  VERIFY_IS_APPROX(res, s * ref);
+  res = packed * rhs.conjugate();
+  VERIFY_IS_APPROX(res, lhs * rhs.conjugate());
+  res = packed * rowRhs.transpose().transpose();
+  VERIFY_IS_APPROX(res, ref);
+
+  // Accumulation, non plain destinations, and vectors.
+  res.setRandom();
+  ColMatrix res2 = res;
+  res += packed * rhs;
+  res2 += ref;
+  VERIFY_IS_APPROX(res, res2);
+  RowMatrix rowRes = packed * rhs;
+  VERIFY_IS_APPROX(rowRes, ref);
+  ColMatrix big = ColMatrix::Zero(rows + 2, cols + 3);
+  big.block(1, 2, rows, cols) = packed * rhs;
+  VERIFY_IS_APPROX(big.block(1, 2, rows, cols), ref);
+  Matrix<Scalar, Dynamic, 1> v = Matrix<Scalar, Dynamic, 1>::Random(depth);
+  Matrix<Scalar, Dynamic, 1> rv = packed * v;
+  VERIFY_IS_APPROX(rv, lhs * v);
+
+  // The result may alias the right-hand side.
+  MatrixType square = MatrixType::Random(depth, depth);
+  PackedMatrix<Scalar> packedSquare = prepack(square);
+  ColMatrix x = ColMatrix::Random(depth, cols);
+  ColMatrix x0 = x;
+  x = packedSquare * x;
+  VERIFY_IS_APPROX(x, square * x0);
+  x0 = x;
+  x += packedSquare * x;
+  VERIFY_IS_APPROX(x, x0 + square * x0);
+  x0 = x;
+  x -= packedSquare * (s * x);
+  VERIFY_IS_APPROX(x, x0 - s * (square * x0));
+  x0 = x;
+  x.leftCols(cols - 1) = packedSquare * x.rightCols(cols - 1);
+  VERIFY_IS_APPROX(x.leftCols(cols - 1), square * x0.rightCols(cols - 1));
+  RowMatrix rowX = x;
+  rowX = packedSquare * rowX;
+  VERIFY_IS_APPROX(rowX, square * x);
+
+  // Packing an expression, with custom blocking hints.
+  PackedMatrix<Scalar> packedT(lhs.transpose().transpose(), 7);
+  res = packedT * rhs;
+  VERIFY_IS_APPROX(res, ref);
+  RowMatrix rowLhs = lhs;
+  packedT.compute(rowLhs, cols);
+  res = packedT * rhs;
+  VERIFY_IS_APPROX(res, ref);
+}
+
+EIGEN_DECLARE_TEST(product_packed) {
+  for (int i = 0; i < g_repeat; i++) {
+    int rows = internal::random<int>(1, EIGEN_TEST_MAX_SIZE);
+    int depth = internal::random<int>(1, EIGEN_TEST_MAX_SIZE);
+    CALL_SUBTEST_1(packed_product(MatrixXf(rows, depth)));
+    CALL_SUBTEST_2(packed_product(MatrixXd(internal::random<int>(200, 600), internal::random<int>(200, 600))));
+    CALL_SUBTEST_3(packed_product(MatrixXcf(rows, depth)));
+    CALL_SUBTEST_4(packed_product(Matrix<double, Dynamic, Dynamic, RowMajor>(rows, depth)));
+    CALL_SUBTEST_5(packed_product(MatrixXcd(internal::random<int>(1, 40), internal::random<int>(1, 40))));
+    EIGEN_UNUSED_VARIABLE(rows);
+    EIGEN_UNUSED_VARIABLE(depth);
+  }
+}
@@ -0,0 +1,98 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template <typename LhsScalar, typename RhsScalar, int LhsOptions, int RhsOptions>
+void quantized_product(Index rows, Index depth, Index cols) {
+  typedef Matrix<LhsScalar, Dynamic, Dynamic, LhsOptions> LhsType;
+  typedef Matrix<RhsScalar, Dynamic, Dynamic, RhsOptions> RhsType;
+  typedef Matrix<int32_t, Dynamic, Dynamic> AccType;
+
+  LhsType lhs = LhsType::NullaryExpr(rows, depth, [] { return internal::random<LhsScalar>(); });
+  RhsType rhs = RhsType::NullaryExpr(depth, cols, [] { return internal::random<RhsScalar>(); });
+
+  // Scalar reference.
+  AccType ref(rows, cols);
+  for (Index i = 0; i < rows; ++i)
+    for (Index j = 0; j < cols; ++j) {
+      int32_t s = 0;
+      for (Index k = 0; k < depth; ++k) s += int32_t(lhs(i, k)) * int32_t(rhs(k, j));
+      ref(i, j) = s;
+    }
+
+  AccType acc;
+  quantizedProduct(lhs, rhs, acc);
+  VERIFY_IS_EQUAL(acc, ref);
+
+  Matrix<int32_t, Dynamic, Dynamic, RowMajor> rowAcc;
+  quantizedProduct(lhs, rhs, rowAcc);
+  VERIFY_IS_EQUAL(rowAcc, ref);
+
+  // Blocks of larger matrices are accepted as destinations.
+  AccType outer = AccType::Constant(rows + 2, cols + 1, 7);
+  quantizedProduct(lhs, rhs, outer.block(1, 1, rows, cols));
+  VERIFY_IS_EQUAL(outer.block(1, 1, rows, cols), ref);
+  VERIFY((outer.row(0).array() == 7).all() && (outer.row(rows + 1).array() == 7).all());
+  VERIFY((outer.col(0).array() == 7).all());
+  Matrix<int32_t, Dynamic, Dynamic, RowMajor> rowOuter;
+  rowOuter.setZero(rows, cols + 3);
+  quantizedProduct(lhs, rhs, rowOuter.rightCols(cols));
+  VERIFY_IS_EQUAL(rowOuter.rightCols(cols), ref);
+  VERIFY(rowOuter.leftCols(3).isZero());
+
+  if (rows > 2 && cols > 2 && depth > 2) {
+    AccType blockRef = AccType::Zero(rows - 1, cols - 2);
+    for (Index i = 1; i < rows; ++i)
+      for (Index j = 2; j < cols; ++j)
+        for (Index k = 1; k < depth; ++k) blockRef(i - 1, j - 2) += int32_t(lhs(i, k)) * int32_t(rhs(k, j));
+    quantizedProduct(lhs.bottomRightCorner(rows - 1, depth - 1), rhs.bottomRightCorner(depth - 1, cols - 2), acc);
+    VERIFY_IS_EQUAL(acc, blockRef);
+  }
+
+  // Dequantized product with per-row and per-column zero points and scales.
+  VectorXi lhsZero = VectorXi::NullaryExpr(rows, [] { return int(internal::random<LhsScalar>()); });
+  VectorXi rhsZero = VectorXi::NullaryExpr(cols, [] { return int(internal::random<RhsScalar>()); });
+  VectorXf lhsScale = VectorXf::Random(rows);
+  VectorXf rhsScale = VectorXf::Random(cols);
+  MatrixXd dequantizedRef(rows, cols);
+  for (Index i = 0; i < rows; ++i)
+    for (Index j = 0; j < cols; ++j) {
+      double s = 0;
+      for (Index k = 0; k < depth; ++k) s += (double(lhs(i, k)) - lhsZero(i)) * (double(rhs(k, j)) - rhsZero(j));
+      dequantizedRef(i, j) = double(lhsScale(i)) * double(rhsScale(j)) * s;
+    }
+  MatrixXf res;
+  quantizedProduct(lhs, lhsZero, lhsScale, rhs, rhsZero, rhsScale, res);
+  VERIFY_IS_APPROX(res.template cast<double>(), dequantizedRef);
+  MatrixXf resOuter = MatrixXf::Zero(rows, cols + 1);
+  quantizedProduct(lhs, lhsZero, lhsScale, rhs, rhsZero, rhsScale, resOuter.leftCols(cols));
+  VERIFY_IS_APPROX(resOuter.leftCols(cols).template cast<double>(), dequantizedRef);
+  VERIFY(resOuter.col(cols).isZero());
+}
+
+template <typename LhsScalar, typename RhsScalar>
+void quantized_products() {
+  const Index rows = internal::random<Index>(1, 200), depth = internal::random<Index>(1, 300),
+              cols = internal::random<Index>(1, 200);
+  quantized_product<LhsScalar, RhsScalar, ColMajor, ColMajor>(rows, depth, cols);
+  quantized_product<LhsScalar, RhsScalar, RowMajor, ColMajor>(rows, depth, cols);
+  quantized_product<LhsScalar, RhsScalar, ColMajor, RowMajor>(rows, depth, cols);
+  quantized_product<LhsScalar, RhsScalar, RowMajor, RowMajor>(rows, depth, cols);
+}
+
+EIGEN_DECLARE_TEST(product_quantized) {
+  for (int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1((quantized_products<int8_t, int8_t>()));
+    CALL_SUBTEST_2((quantized_products<uint8_t, int8_t>()));
+    CALL_SUBTEST_3((quantized_products<uint8_t, uint8_t>()));
+    CALL_SUBTEST_4((quantized_product<int8_t, int8_t, ColMajor, ColMajor>(513, 1031, 257)));
+    CALL_SUBTEST_4((quantized_product<uint8_t, int8_t, RowMajor, ColMajor>(17, 3, 5)));
+  }
+}
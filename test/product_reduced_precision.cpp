@@ -0,0 +1,72 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+// Checks that every coefficient of res is the rounding of the float accumulated product ref, up to one ulp.
+template <typename Scalar, typename ResType>
+void verify_rounded(const ResType& res, const MatrixXf& ref) {
+  const float eps = std::ldexp(1.f, 1 - NumTraits<Scalar>::digits());
+  MatrixXf err = (res.template cast<float>() - ref).cwiseAbs();
+  MatrixXf tol = eps * ref.cwiseAbs().array() + 1e-3f;
+  VERIFY((err.array() <= tol.array()).all());
+}
+
+template <typename Scalar, int LhsOrder, int ResOrder>
+void reduced_precision_product(Index rows, Index cols, Index depth) {
+  typedef Matrix<Scalar, Dynamic, Dynamic, LhsOrder> LhsType;
+  typedef Matrix<Scalar, Dynamic, Dynamic> RhsType;
+  typedef Matrix<Scalar, Dynamic, Dynamic, ResOrder> ResType;
+
+  LhsType lhs = MatrixXf::Random(rows, depth).cast<Scalar>();
+  RhsType rhs = MatrixXf::Random(depth, cols).cast<Scalar>();
+  const MatrixXf lhsf = lhs.template cast<float>();
+  const MatrixXf rhsf = rhs.template cast<float>();
+  MatrixXf ref = lhsf * rhsf;
+
+  ResType res = lhs * rhs;
+  VERIFY_IS_EQUAL(res.rows(), rows);
+  VERIFY_IS_EQUAL(res.cols(), cols);
+  VERIFY_IS_APPROX(res, ref.cast<Scalar>());
+#ifdef EIGEN_VECTORIZE_AVX
+  // With float accumulation the result is rounded only once, even for large depths. Note that runtime vectors and
+  // very small matrices are handled by the matrix-vector and coefficient-based products instead.
+  if (rows > 1 && cols > 1 && rows + cols + depth >= EIGEN_GEMM_TO_COEFFBASED_THRESHOLD)
+    verify_rounded<Scalar>(res, ref);
+#endif
+
+  // Scaling and accumulation into an existing result.
+  ResType res2 = ResType::Random(rows, cols);
+  MatrixXf ref2 = res2.template cast<float>();
+  ref2.noalias() += float(2) * (lhsf * rhsf);
+  res2.noalias() += Scalar(2) * lhs * rhs;
+  VERIFY_IS_APPROX(res2, ref2.cast<Scalar>());
+
+  // Result with a non unit inner stride.
+  Matrix<Scalar, Dynamic, Dynamic> buffer(2 * rows, cols);
+  Map<Matrix<Scalar, Dynamic, Dynamic>, 0, Stride<Dynamic, 2> > strided(buffer.data(), rows, cols,
+                                                                      Stride<Dynamic, 2>(2 * rows, 2));
+  strided.noalias() = lhs * rhs;
+  VERIFY_IS_APPROX(strided, ref.cast<Scalar>());
+}
+
+EIGEN_DECLARE_TEST(product_reduced_precision) {
+  for (int i = 0; i < g_repeat; i++) {
+    const Index rows = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    const Index cols = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    const Index depth = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    CALL_SUBTEST_1((reduced_precision_product<bfloat16, ColMajor, ColMajor>(rows, cols, depth)));
+    CALL_SUBTEST_1((reduced_precision_product<bfloat16, RowMajor, RowMajor>(rows, cols, depth)));
+    CALL_SUBTEST_2((reduced_precision_product<half, ColMajor, ColMajor>(rows, cols, depth)));
+    CALL_SUBTEST_2((reduced_precision_product<half, RowMajor, RowMajor>(rows, cols, depth)));
+  }
+  // Deep products, for which rounding the partial sums to 16 bits would lose most of the precision.
+  CALL_SUBTEST_1((reduced_precision_product<bfloat16, ColMajor, ColMajor>(200, 150, 2000)));
+  CALL_SUBTEST_2((reduced_precision_product<half, RowMajor, ColMajor>(150, 200, 2000)));
+}
@@ -0,0 +1,90 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template <typename MatrixType>
+void strassen_product(Index rows, Index depth, Index cols, int maxLevels, Index minBlockSize) {
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic> ColMatrix;
+  typedef Matrix<Scalar, Dynamic, Dynamic, RowMajor> RowMatrix;
+  MatrixType lhs = MatrixType::Random(rows, depth);
+  MatrixType rhs = MatrixType::Random(depth, cols);
+  ColMatrix ref = lhs * rhs;
+
+  ColMatrix res;
+  strassenProduct(lhs, rhs, res, maxLevels, minBlockSize);
+  VERIFY_IS_APPROX(res, ref);
+
+  RowMatrix row_res;
+  strassenProduct(lhs, rhs, row_res, maxLevels, minBlockSize);
+  VERIFY_IS_APPROX(row_res, ref);
+
+  // Blocks, expressions, and a column-major block of a larger destination.
+  ColMatrix big = ColMatrix::Zero(cols + 3, rows + 2);
+  auto dst = big.block(1, 2, cols, rows);
+  strassenProduct(rhs.adjoint(), lhs.adjoint(), dst, maxLevels, minBlockSize);
+  VERIFY_IS_APPROX(dst, ref.adjoint());
+  VERIFY(big.topRows(1).isZero() && big.leftCols(2).isZero());
+
+  if (rows > 2 && depth > 2) {
+    strassenProduct(lhs.bottomRightCorner(rows - 1, depth - 2), rhs.bottomRows(depth - 2), res, maxLevels,
+                    minBlockSize);
+    VERIFY_IS_APPROX(res, lhs.bottomRightCorner(rows - 1, depth - 2) * rhs.bottomRows(depth - 2));
+  }
+}
+
+// Integer products are exact, whatever the recursion.
+void strassen_product_exact(Index rows, Index depth, Index cols, int maxLevels) {
+  MatrixXi lhs = MatrixXi::NullaryExpr(rows, depth, [] { return internal::random<int>(-100, 100); });
+  MatrixXi rhs = MatrixXi::NullaryExpr(depth, cols, [] { return internal::random<int>(-100, 100); });
+  MatrixXi res;
+  strassenProduct(lhs, rhs, res, maxLevels, 1);
+  VERIFY_IS_EQUAL(res, MatrixXi(lhs * rhs));
+}
+
+// The error of the recursion stays close to the one of the classical product, measured against a product computed
+// in a wider type.
+void strassen_product_accuracy(Index size, int maxLevels, Index minBlockSize) {
+  MatrixXf lhs = MatrixXf::Random(size, size);
+  MatrixXf rhs = MatrixXf::Random(size, size);
+  MatrixXd ref = lhs.cast<double>() * rhs.cast<double>();
+  MatrixXf res;
+  strassenProduct(lhs, rhs, res, maxLevels, minBlockSize);
+  MatrixXf classical = lhs * rhs;
+  const double error = (res.cast<double>() - ref).cwiseAbs().maxCoeff();
+  const double classical_error = (classical.cast<double>() - ref).cwiseAbs().maxCoeff();
+  // Normwise bound of the Strassen-Winograd algorithm, see the documentation of strassenProduct().
+  const double n0 = double(size >> maxLevels);
+  const double bound = (std::pow(18.0, maxLevels) * (n0 * n0 + 6 * n0) - 6 * double(size)) *
+                       double(NumTraits<float>::epsilon()) / 2;
+  VERIFY(error <= bound);
+  VERIFY(error <= 100 * classical_error);
+}
+
+EIGEN_DECLARE_TEST(product_strassen) {
+  for (int i = 0; i < g_repeat; i++) {
+    const Index rows = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    const Index cols = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    const Index depth = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    const int levels = internal::random<int>(0, 4);
+    CALL_SUBTEST_1(strassen_product<MatrixXd>(rows, depth, cols, levels, 4));
+    CALL_SUBTEST_1(strassen_product<MatrixXd>(rows, 1, cols, levels, 1));
+    CALL_SUBTEST_2(strassen_product<MatrixXf>(rows, depth, cols, levels, 8));
+    CALL_SUBTEST_3((strassen_product<Matrix<std::complex<double>, Dynamic, Dynamic, RowMajor> >(rows, depth, cols,
+                                                                                                 levels, 2)));
+    CALL_SUBTEST_4(strassen_product_exact(rows, depth, cols, levels));
+  }
+  // Odd sizes at every level.
+  CALL_SUBTEST_1(strassen_product<MatrixXd>(67, 45, 53, 3, 2));
+  CALL_SUBTEST_1(strassen_product<MatrixXd>(256, 256, 256, 2, 64));
+  CALL_SUBTEST_4(strassen_product_exact(67, 45, 53, 5));
+  CALL_SUBTEST_2(strassen_product_accuracy(512, 1, 64));
+  CALL_SUBTEST_2(strassen_product_accuracy(512, 2, 64));
+}
@@ -9,20 +9,277 @@
 
 #define EIGEN_GEMM_THREADPOOL
 #include "main.h"
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
 
-void test_parallelize_gemm() {
+void test_parallelize_gemm(ThreadPool& pool) {
   constexpr int n = 1024;
-  constexpr int num_threads = 4;
   MatrixXf a = MatrixXf::Random(n, n);
   MatrixXf b = MatrixXf::Random(n, n);
   MatrixXf c = MatrixXf::Random(n, n);
+  setNbThreads(1);
   c.noalias() = a * b;
 
-  ThreadPool pool(num_threads);
+  setNbThreads(pool.NumThreads());
   MatrixXf c_threaded(n, n);
   c_threaded.noalias() = a * b;
 
   VERIFY_IS_APPROX(c, c_threaded);
+  setNbThreads(1);
+}
+
+template <typename MatrixType, typename ResultType>
+void test_tiled_gemm(ThreadPool& pool, Index rows, Index depth, Index cols) {
+  MatrixType a = MatrixType::Random(rows, depth);
+  MatrixType b = MatrixType::Random(depth, cols);
+  ResultType ref(rows, cols);
+  setNbThreads(1);
+  ref.noalias() = a * b;
+
+  setNbThreads(pool.NumThreads());
+  ResultType res(rows, cols);
+  res.noalias() = a * b;
+  VERIFY_IS_APPROX(ref, res);
+
+  // Block all workers of the pool: the calling thread has to compute every tile by itself
+  // instead of waiting for the descheduled workers.
+  Notification release;
+  Barrier released(pool.NumThreads());
+  for (int i = 0; i < pool.NumThreads(); ++i) {
+    pool.Schedule([&release, &released] {
+      release.Wait();
+      released.Notify();
+    });
+  }
+  res.setZero();
+  res.noalias() += a * b;
+  VERIFY_IS_APPROX(ref, res);
+  release.Notify();
+  released.Wait();
+  setNbThreads(1);
+}
+
+// Runs several products from inside tasks of the GEMM pool itself. Each of them may split into
+// sub-tasks on the same pool, with the calling worker helping to compute its own tiles.
+void test_nested_gemm(ThreadPool& pool) {
+  constexpr int num_products = 6;
+  constexpr int n = 300;
+  std::vector<MatrixXd> a(num_products), b(num_products), ref(num_products), res(num_products);
+  setNbThreads(1);
+  for (int i = 0; i < num_products; ++i) {
+    a[i] = MatrixXd::Random(n, n);
+    b[i] = MatrixXd::Random(n, n);
+    ref[i].noalias() = a[i] * b[i];
+  }
+
+  setNbThreads(pool.NumThreads());
+  Barrier barrier(num_products);
+  for (int i = 0; i < num_products; ++i) {
+    pool.Schedule([&, i] {
+      VERIFY(pool.CurrentThreadId() != -1);
+      res[i].noalias() = a[i] * b[i];
+      barrier.Notify();
+    });
+  }
+  barrier.Wait();
+  for (int i = 0; i < num_products; ++i) VERIFY_IS_APPROX(ref[i], res[i]);
+  setNbThreads(1);
 }
 
-EIGEN_DECLARE_TEST(product_threaded) { CALL_SUBTEST(test_parallelize_gemm()); }
+template <typename MatrixType>
+void test_parallel_gemv(ThreadPool& pool, Index rows, Index cols) {
+  typedef Matrix<typename MatrixType::Scalar, Dynamic, 1> VectorType;
+  MatrixType a = MatrixType::Random(rows, cols);
+  VectorType x = VectorType::Random(cols);
+  VectorType y = VectorType::Random(rows);
+  setNbThreads(1);
+  VectorType ref = VectorType::Random(rows);
+  VectorType ref_t = VectorType::Random(cols);
+  VectorType res = ref, res_t = ref_t;
+  ref.noalias() += a * x;
+  ref_t.noalias() -= a.adjoint() * y;
+
+  setNbThreads(pool.NumThreads());
+  res.noalias() += a * x;
+  res_t.noalias() -= a.adjoint() * y;
+  VERIFY_IS_APPROX(ref, res);
+  VERIFY_IS_APPROX(ref_t, res_t);
+  setNbThreads(1);
+}
+
+template <typename MatrixType, int Mode>
+void test_parallel_trmv_trsv(ThreadPool& pool, Index rows, Index cols) {
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  MatrixType a = MatrixType::Random(rows, cols);
+  a.diagonal().array() += Scalar(2 * rows);
+  VectorType x = VectorType::Random(cols);
+  setNbThreads(1);
+  VectorType ref = a.template triangularView<Mode>() * x;
+  VectorType ref_t = x.transpose() * a.adjoint().template triangularView<Mode == Lower ? Upper : Lower>();
+
+  setNbThreads(pool.NumThreads());
+  VectorType res = a.template triangularView<Mode>() * x;
+  VectorType res_t = x.transpose() * a.adjoint().template triangularView<Mode == Lower ? Upper : Lower>();
+  VERIFY_IS_APPROX(ref, res);
+  VERIFY_IS_APPROX(ref_t, res_t);
+
+  if (rows == cols) {
+    // The diagonal dominance keeps the systems well conditioned.
+    typedef Matrix<Scalar, 1, Dynamic> RowVectorType;
+    VectorType b = VectorType::Random(rows);
+    res = a.template triangularView<Mode>().solve(b);
+    RowVectorType res_r = b.transpose();
+    a.template triangularView<Mode>().template solveInPlace<OnTheRight>(res_r);
+    setNbThreads(1);
+    VERIFY_IS_APPROX(a.template triangularView<Mode>() * res, b);
+    VERIFY_IS_APPROX(res_r * a.template triangularView<Mode>(), b.transpose());
+  }
+  setNbThreads(1);
+}
+
+template <typename MatrixType, int Mode>
+void test_parallel_trsm(ThreadPool& pool, Index size, Index other_size) {
+  typedef typename MatrixType::Scalar Scalar;
+  MatrixType a = MatrixType::Random(size, size);
+  a.diagonal().array() += Scalar(2 * size);
+  MatrixType b = MatrixType::Random(size, other_size);
+  MatrixType c = MatrixType::Random(other_size, size);
+  setNbThreads(1);
+  MatrixType ref = a.template triangularView<Mode>().solve(b);
+  MatrixType ref_r = c;
+  a.template triangularView<Mode>().template solveInPlace<OnTheRight>(ref_r);
+
+  setNbThreads(pool.NumThreads());
+  MatrixType res = a.template triangularView<Mode>().solve(b);
+  MatrixType res_r = c;
+  a.template triangularView<Mode>().template solveInPlace<OnTheRight>(res_r);
+  VERIFY_IS_APPROX(ref, res);
+  VERIFY_IS_APPROX(ref_r, res_r);
+  setNbThreads(1);
+}
+
+template <typename MatrixType, int UpLo>
+void test_parallel_rank_update(ThreadPool& pool, Index size, Index depth) {
+  MatrixType a = MatrixType::Random(size, depth);
+  MatrixType b = MatrixType::Random(depth, size);
+  MatrixType c = MatrixType::Random(size, size);
+  setNbThreads(1);
+  MatrixType ref = c, ref_ab = c;
+  ref.template selfadjointView<UpLo>().rankUpdate(a, -1);
+  ref_ab.template triangularView<UpLo>() += a * b;
+
+  setNbThreads(pool.NumThreads());
+  MatrixType res = c, res_ab = c;
+  res.template selfadjointView<UpLo>().rankUpdate(a, -1);
+  res_ab.template triangularView<UpLo>() += a * b;
+  // The opposite triangles must be left untouched.
+  VERIFY_IS_APPROX(ref, res);
+  VERIFY_IS_APPROX(ref_ab, res_ab);
+  VERIFY_IS_EQUAL(MatrixType(res.template triangularView<UpLo == Lower ? StrictlyUpper : StrictlyLower>()),
+                  MatrixType(c.template triangularView<UpLo == Lower ? StrictlyUpper : StrictlyLower>()));
+  VERIFY_IS_EQUAL(MatrixType(res_ab.template triangularView<UpLo == Lower ? StrictlyUpper : StrictlyLower>()),
+                  MatrixType(c.template triangularView<UpLo == Lower ? StrictlyUpper : StrictlyLower>()));
+  setNbThreads(1);
+}
+
+// Blocked Cholesky and LU spend most of their time in the triangular solves and the rank-k updates.
+void test_parallel_decompositions(ThreadPool& pool, Index size) {
+  MatrixXd a = MatrixXd::Random(size, size);
+  MatrixXd spd = a * a.adjoint() + MatrixXd::Identity(size, size);
+  MatrixXd b = MatrixXd::Random(size, 3);
+  setNbThreads(1);
+  MatrixXd ref_llt = spd.llt().solve(b);
+  MatrixXd ref_lu = a.partialPivLu().solve(b);
+
+  setNbThreads(pool.NumThreads());
+  VERIFY_IS_APPROX(ref_llt, spd.llt().solve(b));
+  VERIFY_IS_APPROX(ref_lu, a.partialPivLu().solve(b));
+  setNbThreads(1);
+}
+
+// Coefficient-wise assignments above the threshold are evaluated by the pool, and give the same results.
+void test_parallel_assignment(ThreadPool& pool, Index size) {
+  VectorXd y = VectorXd::Random(size), z = VectorXd::Random(size);
+  MatrixXf a = MatrixXf::Random(size / 16 + 3, 19);
+  setNbThreads(pool.NumThreads());
+  VectorXd ref = 2 * y + 3 * z.array().exp().matrix();
+  MatrixXf ref_block = 2 * a.block(1, 2, size / 16, 17);
+
+  setParallelAssignmentThreshold(1e4);
+  VERIFY_IS_EQUAL(parallelAssignmentThreshold(), 1e4);
+  VectorXd x = 2 * y + 3 * z.array().exp().matrix();
+  VERIFY_IS_EQUAL(x, ref);
+  MatrixXf res_block = MatrixXf::Zero(size / 16 + 5, 20);
+  res_block.block(2, 1, size / 16, 17) = 2 * a.block(1, 2, size / 16, 17);
+  VERIFY_IS_EQUAL(MatrixXf(res_block.block(2, 1, size / 16, 17)), ref_block);
+  res_block.block(2, 1, size / 16, 17).setZero();
+  VERIFY(res_block.isZero(0));
+
+  // Inner dimensions fixed at compile time are unrolled.
+  Matrix<float, 9, Dynamic> c = Matrix<float, 9, Dynamic>::Random(9, size / 8);
+  Matrix<float, 9, Dynamic> res_c = c;
+  res_c.topRows<7>() = 2 * c.bottomRows<7>() + c.bottomRows<7>().cwiseAbs2();
+  setParallelAssignmentThreshold(0);
+  Matrix<float, 9, Dynamic> ref_c = c;
+  ref_c.topRows<7>() = 2 * c.bottomRows<7>() + c.bottomRows<7>().cwiseAbs2();
+  VERIFY_IS_EQUAL(res_c, ref_c);
+  setParallelAssignmentThreshold(1e4);
+
+  std::atomic<bool> in_pool(false);
+  auto record = [&](double v) {
+    if (pool.CurrentThreadId() != -1) in_pool = true;
+    return v;
+  };
+  x = y.unaryExpr(record);
+  VERIFY_IS_EQUAL(x, y);
+  VERIFY(in_pool);
+
+  // Small assignments, and the ones with a single thread, stay in the calling thread.
+  in_pool = false;
+  x.head(100) = y.head(100).unaryExpr(record);
+  setNbThreads(1);
+  x = y.unaryExpr(record);
+  VERIFY(!in_pool);
+
+  // Random() is counter-based, so the pool gives the same coefficients as the calling thread.
+  setNbThreads(pool.NumThreads());
+  std::srand(42);
+  ref = VectorXd::Random(size);
+  setParallelAssignmentThreshold(0);
+  std::srand(42);
+  VERIFY_IS_EQUAL(VectorXd(VectorXd::Random(size)), ref);
+  setNbThreads(1);
+}
+
+EIGEN_DECLARE_TEST(product_threaded) {
+  constexpr int num_threads = 4;
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+  CALL_SUBTEST(test_parallelize_gemm(pool));
+  CALL_SUBTEST((test_tiled_gemm<MatrixXd, MatrixXd>(pool, 517, 301, 389)));
+  CALL_SUBTEST((test_tiled_gemm<MatrixXd, Matrix<double, Dynamic, Dynamic, RowMajor>>(pool, 389, 517, 301)));
+  CALL_SUBTEST((test_tiled_gemm<MatrixXcf, MatrixXcf>(pool, 250, 700, 130)));
+  CALL_SUBTEST(test_nested_gemm(pool));
+  CALL_SUBTEST(test_parallel_gemv<MatrixXd>(pool, 1500, 700));
+  CALL_SUBTEST(test_parallel_gemv<MatrixXd>(pool, 300, 2500));
+  CALL_SUBTEST((test_parallel_gemv<Matrix<double, Dynamic, Dynamic, RowMajor>>(pool, 1300, 900)));
+  CALL_SUBTEST(test_parallel_gemv<MatrixXcf>(pool, 700, 800));
+  CALL_SUBTEST((test_parallel_trmv_trsv<MatrixXd, Lower>(pool, 1100, 1100)));
+  CALL_SUBTEST((test_parallel_trmv_trsv<MatrixXd, Upper>(pool, 1100, 1100)));
+  CALL_SUBTEST((test_parallel_trmv_trsv<MatrixXd, Lower>(pool, 1300, 900)));
+  CALL_SUBTEST((test_parallel_trmv_trsv<MatrixXd, Upper>(pool, 900, 1300)));
+  CALL_SUBTEST((test_parallel_trmv_trsv<Matrix<double, Dynamic, Dynamic, RowMajor>, Lower>(pool, 1100, 1100)));
+  CALL_SUBTEST((test_parallel_trmv_trsv<Matrix<double, Dynamic, Dynamic, RowMajor>, Upper>(pool, 1100, 1100)));
+  CALL_SUBTEST((test_parallel_trmv_trsv<MatrixXcd, Lower>(pool, 700, 700)));
+  CALL_SUBTEST((test_parallel_trsm<MatrixXd, Lower>(pool, 500, 700)));
+  CALL_SUBTEST((test_parallel_trsm<MatrixXd, UnitUpper>(pool, 300, 1000)));
+  CALL_SUBTEST((test_parallel_trsm<Matrix<double, Dynamic, Dynamic, RowMajor>, Upper>(pool, 500, 700)));
+  CALL_SUBTEST((test_parallel_trsm<MatrixXcf, Lower>(pool, 300, 500)));
+  CALL_SUBTEST((test_parallel_rank_update<MatrixXd, Lower>(pool, 900, 300)));
+  CALL_SUBTEST((test_parallel_rank_update<MatrixXd, Upper>(pool, 900, 300)));
+  CALL_SUBTEST((test_parallel_rank_update<Matrix<double, Dynamic, Dynamic, RowMajor>, Lower>(pool, 700, 200)));
+  CALL_SUBTEST((test_parallel_rank_update<MatrixXcd, Upper>(pool, 500, 100)));
+  CALL_SUBTEST(test_parallel_decompositions(pool, 1000));
+  CALL_SUBTEST(test_parallel_assignment(pool, 100000));
+}
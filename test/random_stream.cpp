@@ -0,0 +1,174 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS 1
+
+#include "main.h"
+#include <Eigen/ThreadPool>
+
+// Known answers of the Threefry-2x32-20 and Threefry-2x64-20 block ciphers, from the kat_vectors file of Random123.
+template <typename Word>
+void random_stream_threefry_kat(Word c0, Word c1, Word k0, Word k1, Word r0, Word r1) {
+  internal::threefry_key<Word>(k0, k1).encrypt(c0, c1);
+  VERIFY_IS_EQUAL(c0, r0);
+  VERIFY_IS_EQUAL(c1, r1);
+}
+
+void random_stream_threefry_kat() {
+  random_stream_threefry_kat<uint32_t>(0, 0, 0, 0, 0x6b200159u, 0x99ba4efeu);
+  random_stream_threefry_kat<uint32_t>(0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0x1cb996fcu, 0xbb002be7u);
+  random_stream_threefry_kat<uint32_t>(0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u, 0xc4923a9cu, 0x483df7a0u);
+  random_stream_threefry_kat<uint64_t>(0, 0, 0, 0, 0xc2b6e3a8c2c69865ull, 0x6f81ed42f350084dull);
+  random_stream_threefry_kat<uint64_t>(0x243f6a8885a308d3ull, 0x13198a2e03707344ull, 0xa4093822299f31d0ull,
+                                       0x082efa98ec4e6c89ull, 0x263c7d30bb0f0af1ull, 0x56be8361d3311526ull);
+}
+
+// The coefficients only depend on the stream and on their position, whatever the traversal.
+template <typename MatrixType>
+void random_stream_reproducibility(Index rows, Index cols) {
+  typedef typename MatrixType::Scalar Scalar;
+  const RandomStream stream(internal::random<uint64_t>(), internal::random<uint64_t>());
+  const MatrixType m = MatrixType::Random(rows, cols, stream);
+  VERIFY(MatrixType(MatrixType::Random(rows, cols, stream)) == m);
+  VERIFY(MatrixType(MatrixType::Random(rows, cols, RandomStream(stream.seed() + 1, stream.stream()))) != m);
+  VERIFY(MatrixType(MatrixType::Random(rows, cols, RandomStream(stream.seed(), stream.stream() + 1))) != m);
+
+  // Scalar accesses, blocks, reversed and lazy expressions.
+  const auto xpr = MatrixType::Random(rows, cols, stream);
+  for (Index j = 0; j < cols; ++j)
+    for (Index i = 0; i < rows; ++i) VERIFY_IS_EQUAL(xpr.coeff(i, j), m(i, j));
+  const Index r = rows / 3, c = cols / 2;
+  VERIFY(xpr.bottomRightCorner(rows - r, cols - c) == m.bottomRightCorner(rows - r, cols - c));
+  VERIFY(MatrixType(xpr.reverse()) == m.reverse());
+  VERIFY(MatrixType(xpr.unaryExpr([](const Scalar& x) { return x; })) == m);
+  VERIFY(MatrixType((xpr - m).cwiseAbs()) == MatrixType::Zero(rows, cols));
+
+  MatrixType m2(rows, cols);
+  m2.setRandom(stream);
+  VERIFY(m2 == m);
+
+  // Random() is seeded from std::rand().
+  std::srand(static_cast<unsigned>(g_seed));
+  m2 = MatrixType::Random(rows, cols);
+  std::srand(static_cast<unsigned>(g_seed));
+  VERIFY(MatrixType(MatrixType::Random(rows, cols)) == m2);
+}
+
+template <typename MatrixType>
+void random_stream_normal_reproducibility(Index rows, Index cols) {
+  const RandomStream stream(internal::random<uint64_t>(), internal::random<uint64_t>());
+  const MatrixType n = MatrixType::RandomNormal(rows, cols, stream);
+  const auto normal = MatrixType::RandomNormal(rows, cols, stream);
+  for (Index j = 0; j < cols; ++j)
+    for (Index i = 0; i < rows; ++i) VERIFY_IS_EQUAL(normal.coeff(i, j), n(i, j));
+  VERIFY(MatrixType(normal.reverse()) == n.reverse());
+  VERIFY(normal.bottomRows(rows / 2) == n.bottomRows(rows / 2));
+}
+
+template <typename VectorType>
+void random_stream_distribution(Index size) {
+  typedef typename VectorType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  const RealScalar n = RealScalar(size);
+  const VectorType u = VectorType::Random(size, RandomStream(internal::random<uint64_t>()));
+  VERIFY((u.real().array() >= RealScalar(-1)).all() && (u.real().array() < RealScalar(1)).all());
+  VERIFY(numext::abs(u.real().mean()) < RealScalar(5) / numext::sqrt(n));
+  VERIFY(numext::abs(u.real().squaredNorm() / n - RealScalar(1) / RealScalar(3)) < RealScalar(5) / numext::sqrt(n));
+
+  const VectorType z = VectorType::RandomNormal(size, RandomStream(internal::random<uint64_t>()));
+  VERIFY((z.array() == z.array()).all());
+  VERIFY(numext::abs(z.real().mean()) < RealScalar(5) / numext::sqrt(n));
+  VERIFY(numext::abs(z.real().squaredNorm() / n - RealScalar(1)) < RealScalar(10) / numext::sqrt(n));
+  VERIFY(numext::abs(z.imag().squaredNorm() / n - RealScalar(NumTraits<Scalar>::IsComplex)) <
+         RealScalar(10) / numext::sqrt(n));
+  // The tails of the normal distribution are reached.
+  VERIFY(z.real().maxCoeff() > RealScalar(3) && z.real().minCoeff() < RealScalar(-3));
+}
+
+template <typename Scalar>
+void random_stream_integers() {
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  const VectorType v = VectorType::Random(1000, RandomStream(internal::random<uint64_t>()));
+  VERIFY((v.array() < Scalar(0)).count() > 400 && (v.array() > Scalar(0)).count() > 400);
+  VERIFY(v.maxCoeff() > NumTraits<Scalar>::highest() / 2);
+  VERIFY(v.minCoeff() < NumTraits<Scalar>::lowest() / 2);
+}
+
+// The lanes of a packet whose 32-bit counters wrap around are the scalar coefficients.
+template <typename Op>
+void random_stream_counter_carry(const Op&, std::false_type) {}
+
+template <typename Op>
+void random_stream_counter_carry(const Op& op, std::true_type) {
+  typedef decltype(op(0)) Scalar;
+  typedef typename internal::packet_traits<Scalar>::type Packet;
+  enum { Size = internal::packet_traits<Scalar>::size };
+  for (Index index : {(Index(1) << 32) - Size, (Index(1) << 32) - 1, (Index(1) << 32) - 2, (Index(1) << 33) - 3}) {
+    EIGEN_ALIGN_MAX Scalar lanes[Size];
+    internal::pstore(lanes, op.template packetOp<Packet>(index));
+    for (Index k = 0; k < Size; ++k) VERIFY_IS_EQUAL(lanes[k], op(index + k));
+    VERIFY_IS_EQUAL(op(0, index), op(index));
+  }
+}
+
+template <typename Scalar, bool Normal>
+void random_stream_counter_carry() {
+  typedef internal::counter_random_op<Scalar, Normal> Op;
+  const Op op(RandomStream(internal::random<uint64_t>()), 1, Index(1) << 34, false);
+  random_stream_counter_carry(op, std::integral_constant<bool, bool(Op::PacketAccess)>());
+}
+
+// Random expressions are split over the threads of a CoreThreadPoolDevice without changing their coefficients.
+template <typename MatrixType>
+void random_stream_threaded(Index rows, Index cols) {
+  const RandomStream stream(internal::random<uint64_t>());
+  const MatrixType m = MatrixType::Random(rows, cols, stream);
+  const MatrixType n = MatrixType::RandomNormal(rows, cols, stream);
+  ThreadPool pool(4);
+  CoreThreadPoolDevice device(pool, 1.0f);
+  MatrixType res(rows, cols);
+  res.device(device) = MatrixType::Random(rows, cols, stream);
+  VERIFY(res == m);
+  res.device(device) = MatrixType::RandomNormal(rows, cols, stream);
+  VERIFY(res == n);
+}
+
+EIGEN_DECLARE_TEST(random_stream) {
+  CALL_SUBTEST_1(random_stream_threefry_kat());
+  for (int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(random_stream_reproducibility<MatrixXf>(internal::random<Index>(1, 100),
+                                                           internal::random<Index>(1, 100)));
+    CALL_SUBTEST_1(random_stream_reproducibility<MatrixXd>(internal::random<Index>(1, 100),
+                                                           internal::random<Index>(1, 100)));
+    CALL_SUBTEST_1((random_stream_reproducibility<Matrix<float, Dynamic, Dynamic, RowMajor>>(37, 19)));
+    CALL_SUBTEST_1((random_stream_reproducibility<Matrix<double, 3, 5>>(3, 5)));
+    CALL_SUBTEST_1(random_stream_normal_reproducibility<MatrixXf>(internal::random<Index>(1, 100),
+                                                                  internal::random<Index>(1, 100)));
+    CALL_SUBTEST_1((random_stream_normal_reproducibility<Matrix<double, Dynamic, Dynamic, RowMajor>>(37, 19)));
+    CALL_SUBTEST_2(random_stream_reproducibility<MatrixXcf>(13, 17));
+    CALL_SUBTEST_2(random_stream_normal_reproducibility<MatrixXcd>(13, 17));
+    CALL_SUBTEST_2((random_stream_reproducibility<Matrix<half, Dynamic, Dynamic>>(13, 17)));
+    CALL_SUBTEST_2((random_stream_normal_reproducibility<Matrix<bfloat16, Dynamic, Dynamic>>(13, 17)));
+    CALL_SUBTEST_2((random_stream_reproducibility<Matrix<long double, 7, 3>>(7, 3)));
+    CALL_SUBTEST_2(random_stream_reproducibility<MatrixXi>(23, 11));
+
+    CALL_SUBTEST_3(random_stream_distribution<VectorXf>(100000));
+    CALL_SUBTEST_3(random_stream_distribution<VectorXd>(100000));
+    CALL_SUBTEST_3(random_stream_distribution<VectorXcd>(100000));
+    CALL_SUBTEST_3(random_stream_distribution<VectorXcf>(100000));
+    CALL_SUBTEST_4(random_stream_integers<int>());
+    CALL_SUBTEST_4(random_stream_integers<int64_t>());
+    CALL_SUBTEST_4(random_stream_integers<int16_t>());
+    CALL_SUBTEST_4((random_stream_counter_carry<float, false>()));
+    CALL_SUBTEST_4((random_stream_counter_carry<float, true>()));
+    CALL_SUBTEST_4((random_stream_counter_carry<double, true>()));
+  }
+  CALL_SUBTEST_5(random_stream_threaded<MatrixXf>(1000, 1000));
+  CALL_SUBTEST_5((random_stream_threaded<Matrix<double, Dynamic, Dynamic, RowMajor>>(300000, 3)));
+}
@@ -0,0 +1,180 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_DETERMINISTIC_REDUCTIONS
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+
+// Reduces values[begin, begin + count) along the tree of pairwise_redux(), whose left subtree holds the largest power
+// of two smaller than count.
+template <typename Scalar, typename Func>
+Scalar reference_pairwise(const std::vector<Scalar>& values, Index begin, Index count, const Func& func) {
+  if (count == 1) return values[begin];
+  Index half = 1;
+  while (2 * half < count) half *= 2;
+  return func(reference_pairwise(values, begin, half, func), reference_pairwise(values, begin + half, count - half, func));
+}
+
+// Reference implementation of the fixed-shape tree: leaves of 1024 values, made of 16 interleaved lanes.
+template <typename Scalar, typename Func>
+Scalar reference_redux(const std::vector<Scalar>& values, const Func& func) {
+  const Index size = static_cast<Index>(values.size()), kLanes = 16, kLeafSize = 1024;
+  std::vector<Scalar> leaves;
+  for (Index begin = 0; begin < size; begin += kLeafSize) {
+    std::vector<Scalar> lanes;
+    for (Index k = begin; k < numext::mini(begin + kLeafSize, size); ++k) {
+      if (k - begin < kLanes)
+        lanes.push_back(values[k]);
+      else
+        lanes[(k - begin) % kLanes] = func(lanes[(k - begin) % kLanes], values[k]);
+    }
+    leaves.push_back(reference_pairwise(lanes, 0, static_cast<Index>(lanes.size()), func));
+  }
+  return reference_pairwise(leaves, 0, static_cast<Index>(leaves.size()), func);
+}
+
+// The coefficients of an expression in storage order.
+template <typename Xpr>
+std::vector<typename Xpr::Scalar> storage_order_values(const DenseBase<Xpr>& xpr) {
+  std::vector<typename Xpr::Scalar> values;
+  for (Index j = 0; j < xpr.outerSize(); ++j)
+    for (Index i = 0; i < xpr.innerSize(); ++i)
+      values.push_back(Xpr::IsRowMajor ? xpr.derived().coeff(j, i) : xpr.derived().coeff(i, j));
+  return values;
+}
+
+template <typename MatrixType>
+void deterministic_redux(Index rows, Index cols) {
+  typedef typename MatrixType::Scalar Scalar;
+  MatrixType m = MatrixType::Random(rows, cols);
+  MatrixType m2 = MatrixType::Random(rows, cols);
+  auto sum = [](const Scalar& a, const Scalar& b) { return a + b; };
+  auto product = [](const Scalar& a, const Scalar& b) { return a * b; };
+
+  const Scalar s = reference_redux(storage_order_values(m), sum);
+  VERIFY_IS_EQUAL(m.sum(), s);
+  VERIFY_IS_EQUAL(m.mean(), s / Scalar(m.size()));
+  // Without packet access.
+  VERIFY_IS_EQUAL(m.unaryExpr([](const Scalar& x) { return x; }).sum(), s);
+  VERIFY_IS_EQUAL(m.cwiseProduct(m2).sum(), reference_redux(storage_order_values(m.cwiseProduct(m2)), sum));
+  VERIFY_IS_EQUAL(m.cwiseAbs2().sum(), reference_redux(storage_order_values(m.cwiseAbs2()), sum));
+  MatrixType ones = MatrixType::Ones(rows, cols) + m * Scalar(1e-3);
+  VERIFY_IS_EQUAL(ones.prod(), reference_redux(storage_order_values(ones), product));
+
+  // Blocks whose groups of lanes span several outer vectors.
+  if (rows > 2 && cols > 2) {
+    auto block = m.bottomRightCorner(rows - 1, cols - 2);
+    VERIFY_IS_EQUAL(block.sum(), reference_redux(storage_order_values(block), sum));
+  }
+
+  // Vectorized and scalar partial reductions follow the same tree as the full ones.
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  VectorType rowwise = m.rowwise().sum();
+  for (Index i = 0; i < rows; ++i) VERIFY_IS_EQUAL(rowwise(i), reference_redux(storage_order_values(m.row(i)), sum));
+  VectorType colwise = m.colwise().sum().transpose();
+  for (Index j = 0; j < cols; ++j) VERIFY_IS_EQUAL(colwise(j), reference_redux(storage_order_values(m.col(j)), sum));
+}
+
+template <typename VectorType>
+void deterministic_dot(Index size) {
+  typedef typename VectorType::Scalar Scalar;
+  VectorType v = VectorType::Random(size), w = VectorType::Random(size);
+  auto sum = [](const Scalar& a, const Scalar& b) { return a + b; };
+  VERIFY_IS_EQUAL(v.dot(w), reference_redux(storage_order_values(v.cwiseProduct(w)), sum));
+  VERIFY_IS_EQUAL(v.squaredNorm(), reference_redux(storage_order_values(v.cwiseAbs2()), sum));
+  // Unaligned segments.
+  VERIFY_IS_EQUAL(v.tail(size - 1).dot(w.head(size - 1)),
+                  reference_redux(storage_order_values(v.tail(size - 1).cwiseProduct(w.head(size - 1))), sum));
+}
+
+// The reductions on a CoreThreadPoolDevice match the sequential ones, whatever the number of threads.
+template <typename MatrixType>
+void deterministic_threaded_redux(Index rows, Index cols) {
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  MatrixType m = MatrixType::Random(rows, cols);
+  const Scalar s = m.sum();
+  const VectorType rowwise = m.rowwise().sum();
+  const VectorType colwise = m.colwise().sum().transpose();
+  for (int threads = 1; threads <= 4; ++threads) {
+    ThreadPool pool(threads);
+    CoreThreadPoolDevice device(pool, 1.0f);
+    VERIFY_IS_EQUAL(m.device(device).sum(), s);
+    VERIFY_IS_EQUAL(m.cwiseAbs2().device(device).sum(), m.cwiseAbs2().sum());
+    VectorType res(rows);
+    res.device(device) = m.rowwise().sum();
+    VERIFY(res == rowwise);
+    res.resize(cols);
+    res.device(device) = m.colwise().sum().transpose();
+    VERIFY(res == colwise);
+  }
+}
+
+// The matrix products do not depend on the number of threads, nor on the path of the kernel computing a coefficient.
+template <typename MatrixType>
+void deterministic_products(Index rows, Index depth, Index cols) {
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  MatrixType a = MatrixType::Random(rows, depth);
+  MatrixType b = MatrixType::Random(depth, cols);
+  MatrixType sq = MatrixType::Random(rows, rows) + MatrixType::Identity(rows, rows) * Scalar(rows);
+  VectorType v = VectorType::Random(depth), w = VectorType::Random(rows);
+
+  setNbThreads(1);
+  const MatrixType ab = a * b;
+  const MatrixType scaled = Scalar(3) * a * b;
+  const VectorType gemv = a * v, wide_gemv = a.transpose() * w;
+  const VectorType trmv = sq.template triangularView<Lower>() * w;
+  const VectorType trsv = sq.template triangularView<Upper>().solve(w);
+  MatrixType syrk = MatrixType::Zero(rows, rows);
+  syrk.template selfadjointView<Lower>().rankUpdate(a);
+
+  const Index r = rows / 3;
+  VERIFY(MatrixType(a.topRows(r) * b) == ab.topRows(r));
+  VERIFY(MatrixType(a.bottomRows(rows - r) * b) == ab.bottomRows(rows - r));
+  VERIFY(MatrixType(a * b.rightCols(cols / 2)) == ab.rightCols(cols / 2));
+
+  for (int threads = 2; threads <= 4; ++threads) {
+    setNbThreads(threads);
+    VERIFY(MatrixType(a * b) == ab);
+    VERIFY(MatrixType(Scalar(3) * a * b) == scaled);
+    VERIFY(VectorType(a * v) == gemv);
+    VERIFY(VectorType(a.transpose() * w) == wide_gemv);
+    VERIFY(VectorType(sq.template triangularView<Lower>() * w) == trmv);
+    VERIFY(VectorType(sq.template triangularView<Upper>().solve(w)) == trsv);
+    MatrixType syrk_threaded = MatrixType::Zero(rows, rows);
+    syrk_threaded.template selfadjointView<Lower>().rankUpdate(a);
+    VERIFY(syrk_threaded == syrk);
+  }
+  setNbThreads(1);
+}
+
+EIGEN_DECLARE_TEST(redux_deterministic) {
+  for (int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(deterministic_redux<MatrixXf>(internal::random<Index>(1, 200), internal::random<Index>(1, 200)));
+    CALL_SUBTEST_1(deterministic_redux<MatrixXd>(3, 5000));
+    CALL_SUBTEST_1(deterministic_redux<ArrayXXd>(5000, 3));
+    CALL_SUBTEST_1((deterministic_redux<Matrix<float, Dynamic, Dynamic, RowMajor>>(2500, 7)));
+    CALL_SUBTEST_1((deterministic_redux<Matrix<double, 4, 4>>(4, 4)));
+    CALL_SUBTEST_1((deterministic_redux<Matrix<float, 7, 3>>(7, 3)));
+    CALL_SUBTEST_2(deterministic_dot<VectorXf>(internal::random<Index>(2, 100000)));
+    CALL_SUBTEST_2(deterministic_dot<VectorXd>(internal::random<Index>(2, 100000)));
+    CALL_SUBTEST_2(deterministic_dot<Vector4f>(4));
+  }
+  CALL_SUBTEST_3(deterministic_threaded_redux<MatrixXf>(1000, 1000));
+  CALL_SUBTEST_3(deterministic_threaded_redux<MatrixXd>(3, 300000));
+  CALL_SUBTEST_3((deterministic_threaded_redux<Matrix<double, Dynamic, Dynamic, RowMajor>>(300000, 3)));
+
+  ThreadPool pool(4);
+  setGemmThreadPool(&pool);
+  CALL_SUBTEST_4(deterministic_products<MatrixXd>(517, 301, 389));
+  CALL_SUBTEST_4(deterministic_products<MatrixXf>(389, 517, 301));
+  CALL_SUBTEST_4((deterministic_products<Matrix<double, Dynamic, Dynamic, RowMajor>>(301, 389, 517)));
+  setGemmThreadPool(nullptr);
+}
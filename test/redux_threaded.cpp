@@ -0,0 +1,108 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS 1
+
+#include "main.h"
+#include <Eigen/ThreadPool>
+
+template <typename MatrixType>
+void threaded_redux(CoreThreadPoolDevice& device, Index rows, Index cols) {
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  // Away from zero, so that the sums do not cancel out to rounding errors.
+  MatrixType m = (MatrixType::Random(rows, cols).array() + Scalar(2)).matrix();
+
+  VERIFY_IS_APPROX(m.device(device).sum(), m.sum());
+  VERIFY_IS_APPROX(m.device(device).mean(), m.mean());
+  VERIFY_IS_APPROX(m.cwiseAbs2().device(device).sum(), m.squaredNorm());
+  VERIFY_IS_EQUAL(m.real().device(device).minCoeff(), m.real().minCoeff());
+  VERIFY_IS_EQUAL(m.real().device(device).maxCoeff(), m.real().maxCoeff());
+  VERIFY_IS_EQUAL(m.real().cwiseAbs().device(device).template maxCoeff<PropagateNaN>(), m.real().cwiseAbs().maxCoeff());
+  // The rounding errors of a product of n factors grow with n, at most (n - 1) * epsilon / 2 relative to the exact
+  // product, whatever the order of the factors. Compare both orders to a reference in double precision.
+  typedef std::conditional_t<NumTraits<Scalar>::IsComplex, std::complex<double>, double> RefScalar;
+  MatrixType ones = MatrixType::Ones(rows, cols) + MatrixType::Random(rows, cols) * RealScalar(1e-6);
+  const RefScalar ref = ones.template cast<RefScalar>().prod();
+  const double tolerance = double(rows * cols) * double(NumTraits<RealScalar>::epsilon()) * numext::abs(ref);
+  VERIFY(numext::abs(RefScalar(ones.device(device).prod()) - ref) <= tolerance);
+  VERIFY(numext::abs(RefScalar(ones.prod()) - ref) <= tolerance);
+
+  // Blocks and expressions.
+  const Index r = rows / 3, c = cols / 2;
+  VERIFY_IS_APPROX(m.bottomRightCorner(rows - r, cols - c).device(device).sum(),
+                   m.bottomRightCorner(rows - r, cols - c).sum());
+  VERIFY_IS_APPROX((m + m.reverse()).device(device).sum(), (m + m.reverse()).sum());
+
+  // The result only depends on the number of chunks.
+  const Scalar s = m.device(device).sum();
+  for (int i = 0; i < 4; ++i) VERIFY_IS_EQUAL(m.device(device).sum(), s);
+}
+
+// Products are evaluated once before being reduced.
+void threaded_redux_product(CoreThreadPoolDevice& device) {
+  MatrixXd a = MatrixXd::Random(300, 200);
+  VERIFY_IS_APPROX((a * a.adjoint()).device(device).sum(), (a * a.adjoint()).sum());
+  VectorXd sums(300);
+  sums.device(device) = (a * a.adjoint()).rowwise().sum();
+  VERIFY_IS_APPROX(sums, (a * a.adjoint()).rowwise().sum());
+}
+
+template <typename MatrixType>
+void threaded_partial_redux(CoreThreadPoolDevice& device, Index rows, Index cols) {
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, 1, Dynamic> RowVectorType;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  typedef Matrix<typename NumTraits<Scalar>::Real, 1, Dynamic> RealRowVectorType;
+  MatrixType m = MatrixType::Random(rows, cols);
+
+  RowVectorType colwise(cols);
+  colwise.device(device) = m.colwise().sum();
+  VERIFY_IS_APPROX(colwise, m.colwise().sum());
+  VectorType rowwise(rows);
+  rowwise.device(device) = m.rowwise().sum();
+  VERIFY_IS_APPROX(rowwise, m.rowwise().sum());
+  rowwise.device(device) += m.rowwise().prod();
+  VERIFY_IS_APPROX(rowwise, m.rowwise().sum() + m.rowwise().prod());
+
+  RealRowVectorType norms(cols);
+  norms.device(device) = m.colwise().norm();
+  VERIFY_IS_APPROX(norms, m.colwise().norm());
+  RealRowVectorType maxs(cols);
+  maxs.device(device) = m.real().colwise().maxCoeff();
+  VERIFY_IS_EQUAL(maxs, m.real().colwise().maxCoeff());
+
+  // Transposed destinations and blocks.
+  VectorType colwise_t(cols);
+  colwise_t.device(device) = m.colwise().sum();
+  VERIFY_IS_APPROX(colwise_t, m.colwise().sum().transpose());
+  RowVectorType block_colwise(cols - 1);
+  block_colwise.device(device) = m.bottomRightCorner(rows - 1, cols - 1).colwise().sum();
+  VERIFY_IS_APPROX(block_colwise, m.bottomRightCorner(rows - 1, cols - 1).colwise().sum());
+}
+
+EIGEN_DECLARE_TEST(redux_threaded) {
+  ThreadPool pool(4);
+  CoreThreadPoolDevice device(pool);
+  for (int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(threaded_redux<MatrixXf>(device, 1000, 1000));
+    CALL_SUBTEST_1(threaded_redux<MatrixXd>(device, 2, 100000));
+    CALL_SUBTEST_1(threaded_redux<MatrixXd>(device, 100000, 3));
+    CALL_SUBTEST_2((threaded_redux<Matrix<double, Dynamic, Dynamic, RowMajor>>(device, 700, 900)));
+    CALL_SUBTEST_2(threaded_redux<MatrixXcf>(device, 500, 600));
+    CALL_SUBTEST_2(threaded_redux<VectorXd>(device, 1000000, 1));
+    CALL_SUBTEST_2(threaded_redux_product(device));
+    CALL_SUBTEST_3(threaded_partial_redux<MatrixXf>(device, 1000, 1000));
+    // Few long reductions, which are split along their coefficients.
+    CALL_SUBTEST_3(threaded_partial_redux<MatrixXd>(device, 200000, 3));
+    CALL_SUBTEST_3(threaded_partial_redux<MatrixXd>(device, 3, 200000));
+    CALL_SUBTEST_4((threaded_partial_redux<Matrix<double, Dynamic, Dynamic, RowMajor>>(device, 200000, 3)));
+    CALL_SUBTEST_4(threaded_partial_redux<MatrixXcd>(device, 500, 600));
+  }
+}
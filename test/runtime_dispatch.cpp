@@ -0,0 +1,157 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_RUNTIME_DISPATCH
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+
+using internal::dispatch_index;
+using internal::dispatch_kernels;
+using internal::dispatched_kernels;
+
+// Wraps the registered kernels to count the calls forwarded by the hooks.
+template <typename Scalar>
+struct counting_kernels {
+  static dispatch_kernels<Scalar> registered;
+  static int gemm_calls, gemv_calls, trsm_calls;
+
+  static void gemm(dispatch_index rows, dispatch_index cols, dispatch_index depth, const Scalar* lhs,
+                   dispatch_index lhsStride, bool lhsRowMajor, const Scalar* rhs, dispatch_index rhsStride,
+                   bool rhsRowMajor, Scalar* res, dispatch_index resStride, Scalar alpha,
+                   const internal::dispatch_gemm_tiles* tiles) {
+    ++gemm_calls;
+    registered.gemm(rows, cols, depth, lhs, lhsStride, lhsRowMajor, rhs, rhsStride, rhsRowMajor, res, resStride, alpha,
+                    tiles);
+  }
+  static void gemv(dispatch_index rows, dispatch_index cols, const Scalar* lhs, dispatch_index lhsStride,
+                   bool lhsRowMajor, const Scalar* rhs, dispatch_index rhsIncr, Scalar* res, dispatch_index resIncr,
+                   Scalar alpha) {
+    ++gemv_calls;
+    registered.gemv(rows, cols, lhs, lhsStride, lhsRowMajor, rhs, rhsIncr, res, resIncr, alpha);
+  }
+  static void trsm(int side, int mode, bool triRowMajor, dispatch_index size, dispatch_index otherSize,
+                   const Scalar* tri, dispatch_index triStride, Scalar* other, dispatch_index otherStride) {
+    ++trsm_calls;
+    registered.trsm(side, mode, triRowMajor, size, otherSize, tri, triStride, other, otherStride);
+  }
+
+  static void install() {
+    registered = dispatched_kernels<Scalar>();
+    dispatch_kernels<Scalar> wrappers = {registered.isa, &gemm, &gemv, &trsm};
+    dispatched_kernels<Scalar>() = wrappers;
+    gemm_calls = gemv_calls = trsm_calls = 0;
+  }
+  static void uninstall() { dispatched_kernels<Scalar>() = registered; }
+};
+
+template <typename Scalar>
+dispatch_kernels<Scalar> counting_kernels<Scalar>::registered;
+template <typename Scalar>
+int counting_kernels<Scalar>::gemm_calls;
+template <typename Scalar>
+int counting_kernels<Scalar>::gemv_calls;
+template <typename Scalar>
+int counting_kernels<Scalar>::trsm_calls;
+
+void check_registration() {
+  const int host = internal::detect_dispatch_isa();
+  // The build links an AVX2 variant of the kernels into this test on x86 targets, see CMakeLists.txt.
+#if defined(EIGEN_TEST_DISPATCH_VARIANT_AVX2)
+  const int expected = host >= internal::DispatchAVX2 ? int(internal::DispatchAVX2) : int(internal::DispatchGeneric);
+  VERIFY_IS_EQUAL(dispatched_kernels<float>().isa, expected);
+  VERIFY_IS_EQUAL(dispatched_kernels<double>().isa, expected);
+#else
+  EIGEN_UNUSED_VARIABLE(host);
+#endif
+  VERIFY(dispatched_kernels<std::complex<float> >().gemm == 0);
+}
+
+template <typename Scalar>
+void dispatched_products(Index rows, Index cols, Index depth) {
+  typedef Matrix<Scalar, Dynamic, Dynamic> ColMatrix;
+  typedef Matrix<Scalar, Dynamic, Dynamic, RowMajor> RowMatrix;
+  typedef Matrix<Scalar, Dynamic, 1> Vector;
+  typedef counting_kernels<Scalar> Counter;
+  if (!dispatched_kernels<Scalar>().gemm) return;
+  Counter::install();
+
+  ColMatrix lhs = ColMatrix::Random(rows, depth);
+  RowMatrix rowLhs = lhs;
+  ColMatrix rhs = ColMatrix::Random(depth, cols);
+  RowMatrix rowRhs = rhs;
+  ColMatrix ref = lhs.lazyProduct(rhs);
+
+  // General matrix-matrix products of every storage order.
+  ColMatrix res = lhs * rhs;
+  VERIFY_IS_APPROX(res, ref);
+  res.noalias() = rowLhs * rowRhs;
+  VERIFY_IS_APPROX(res, ref);
+  RowMatrix rowRes = lhs * rowRhs;
+  VERIFY_IS_APPROX(rowRes, ref);
+  res.noalias() += Scalar(2) * (rowLhs * rhs);
+  VERIFY_IS_APPROX(res, Scalar(3) * ref);
+  VERIFY(Counter::gemm_calls > 0);
+
+  // Matrix-vector products.
+  Vector v = Vector::Random(depth);
+  Vector w = lhs * v;
+  VERIFY_IS_APPROX(w, lhs.lazyProduct(v));
+  w.noalias() = rowLhs * v;
+  VERIFY_IS_APPROX(w, lhs.lazyProduct(v));
+  VERIFY(Counter::gemv_calls > 0);
+
+  // Triangular solves.
+  ColMatrix tri = ColMatrix::Random(rows, rows);
+  tri.diagonal().array() += Scalar(rows);
+  ColMatrix b = ColMatrix::Random(rows, cols);
+  ColMatrix x = tri.template triangularView<Lower>().solve(b);
+  VERIFY_IS_APPROX(tri.template triangularView<Lower>() * x, b);
+  // The unit diagonal is well conditioned with small off-diagonal coefficients only.
+  RowMatrix rowTri = tri / Scalar(rows);
+  x = rowTri.template triangularView<UnitUpper>().solve(b);
+  VERIFY_IS_APPROX(rowTri.template triangularView<UnitUpper>() * x, b);
+  ColMatrix bt = ColMatrix::Random(cols, rows);
+  x = bt;
+  tri.template triangularView<Upper>().template solveInPlace<OnTheRight>(x);
+  VERIFY_IS_APPROX(x * tri.template triangularView<Upper>(), bt);
+  VERIFY(Counter::trsm_calls > 0);
+
+  Counter::uninstall();
+}
+
+template <typename Scalar>
+void threaded_dispatched_product(ThreadPool& pool) {
+  typedef Matrix<Scalar, Dynamic, Dynamic> ColMatrix;
+  if (!dispatched_kernels<Scalar>().gemm) return;
+  counting_kernels<Scalar>::install();
+  ColMatrix lhs = ColMatrix::Random(517, 301);
+  ColMatrix rhs = ColMatrix::Random(301, 389);
+  ColMatrix ref = lhs.lazyProduct(rhs);
+  setNbThreads(pool.NumThreads());
+  ColMatrix res = lhs * rhs;
+  setNbThreads(1);
+  VERIFY_IS_APPROX(res, ref);
+  VERIFY(counting_kernels<Scalar>::gemm_calls > 0);
+  counting_kernels<Scalar>::uninstall();
+}
+
+EIGEN_DECLARE_TEST(runtime_dispatch) {
+  ThreadPool pool(4);
+  setGemmThreadPool(&pool);
+  CALL_SUBTEST(check_registration());
+  for (int i = 0; i < g_repeat; i++) {
+    const Index rows = internal::random<Index>(20, EIGEN_TEST_MAX_SIZE);
+    const Index cols = internal::random<Index>(20, EIGEN_TEST_MAX_SIZE);
+    const Index depth = internal::random<Index>(20, EIGEN_TEST_MAX_SIZE);
+    CALL_SUBTEST(dispatched_products<float>(rows, cols, depth));
+    CALL_SUBTEST(dispatched_products<double>(rows, cols, depth));
+  }
+  CALL_SUBTEST(threaded_dispatched_product<float>(pool));
+  CALL_SUBTEST(threaded_dispatched_product<double>(pool));
+}
@@ -164,10 +164,254 @@ static void test_pool_partitions() {
   }
 }
 
+typedef std::function<std::function<void()>(int)> TaskFactory;
+
+// Runs the tasks scheduled while all the threads are busy, and returns the order in which they started.
+template <typename ScheduleTasks>
+static std::vector<int> start_order(int threads, const ScheduleTasks& schedule_tasks) {
+  std::vector<int> order;
+  std::mutex mutex;
+  std::atomic<int> running(0);
+  std::atomic<bool> release(false);
+  {
+    ThreadPool tp(threads);
+    for (int i = 0; i < threads; ++i) {
+      tp.Schedule([&]() {
+        ++running;
+        while (!release) {
+        }
+      });
+    }
+    while (running != threads) {
+    }
+    schedule_tasks(tp, [&](int id) {
+      return [&, id]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(id);
+      };
+    });
+    release = true;
+  }
+  return order;
+}
+
+static void test_priorities() {
+  const int kTasks = 12;
+  for (int threads : {1, 4}) {
+    // The high priority tasks start before the normal priority tasks queued before them. Positive ids denote high
+    // priority tasks.
+    std::vector<int> order = start_order(threads, [&](ThreadPool& tp, const TaskFactory& task) {
+      for (int i = 1; i <= kTasks; ++i) tp.Schedule(task(-i));
+      for (int i = 1; i <= kTasks; ++i) tp.ScheduleWithPriority(task(i), ThreadPool::kHighPriority);
+    });
+    VERIFY_IS_EQUAL(order.size(), std::size_t(2 * kTasks));
+    int last_high = -1, first_normal = 2 * kTasks;
+    for (int k = 0; k < 2 * kTasks; ++k) {
+      if (order[k] > 0) last_high = k;
+      if (order[k] < 0) first_normal = std::min<int>(first_normal, k);
+    }
+    // A task may start a little after another one that was taken later from the queues.
+    VERIFY(last_high < first_normal + threads);
+    // The tasks of each priority from a single thread start in order on a single thread pool.
+    if (threads == 1)
+      for (int k = 0; k < 2 * kTasks; ++k) VERIFY_IS_EQUAL(order[k], k < kTasks ? k + 1 : kTasks - k - 1);
+  }
+
+  // A steady stream of high priority tasks does not starve the normal priority ones.
+  std::vector<int> order = start_order(1, [&](ThreadPool& tp, const TaskFactory& task) {
+    tp.Schedule(task(-1));
+    for (int i = 1; i <= 100; ++i) tp.ScheduleWithPriority(task(i), ThreadPool::kHighPriority);
+  });
+  VERIFY_IS_EQUAL(order.size(), std::size_t(101));
+  VERIFY(std::find(order.begin(), order.end(), -1) < order.begin() + 50);
+}
+
+// Returns the domain of the worker thread_id according to the ranges of the environment.
+static int domain_of(const TopologyThreadEnvironment& env, int thread_id, int threads) {
+  for (int d = 0; d < env.NumDomains(); ++d) {
+    const std::pair<unsigned, unsigned> range = env.DomainThreads(d, threads);
+    if (unsigned(thread_id) >= range.first && unsigned(thread_id) < range.second) return d;
+  }
+  return -1;
+}
+
+// Runs tasks on all the workers, and checks the domain they report.
+static void check_domains(const TopologyThreadEnvironment& env, int threads, bool pinned) {
+  ThreadPoolTempl<TopologyThreadEnvironment> tp(threads, env);
+  std::atomic<int> done(0), mismatches(0);
+  for (int i = 0; i < 10 * threads; ++i) {
+    tp.ScheduleWithHint(
+        [&]() {
+          const int domain = TopologyThreadEnvironment::CurrentDomain();
+          if (domain != domain_of(env, tp.CurrentThreadId(), threads)) ++mismatches;
+#if EIGEN_OS_LINUX
+          // The pinned workers run on the cpus of their domain.
+          if (pinned && domain >= 0 && threads <= env.Topology().NumCpus()) {
+            const std::vector<int>& cpus = env.Topology().domains[domain].cpus;
+            if (std::find(cpus.begin(), cpus.end(), sched_getcpu()) == cpus.end()) ++mismatches;
+          }
+#endif
+          ++done;
+        },
+        i % threads, i % threads + 1);
+  }
+  while (done != 10 * threads) {
+  }
+  VERIFY_IS_EQUAL(mismatches.load(), 0);
+  VERIFY_IS_EQUAL(TopologyThreadEnvironment::CurrentDomain(), -1);
+}
+
+static void test_topology() {
+  const std::vector<int> cpus = internal::parse_cpu_list("0-3,8,10-11\n");
+  VERIFY_IS_EQUAL(cpus.size(), std::size_t(7));
+  VERIFY(cpus[3] == 3 && cpus[4] == 8 && cpus[6] == 11);
+
+  // The detected domains partition the cpus the process may run on.
+  const CpuTopology detected = CpuTopology::Detect();
+  VERIFY_GE(detected.NumCpus(), 1);
+  std::vector<int> all;
+  for (const CpuTopology::Domain& domain : detected.domains) all.insert(all.end(), domain.cpus.begin(), domain.cpus.end());
+  std::sort(all.begin(), all.end());
+  VERIFY(std::unique(all.begin(), all.end()) == all.end());
+  for (int threads : {1, detected.NumCpus(), detected.NumCpus() + 2}) check_domains(TopologyThreadEnvironment(), threads, true);
+
+  // Domains per NUMA node and last level cache, in any order.
+  CpuTopology topology;
+  topology.Add(1, 4, 14);
+  topology.Add(0, 0, 10);
+  topology.Add(0, 2, 12);
+  topology.Add(0, 0, 11);
+  topology.Add(1, 4, 15);
+  topology.Add(0, 2, 13);
+  VERIFY_IS_EQUAL(topology.domains.size(), std::size_t(3));
+  VERIFY(topology.domains[1].node == 0 && topology.domains[1].cache == 2 && topology.domains[2].node == 1);
+  VERIFY(topology.domains[0].cpus == std::vector<int>({10, 11}));
+  const TopologyThreadEnvironment env(topology, false);
+  VERIFY_IS_EQUAL(env.NumDomains(), 3);
+  VERIFY(env.DomainThreads(1, 6) == std::make_pair(2u, 4u));
+  VERIFY(env.DomainThreads(2, 3) == std::make_pair(3u, 3u));
+  VERIFY(env.StealPartition(5, 6) == std::make_pair(4u, 6u));
+  VERIFY(env.StealPartition(2, 3) == std::make_pair(2u, 3u));
+  VERIFY(env.StealPartition(2, 8) == std::make_pair(0u, 8u));
+  for (int threads : {3, 6, 8}) check_domains(env, threads, false);
+}
+
+static void test_statistics() {
+  const int kThreads = 4, kTasks = 1000;
+  ThreadPool tp(kThreads);
+  std::atomic<int> done(0);
+  for (int i = 0; i < kTasks; ++i) tp.Schedule([&]() { ++done; });
+  while (done != kTasks) {
+  }
+  // Let the workers account for their last task.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ThreadPool::Statistics stats = tp.GetStatistics();
+  VERIFY_IS_EQUAL(stats.workers.size(), std::size_t(kThreads));
+  uint64_t tasks = 0;
+  for (const ThreadPool::WorkerStatistics& w : stats.workers) {
+    tasks += w.tasks;
+    uint64_t depths = 0;
+    for (uint64_t count : w.queue_depth) depths += count;
+    VERIFY_IS_EQUAL(depths, (w.tasks + ThreadPool::kQueueDepthSamplingPeriod - 1) / ThreadPool::kQueueDepthSamplingPeriod);
+    VERIFY(w.unparks <= w.parks && w.parks <= w.unparks + 1);
+  }
+  VERIFY_IS_EQUAL(tasks, uint64_t(kTasks));
+
+  tp.ResetStatistics();
+  stats = tp.GetStatistics();
+  for (const ThreadPool::WorkerStatistics& w : stats.workers) VERIFY_IS_EQUAL(w.tasks, uint64_t(0));
+
+  // A worker which helps a task group accounts for the tasks it runs.
+  tp.Schedule([&]() {
+    TaskGroup group(tp);
+    for (int i = 0; i < 100; ++i) group.Run([&]() { ++done; });
+    group.Wait();
+  });
+  while (done != kTasks + 100) {
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  tasks = 0;
+  for (const ThreadPool::WorkerStatistics& w : tp.GetStatistics().workers) tasks += w.tasks;
+  VERIFY_IS_EQUAL(tasks, uint64_t(101));
+
+  // Idle threads stop spinning when the tasks arrive further apart than they
+  // would spin.
+  for (int i = 0; i < 20; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    tp.Schedule([&]() { ++done; });
+  }
+  while (done != kTasks + 120) {
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  stats = tp.GetStatistics();
+  VERIFY_GE(stats.idle_nanoseconds, int64_t(100000));
+  VERIFY_IS_EQUAL(stats.spin_nanoseconds, int64_t(0));
+
+  // Pools which do not spin always report zero.
+  ThreadPool no_spin(2, false);
+  VERIFY_IS_EQUAL(no_spin.GetStatistics().spin_nanoseconds, int64_t(0));
+}
+
+static void test_schedule_batch() {
+  // The ranges cover each index exactly once, whether the batch is submitted
+  // from outside of the pool or from one of its threads.
+  ThreadPool tp(4);
+  for (Index n : {0, 1, 3, 4, 1000, 100000}) {
+    std::vector<std::atomic<int>> calls(static_cast<std::size_t>(n));
+    for (std::atomic<int>& c : calls) c = 0;
+    std::atomic<Index> done(0);
+    const auto fn = [&](Index first, Index last) {
+      VERIFY(0 <= first && first < last && last <= n);
+      for (Index i = first; i < last; ++i) ++calls[static_cast<std::size_t>(i)];
+      done += last - first;
+    };
+    tp.ScheduleBatch(n, fn);
+    while (done != n) {
+    }
+    std::atomic<bool> submitted(false);
+    tp.Schedule([&]() {
+      tp.ScheduleBatch(n, fn);
+      submitted = true;
+    });
+    while (!submitted || done != 2 * n) {
+    }
+    for (std::atomic<int>& c : calls) VERIFY_IS_EQUAL(c.load(), 2);
+  }
+
+  // A batch enqueues at most one task per thread. Let the tasks of the
+  // previous batches, which may find their range exhausted, exit first.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  tp.ResetStatistics();
+  std::atomic<Index> done(0);
+  tp.ScheduleBatch(1000, [&](Index first, Index last) { done += last - first; });
+  while (done != 1000) {
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  uint64_t tasks = 0;
+  for (const ThreadPool::WorkerStatistics& w : tp.GetStatistics().workers) tasks += w.tasks;
+  VERIFY(tasks <= uint64_t(tp.NumThreads()));
+
+  // The range and the function of a batch are freed when its tasks are
+  // discarded without running, by a cancelled pool.
+  std::shared_ptr<int> token = std::make_shared<int>(0);
+  std::weak_ptr<int> observer = token;
+  {
+    ThreadPool cancelled(2);
+    cancelled.Cancel();
+    cancelled.ScheduleBatch(100, [token](Index, Index) { ++*token; });
+    token.reset();
+  }
+  VERIFY(observer.expired());
+}
+
 EIGEN_DECLARE_TEST(cxx11_non_blocking_thread_pool) {
   CALL_SUBTEST(test_create_destroy_empty_pool());
   CALL_SUBTEST(test_parallelism(true));
   CALL_SUBTEST(test_parallelism(false));
   CALL_SUBTEST(test_cancel());
   CALL_SUBTEST(test_pool_partitions());
+  CALL_SUBTEST(test_priorities());
+  CALL_SUBTEST(test_topology());
+  CALL_SUBTEST(test_statistics());
+  CALL_SUBTEST(test_schedule_batch());
 }
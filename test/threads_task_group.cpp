@@ -0,0 +1,191 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS
+#include "main.h"
+#include "Eigen/ThreadPool"
+
+#include <stdexcept>
+
+// Keeps the threads of the pool busy until release is set.
+static void occupy(ThreadPool& tp, std::atomic<bool>& release) {
+  std::atomic<int> running(0);
+  for (int i = 0; i < tp.NumThreads(); ++i) {
+    tp.Schedule([&]() {
+      ++running;
+      while (!release) {
+      }
+    });
+  }
+  while (running != tp.NumThreads()) {
+  }
+}
+
+static void test_run_and_wait() {
+  ThreadPool tp(4);
+  TaskGroup group(tp);
+  for (int iter = 0; iter < 10; ++iter) {
+    std::atomic<int> sum(0);
+    for (int i = 1; i <= 100; ++i) group.Run([&sum, i]() { sum += i; });
+    group.Wait();
+    VERIFY_IS_EQUAL(sum.load(), 5050);
+  }
+}
+
+static void test_waiting_thread_helps() {
+  // All the threads of the pool are busy, so the closures run on the waiting
+  // thread.
+  ThreadPool tp(2);
+  std::atomic<bool> release(false);
+  occupy(tp, release);
+  std::atomic<int> done(0);
+  TaskGroup group(tp);
+  for (int i = 0; i < 10; ++i) {
+    group.Run([&]() {
+      VERIFY_IS_EQUAL(tp.CurrentThreadId(), -1);
+      ++done;
+    });
+  }
+  group.Wait();
+  VERIFY_IS_EQUAL(done.load(), 10);
+  release = true;
+}
+
+static int fibonacci(ThreadPool& tp, int n) {
+  if (n < 2) return n;
+  int a = 0, b = 0;
+  TaskGroup group(tp);
+  group.Run([&]() { a = fibonacci(tp, n - 1); });
+  group.Run([&]() { b = fibonacci(tp, n - 2); });
+  group.Wait();
+  return a + b;
+}
+
+static void test_nested_groups() {
+  // The closures wait for nested groups without deadlocking the pool, even
+  // when they outnumber its threads.
+  for (int threads : {1, 2, 4}) {
+    ThreadPool tp(threads);
+    int result = 0;
+    TaskGroup group(tp);
+    group.Run([&]() { result = fibonacci(tp, 15); });
+    group.Wait();
+    VERIFY_IS_EQUAL(result, 610);
+  }
+
+  // CoreThreadPoolDevice can be used from the closures of the pool.
+  ThreadPool tp(2);
+  CoreThreadPoolDevice device(tp, 1.0f);
+  std::vector<VectorXf> results(8);
+  TaskGroup group(tp);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    group.Run([&, i]() {
+      VectorXf v = VectorXf::Constant(4096, float(i));
+      results[i].resize(v.size());
+      results[i].device(device) = v.array().square().matrix();
+    });
+  }
+  group.Wait();
+  for (std::size_t i = 0; i < results.size(); ++i)
+    VERIFY_IS_EQUAL(results[i], VectorXf::Constant(4096, float(i * i)));
+}
+
+static void test_run_batch() {
+  ThreadPool tp(4);
+  TaskGroup group(tp);
+  const Index n = 10000;
+  std::vector<int> calls(static_cast<std::size_t>(n), 0);
+  group.RunBatch(n, [&](Index first, Index last) {
+    for (Index i = first; i < last; ++i) ++calls[static_cast<std::size_t>(i)];
+  });
+  group.Wait();
+  for (int c : calls) VERIFY_IS_EQUAL(c, 1);
+
+  // The waiting thread claims ranges of the batch too.
+  ThreadPool busy(2);
+  std::atomic<bool> release(false);
+  occupy(busy, release);
+  TaskGroup busy_group(busy);
+  std::atomic<Index> done(0);
+  busy_group.RunBatch(100, [&](Index first, Index last) {
+    VERIFY_IS_EQUAL(busy.CurrentThreadId(), -1);
+    done += last - first;
+  });
+  busy_group.Wait();
+  VERIFY_IS_EQUAL(done.load(), Index(100));
+
+  // Cancel() skips the ranges which did not start.
+  done = 0;
+  busy_group.RunBatch(100, [&](Index first, Index last) { done += last - first; });
+  busy_group.Cancel();
+  release = true;
+  busy_group.Wait();
+  VERIFY_IS_EQUAL(done.load(), Index(0));
+}
+
+static void test_cancel() {
+  ThreadPool tp(1);
+  std::atomic<bool> release(false);
+  occupy(tp, release);
+  std::atomic<int> done(0);
+  TaskGroup group(tp);
+  for (int i = 0; i < 100; ++i) group.Run([&]() { ++done; });
+  group.Cancel();
+  VERIFY(group.IsCancelled());
+  // Closures scheduled after Cancel() are skipped as well.
+  group.Run([&]() { ++done; });
+  release = true;
+  group.Wait();
+  VERIFY_IS_EQUAL(done.load(), 0);
+
+  // The group can be reused once Wait() returns.
+  VERIFY(!group.IsCancelled());
+  group.Run([&]() { ++done; });
+  group.Wait();
+  VERIFY_IS_EQUAL(done.load(), 1);
+}
+
+static void test_exceptions() {
+#ifdef EIGEN_EXCEPTIONS
+  ThreadPool tp(1);
+  std::atomic<bool> release(false);
+  occupy(tp, release);
+  // The waiting thread runs the closure, so the one it schedules does not
+  // start before the exception cancels the group.
+  std::atomic<int> done(0);
+  TaskGroup group(tp);
+  group.Run([&]() {
+    group.Run([&]() { ++done; });
+    throw std::runtime_error("failed");
+  });
+  bool caught = false;
+  try {
+    group.Wait();
+  } catch (const std::runtime_error& e) {
+    caught = std::string(e.what()) == "failed";
+  }
+  VERIFY(caught);
+  VERIFY_IS_EQUAL(done.load(), 0);
+
+  // The exception is rethrown once.
+  release = true;
+  group.Run([&]() { ++done; });
+  group.Wait();
+  VERIFY_IS_EQUAL(done.load(), 1);
+#endif
+}
+
+EIGEN_DECLARE_TEST(threads_task_group) {
+  CALL_SUBTEST(test_run_and_wait());
+  CALL_SUBTEST(test_waiting_thread_helps());
+  CALL_SUBTEST(test_nested_groups());
+  CALL_SUBTEST(test_run_batch());
+  CALL_SUBTEST(test_cancel());
+  CALL_SUBTEST(test_exceptions());
+}
@@ -194,6 +194,98 @@ void vectorVisitor(const VectorType& w) {
   }
 }
 
+// Ties, several NaNs and sizes that mix packets and scalars, against references in the storage order.
+template <typename MatrixType>
+void argMinMaxVisitor(Index rows, Index cols) {
+  typedef typename MatrixType::Scalar Scalar;
+  // few distinct values, so that the extrema are repeated
+  MatrixType m = MatrixType::NullaryExpr(rows, cols, [] { return Scalar(internal::random<int>(-20, 20)); });
+  const Index size = m.size();
+  const Index innerSize = m.innerSize();
+  auto location = [&](Index k, Index& r, Index& c) {
+    r = MatrixType::IsRowMajor ? k / innerSize : k % innerSize;
+    c = MatrixType::IsRowMajor ? k % innerSize : k / innerSize;
+  };
+  auto coeffAt = [&](Index k) {
+    Index r, c;
+    location(k, r, c);
+    return m(r, c);
+  };
+
+  auto check = [&](Index expected, Index r, Index c) {
+    Index er, ec;
+    location(expected, er, ec);
+    VERIFY_IS_EQUAL(r, er);
+    VERIFY_IS_EQUAL(c, ec);
+  };
+  Index kmin = 0, kmax = 0;
+  for (Index k = 1; k < size; ++k) {
+    if (coeffAt(k) < coeffAt(kmin)) kmin = k;
+    if (coeffAt(kmax) < coeffAt(k)) kmax = k;
+  }
+  Index r, c;
+  VERIFY_IS_EQUAL(m.minCoeff(&r, &c), coeffAt(kmin));
+  check(kmin, r, c);
+  VERIFY_IS_EQUAL(m.maxCoeff(&r, &c), coeffAt(kmax));
+  check(kmax, r, c);
+
+  if (!NumTraits<Scalar>::IsInteger) {
+    // The first NaN is returned by PropagateNaN, and the others are ignored by PropagateNumbers.
+    const Index nans = internal::random<Index>(1, 5);
+    Index first_nan = size;
+    for (Index n = 0; n < nans; ++n) {
+      Index k = internal::random<Index>(0, size - 1);
+      location(k, r, c);
+      m(r, c) = NumTraits<Scalar>::quiet_NaN();
+      first_nan = numext::mini(first_nan, k);
+    }
+    VERIFY((numext::isnan)(m.template minCoeff<PropagateNaN>(&r, &c)));
+    check(first_nan, r, c);
+    VERIFY((numext::isnan)(m.template maxCoeff<PropagateNaN>(&r, &c)));
+    check(first_nan, r, c);
+    kmin = kmax = -1;
+    for (Index k = 0; k < size; ++k) {
+      if ((numext::isnan)(coeffAt(k))) continue;
+      if (kmin < 0 || coeffAt(k) < coeffAt(kmin)) kmin = k;
+      if (kmax < 0 || coeffAt(kmax) < coeffAt(k)) kmax = k;
+    }
+    if (kmin >= 0) {
+      VERIFY_IS_EQUAL(m.template minCoeff<PropagateNumbers>(&r, &c), coeffAt(kmin));
+      check(kmin, r, c);
+      VERIFY_IS_EQUAL(m.template maxCoeff<PropagateNumbers>(&r, &c), coeffAt(kmax));
+      check(kmax, r, c);
+    }
+  }
+
+  // k largest coefficients, sorted by decreasing values and storage order.
+  std::vector<std::pair<Scalar, Index>> entries;
+  for (Index k = 0; k < size; ++k)
+    if (!(numext::isnan)(coeffAt(k))) entries.emplace_back(coeffAt(k), k);
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const std::pair<Scalar, Index>& a, const std::pair<Scalar, Index>& b) { return b.first < a.first; });
+  for (Index k : {Index(0), Index(1), internal::random<Index>(1, 100), size + 1}) {
+    Matrix<Scalar, Dynamic, 1> values;
+    VectorXi topRows, topCols;
+    m.maxCoeffs(k, values, topRows, topCols);
+    const Index count = numext::mini(k, static_cast<Index>(entries.size()));
+    VERIFY_IS_EQUAL(values.size(), count);
+    VERIFY_IS_EQUAL(topRows.size(), count);
+    for (Index i = 0; i < count; ++i) {
+      VERIFY_IS_EQUAL(values(i), entries[i].first);
+      check(entries[i].second, topRows(i), topCols(i));
+    }
+  }
+  if (cols == 1) {
+    Matrix<Scalar, Dynamic, 1> values;
+    Matrix<Index, Dynamic, 1> indices;
+    m.col(0).maxCoeffs(10, values, indices);
+    for (Index i = 0; i < values.size(); ++i) {
+      VERIFY_IS_EQUAL(values(i), entries[i].first);
+      VERIFY_IS_EQUAL(indices(i), entries[i].second);
+    }
+  }
+}
+
 template <typename Derived, bool Vectorizable>
 struct TrackedVisitor {
   using Scalar = typename DenseBase<Derived>::Scalar;
@@ -307,4 +399,14 @@ EIGEN_DECLARE_TEST(visitor) {
     CALL_SUBTEST_10(vectorVisitor(VectorXf(33)));
   }
   CALL_SUBTEST_11(checkOptimalTraversal());
+  for (int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_12(argMinMaxVisitor<MatrixXf>(internal::random<Index>(1, 300), internal::random<Index>(1, 30)));
+    CALL_SUBTEST_12((argMinMaxVisitor<Matrix<double, Dynamic, Dynamic, RowMajor>>(internal::random<Index>(1, 30),
+                                                                                   internal::random<Index>(1, 300))));
+    CALL_SUBTEST_12(argMinMaxVisitor<MatrixXi>(internal::random<Index>(1, 300), internal::random<Index>(1, 30)));
+    CALL_SUBTEST_12(argMinMaxVisitor<VectorXf>(internal::random<Index>(1, 10000), 1));
+    CALL_SUBTEST_12((argMinMaxVisitor<Matrix<float, 37, 5>>(37, 5)));
+  }
+  // More packets than their ordinals can count in half precision.
+  CALL_SUBTEST_13((argMinMaxVisitor<Matrix<half, Dynamic, 1>>(100000, 1)));
 }
@@ -0,0 +1,176 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 The Eigen Authors.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// route the stack temporaries to the heap, hence to the workspaces
+#define EIGEN_STACK_ALLOCATION_LIMIT 0
+// heap allocation will raise an assert if enabled at runtime
+#define EIGEN_RUNTIME_NO_MALLOC
+#define EIGEN_GEMM_THREADPOOL
+
+#include "main.h"
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+#include <Eigen/QR>
+#include <Eigen/SVD>
+
+static bool in_buffer(const void* ptr, const std::vector<char>& buffer) {
+  return ptr >= static_cast<const void*>(buffer.data()) && ptr < static_cast<const void*>(buffer.data() + buffer.size());
+}
+
+void workspace_blocks() {
+  std::vector<char> buffer(4096 + 7);
+  Workspace workspace(buffer.data() + 7, 4096);
+  void* before = internal::aligned_malloc(100);
+  {
+    ScopedWorkspace scope(workspace);
+    void* a = internal::aligned_malloc(100);
+    void* b = internal::aligned_malloc(1000);
+    VERIFY(in_buffer(a, buffer) && in_buffer(b, buffer));
+    VERIFY(std::size_t(a) % EIGEN_DEFAULT_ALIGN_BYTES == 0 && std::size_t(b) % EIGEN_DEFAULT_ALIGN_BYTES == 0);
+    const std::size_t used = workspace.used();
+
+    // Blocks released out of order are reclaimed with the blocks above them.
+    internal::aligned_free(a);
+    VERIFY_IS_EQUAL(workspace.used(), used);
+    internal::aligned_free(b);
+    VERIFY_IS_EQUAL(workspace.used(), std::size_t(0));
+    VERIFY_IS_EQUAL(workspace.peakUsed(), used);
+
+    // Allocations made before the scope are released to the heap.
+    internal::aligned_free(before);
+
+    // Reallocation keeps the content.
+    int* c = static_cast<int*>(internal::aligned_malloc(10 * sizeof(int)));
+    for (int k = 0; k < 10; ++k) c[k] = k;
+    c = static_cast<int*>(internal::aligned_realloc(c, 200 * sizeof(int), 10 * sizeof(int)));
+    VERIFY(in_buffer(c, buffer));
+    for (int k = 0; k < 10; ++k) VERIFY_IS_EQUAL(c[k], k);
+
+    // Overflows are heap allocations, which are forbidden like the other ones.
+    internal::set_is_malloc_allowed(false);
+    VERIFY_RAISES_ASSERT(internal::aligned_malloc(10000));
+    internal::set_is_malloc_allowed(true);
+
+    // Overflow to the heap.
+    void* d = internal::aligned_malloc(10000);
+    VERIFY(!in_buffer(d, buffer));
+    VERIFY_IS_EQUAL(workspace.overflowCount(), Index(1));
+    void* e = internal::aligned_malloc(100);
+    VERIFY(in_buffer(e, buffer));
+    VERIFY(workspace.requiredSize() > 10000 + 200 * sizeof(int) + 100);
+    {
+      // Nested scopes release the blocks of the outer ones.
+      Workspace inner(1024);
+      ScopedWorkspace inner_scope(inner);
+      void* f = internal::aligned_malloc(16);
+      VERIFY(!in_buffer(f, buffer) && inner.used() > 0);
+      internal::aligned_free(e);
+      internal::aligned_free(f);
+      VERIFY_IS_EQUAL(inner.used(), std::size_t(0));
+    }
+    internal::aligned_free(d);
+    internal::aligned_free(c);
+    VERIFY_IS_EQUAL(workspace.used(), std::size_t(0));
+  }
+  void* g = internal::aligned_malloc(100);
+  VERIFY(!in_buffer(g, buffer));
+  internal::aligned_free(g);
+}
+
+// A workspace of the measured size serves all the temporaries, without calling malloc.
+template <typename Decomposition>
+void workspace_decomposition(const typename Decomposition::MatrixType& a) {
+  typedef typename Decomposition::MatrixType MatrixType;
+  const MatrixType b = MatrixType::Random(a.rows(), 3);
+  Decomposition decomposition(a);
+  Workspace workspace(Workspace::sizeFor<Decomposition>(a));
+  MatrixType x(a.cols(), 3);
+  const MatrixType ref = decomposition.solve(b);
+  {
+    ScopedWorkspace scope(workspace);
+    internal::set_is_malloc_allowed(false);
+    decomposition.compute(a);
+    internal::set_is_malloc_allowed(true);
+    VERIFY_IS_EQUAL(workspace.overflowCount(), Index(0));
+    // The temporaries of the solver which do not fit fall back to the heap.
+    x = decomposition.solve(b);
+  }
+  VERIFY(workspace.used() == 0 && workspace.peakUsed() <= workspace.capacity());
+  VERIFY_IS_APPROX(x, ref);
+}
+
+void workspace_product(Index size) {
+  const MatrixXf a = MatrixXf::Random(size, size), b = MatrixXf::Random(size, size);
+  MatrixXf c(size, size);
+  const std::size_t bytes = Workspace::measure([&]() { c.noalias() = a * b; });
+  VERIFY(bytes > 0);
+  Workspace workspace(bytes);
+  {
+    ScopedWorkspace scope(workspace);
+    internal::set_is_malloc_allowed(false);
+    c.noalias() = a * b;
+    c.noalias() += a.transpose() * b;
+    internal::set_is_malloc_allowed(true);
+  }
+  VERIFY_IS_EQUAL(workspace.overflowCount(), Index(0));
+  VERIFY_IS_APPROX(c, a * b + a.transpose() * b);
+}
+
+// The buffers shared by the threads of a product, which may be freed by a pool thread, do not come from the workspace
+// of the calling thread.
+void workspace_threaded_product(Index size) {
+  static ThreadPool pool(4);
+  setGemmThreadPool(&pool);
+  const MatrixXf a = MatrixXf::Random(size, size), b = MatrixXf::Random(size, size);
+  MatrixXf ref(size, size), c(size, size);
+  setNbThreads(1);
+  ref.noalias() = a * b;
+  setNbThreads(pool.NumThreads());
+  Workspace workspace(std::size_t(64) << 20);
+  for (int i = 0; i < 4; ++i) {
+    ScopedWorkspace scope(workspace);
+    c.noalias() = a * b;
+    VERIFY_IS_APPROX(c, ref);
+  }
+  VERIFY(workspace.peakUsed() > 0);
+  VERIFY_IS_EQUAL(workspace.used(), std::size_t(0));
+  setNbThreads(1);
+
+  // Whichever thread finishes the last tile of a column frees its rhs panel, here a pool thread.
+  internal::GemmParallelTileInfo<Index> tiles(64, 64, 64, 64, 64, 64, 4, 4, 1);
+  VERIFY_IS_EQUAL(tiles.num_row_tiles, Index(1));
+  {
+    ScopedWorkspace scope(workspace);
+    VERIFY(tiles.rhsPanel(0, 64 * 64 * sizeof(float)) != nullptr);
+    Barrier released(1);
+    pool.Schedule([&]() {
+      tiles.releaseRhsPanel(0);
+      released.Notify();
+    });
+    released.Wait();
+  }
+  for (Index t = 0; t < tiles.num_tiles; ++t) tiles.finish();
+}
+
+EIGEN_DECLARE_TEST(workspace) {
+  CALL_SUBTEST_1(workspace_blocks());
+  for (int i = 0; i < g_repeat; i++) {
+    const Index size = internal::random<Index>(1, 300);
+    CALL_SUBTEST_2(workspace_decomposition<PartialPivLU<MatrixXd>>(MatrixXd::Random(size, size)));
+    CALL_SUBTEST_2(workspace_decomposition<FullPivLU<MatrixXf>>(MatrixXf::Random(size, size)));
+    CALL_SUBTEST_3(workspace_decomposition<HouseholderQR<MatrixXd>>(MatrixXd::Random(2 * size, size)));
+    CALL_SUBTEST_3(workspace_decomposition<ColPivHouseholderQR<MatrixXcf>>(MatrixXcf::Random(size, size)));
+    CALL_SUBTEST_4((workspace_decomposition<BDCSVD<MatrixXd, ComputeThinU | ComputeThinV>>(
+        MatrixXd::Random(size + 20, size))));
+    const MatrixXd spd = MatrixXd::Random(size, size);
+    CALL_SUBTEST_4(workspace_decomposition<LLT<MatrixXd>>(spd * spd.transpose() + MatrixXd::Identity(size, size)));
+    CALL_SUBTEST_5(workspace_product(internal::random<Index>(100, 600)));
+  }
+  CALL_SUBTEST_6(workspace_threaded_product(internal::random<Index>(300, 600)));
+}
@@ -187,31 +187,26 @@ struct ThreadPoolDevice {
     // Compute block size and total count of blocks.
     ParallelForBlock block = CalculateParallelForBlock(n, cost, block_align);
 
-    // Recursively divide size into halves until we reach block_size.
-    // Division code rounds mid to block_size, so we are guaranteed to get
-    // block_count leaves that do actual computations.
+    // The threads of the pool claim the blocks of a single batch, and call f
+    // once per block.
     Barrier barrier(static_cast<unsigned int>(block.count));
-    std::function<void(Index, Index)> handleRange;
-    handleRange = [=, &handleRange, &barrier, &f](Index firstIdx, Index lastIdx) {
-      while (lastIdx - firstIdx > block.size) {
-        // Split into halves and schedule the second half on a different thread.
-        const Index midIdx = firstIdx + numext::div_ceil((lastIdx - firstIdx) / 2, block.size) * block.size;
-        pool_->Schedule([=, &handleRange]() { handleRange(midIdx, lastIdx); });
-        lastIdx = midIdx;
+    const auto handleBlocks = [=, &barrier, &f](Index firstBlock, Index lastBlock) {
+      for (Index blockIdx = firstBlock; blockIdx < lastBlock; ++blockIdx) {
+        f(blockIdx * block.size, numext::mini(n, (blockIdx + 1) * block.size));
+        barrier.Notify();
       }
-      // Single block or less, execute directly.
-      f(firstIdx, lastIdx);
-      barrier.Notify();
     };
 
     if (block.count <= numThreads()) {
-      // Avoid a thread hop by running the root of the tree and one block on the
-      // main thread.
-      handleRange(0, n);
+      // Avoid a thread hop by running one block on the main thread.
+      pool_->ScheduleBatch(block.count - 1, [&handleBlocks](Index firstBlock, Index lastBlock) {
+        handleBlocks(firstBlock + 1, lastBlock + 1);
+      });
+      handleBlocks(0, 1);
     } else {
-      // Execute the root in the thread pool to avoid running work on more than
+      // Leave the main thread waiting to avoid running work on more than
       // numThreads() threads.
-      pool_->Schedule([=, &handleRange]() { handleRange(0, n); });
+      pool_->ScheduleBatch(block.count, handleBlocks);
     }
 
     barrier.Wait();
@@ -243,32 +238,26 @@ struct ThreadPoolDevice {
 
     ParallelForAsyncContext* const ctx = new ParallelForAsyncContext(block.count, std::move(f), std::move(done));
 
-    // Recursively divide size into halves until we reach block_size.
-    // Division code rounds mid to block_size, so we are guaranteed to get
-    // block_count leaves that do actual computations.
-    ctx->handle_range = [this, ctx, block](Index firstIdx, Index lastIdx) {
-      while (lastIdx - firstIdx > block.size) {
-        // Split into halves and schedule the second half on a different thread.
-        const Index midIdx = firstIdx + numext::div_ceil((lastIdx - firstIdx) / 2, block.size) * block.size;
-        pool_->Schedule([ctx, midIdx, lastIdx]() { ctx->handle_range(midIdx, lastIdx); });
-        lastIdx = midIdx;
-      }
-
-      // Single block or less, execute directly.
-      ctx->f(firstIdx, lastIdx);
+    // The threads of the pool claim the blocks of a single batch, and call f
+    // once per block.
+    const auto handleBlocks = [ctx, block, n](Index firstBlock, Index lastBlock) {
+      for (Index blockIdx = firstBlock; blockIdx < lastBlock; ++blockIdx)
+        ctx->f(blockIdx * block.size, numext::mini(n, (blockIdx + 1) * block.size));
 
       // Delete async context if it was the last block.
-      if (ctx->count.fetch_sub(1) == 1) delete ctx;
+      if (ctx->count.fetch_sub(lastBlock - firstBlock) == lastBlock - firstBlock) delete ctx;
     };
 
     if (block.count <= numThreads()) {
-      // Avoid a thread hop by running the root of the tree and one block on the
-      // main thread.
-      ctx->handle_range(0, n);
+      // Avoid a thread hop by running one block on the main thread.
+      pool_->ScheduleBatch(block.count - 1, [handleBlocks](Index firstBlock, Index lastBlock) {
+        handleBlocks(firstBlock + 1, lastBlock + 1);
+      });
+      handleBlocks(0, 1);
     } else {
-      // Execute the root in the thread pool to avoid running work on more than
-      // numThreads() threads.
-      pool_->Schedule([ctx, n]() { ctx->handle_range(0, n); });
+      // Leave the main thread to avoid running work on more than numThreads()
+      // threads.
+      pool_->ScheduleBatch(block.count, handleBlocks);
     }
   }
 
@@ -298,8 +287,6 @@ struct ThreadPoolDevice {
     std::atomic<Index> count;
     std::function<void(Index, Index)> f;
     std::function<void()> done;
-
-    std::function<void(Index, Index)> handle_range;
   };
 
   struct ParallelForBlock {